@@ -0,0 +1,363 @@
+/**
+ * @file arena_benchmark.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/broadphase.h"
+#include "src/entity_type.h"
+#include "src/robot.h"
+#include "src/sense_decimation.h"
+#include "src/trajectory_recorder.h"
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+// Move 9 robots in 10 into the arena's top left 256-unit corner.
+static void CrowdCorner(csci3081::Arena *arena) {
+  std::mt19937 rng(4);
+  std::uniform_real_distribution<double> corner(30, 256);
+  std::vector<csci3081::Robot *> robots = arena->robot();
+  for (size_t i = 0; i < robots.size(); ++i) {
+    if (i % 10 != 0) {
+      csci3081::Pose pose = robots[i]->get_pose();
+      robots[i]->set_pose(csci3081::Pose(corner(rng), corner(rng),
+                                         pose.theta));
+    }
+  }
+}
+
+// The standard scenario scaled up: robots, a few lights and food, 2/5 of the
+// robots fearing light. Seeded so that every run does the same work.
+static csci3081::Arena *MakeArena(const csci3081::arena_params &aparams,
+                                  int robots) {
+  csci3081::Arena *arena = new csci3081::Arena(&aparams);
+  arena->Seed(1);
+  arena->AddRobot(csci3081::kRobot, robots);
+  arena->AddLight(csci3081::kLight, 4);
+  arena->AddFood(csci3081::kFood, 4);
+  arena->set_behavior_sensitivity_robot(robots * 2 / 5, 1.0, 1);
+  return arena;
+}
+
+/*******************************************************************************
+ * Benchmarks
+ ******************************************************************************/
+// One timestep of the arena, for reference.
+static void BM_ArenaStep(benchmark::State &state) {  // NOLINT
+  csci3081::arena_params aparams;
+  csci3081::Arena *arena = MakeArena(aparams, state.range(0));
+  for (auto _ : state) {
+    arena->AdvanceTime(1);
+  }
+  state.SetItemsProcessed(state.iterations());
+  delete arena;
+}
+BENCHMARK(BM_ArenaStep)->Arg(10)->Arg(100);
+
+// One timestep with each broadphase (Arg 0, a BroadphaseKind) for Arg 1
+// robots; all of them give the same run.
+static void BM_ArenaStepBroadphase(benchmark::State &state) {  // NOLINT
+  csci3081::arena_params aparams;
+  aparams.broadphase = static_cast<int>(state.range(0));
+  csci3081::Arena *arena = MakeArena(aparams, state.range(1));
+  for (auto _ : state) {
+    arena->AdvanceTime(1);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(csci3081::BroadphaseName(aparams.broadphase));
+  const csci3081::Broadphase *broadphase = arena->get_broadphase();
+  if (broadphase != nullptr) {
+    state.counters["builds_per_step"] =
+        static_cast<double>(broadphase->get_builds()) /
+        broadphase->get_refreshes();
+  }
+  delete arena;
+}
+BENCHMARK(BM_ArenaStepBroadphase)
+    ->Args({csci3081::kBroadphaseAllPairs, 100})
+    ->Args({csci3081::kBroadphaseNeighborList, 100})
+    ->Args({csci3081::kBroadphaseSweepAndPrune, 100})
+    ->Args({csci3081::kBroadphaseAllPairs, 400})
+    ->Args({csci3081::kBroadphaseNeighborList, 400})
+    ->Args({csci3081::kBroadphaseSweepAndPrune, 400})
+    ->Args({csci3081::kBroadphaseQuadtree, 100})
+    ->Args({csci3081::kBroadphaseQuadtree, 400});
+
+// The same with Arg 1 food spread among 100 robots. Food is paired with
+// the robots through a hierarchy built once, so its cost should grow far
+// slower than all pairs'.
+static void BM_ArenaStepFood(benchmark::State &state) {  // NOLINT
+  csci3081::arena_params aparams;
+  aparams.broadphase = static_cast<int>(state.range(0));
+  csci3081::Arena *arena = MakeArena(aparams, 100);
+  arena->AddFood(csci3081::kFood, static_cast<int>(state.range(1)));
+  for (auto _ : state) {
+    arena->AdvanceTime(1);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(csci3081::BroadphaseName(aparams.broadphase));
+  delete arena;
+}
+BENCHMARK(BM_ArenaStepFood)
+    ->Args({csci3081::kBroadphaseAllPairs, 200})
+    ->Args({csci3081::kBroadphaseNeighborList, 200})
+    ->Args({csci3081::kBroadphaseSweepAndPrune, 200})
+    ->Args({csci3081::kBroadphaseQuadtree, 200});
+
+// The same with 9 robots in 10 crowded into a 256-unit corner, where a
+// uniform grid puts most of them in a few cells. Arg 2 is the sensor range
+// (0, none).
+static void BM_ArenaStepClustered(benchmark::State &state) {  // NOLINT
+  csci3081::arena_params aparams;
+  aparams.broadphase = static_cast<int>(state.range(0));
+  aparams.sensor_range = static_cast<double>(state.range(2));
+  csci3081::Arena *arena = MakeArena(aparams, state.range(1));
+  CrowdCorner(arena);
+  for (auto _ : state) {
+    arena->AdvanceTime(1);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(csci3081::BroadphaseName(aparams.broadphase));
+  delete arena;
+}
+BENCHMARK(BM_ArenaStepClustered)
+    ->Args({csci3081::kBroadphaseAllPairs, 400, 0})
+    ->Args({csci3081::kBroadphaseNeighborList, 400, 0})
+    ->Args({csci3081::kBroadphaseSweepAndPrune, 400, 0})
+    ->Args({csci3081::kBroadphaseQuadtree, 400, 0})
+    ->Args({csci3081::kBroadphaseQuadtree, 400, 150})
+    ->Args({csci3081::kBroadphaseQuadtree, 400, 5000});
+
+// A crowded corner, as above, separated pair by pair (Arg 0) or by Arg
+// passes of the overlap solver. "overlap" is how deep the robots still
+// overlap each other at the end, summed over the pairs.
+static void BM_ArenaStepRelaxed(benchmark::State &state) {  // NOLINT
+  csci3081::arena_params aparams;
+  aparams.relax_passes = static_cast<int>(state.range(0));
+  csci3081::Arena *arena = MakeArena(aparams, 400);
+  CrowdCorner(arena);
+  for (auto _ : state) {
+    arena->AdvanceTime(1);
+  }
+  state.SetItemsProcessed(state.iterations());
+  double overlap = 0;
+  std::vector<csci3081::Robot *> robots = arena->robot();
+  for (size_t a = 0; a < robots.size(); ++a) {
+    for (size_t b = a + 1; b < robots.size(); ++b) {
+      double dx = robots[a]->get_pose().x - robots[b]->get_pose().x;
+      double dy = robots[a]->get_pose().y - robots[b]->get_pose().y;
+      overlap += std::max(0.0, robots[a]->get_radius() +
+                                   robots[b]->get_radius() -
+                                   std::sqrt(dx * dx + dy * dy));
+    }
+  }
+  state.counters["overlap"] = overlap;
+  delete arena;
+}
+BENCHMARK(BM_ArenaStepRelaxed)->Arg(0)->Arg(2)->Arg(8)->Arg(32);
+
+// Whether entities `a` and `b`, which moved from (ax0, ay0) and (bx0, by0),
+// passed through each other: they started and end apart, yet their centers
+// came within half of touching during the step.
+static bool PassedThrough(double ax0, double ay0, double bx0, double by0,
+                          const csci3081::ArenaEntity *a,
+                          const csci3081::ArenaEntity *b) {
+  double within = a->get_radius() + b->get_radius();
+  double px = ax0 - bx0, py = ay0 - by0;
+  double dx = a->get_pose().x - b->get_pose().x - px;
+  double dy = a->get_pose().y - b->get_pose().y - py;
+  double ex = px + dx, ey = py + dy;
+  double length = dx * dx + dy * dy;
+  if (px * px + py * py < within * within ||
+      ex * ex + ey * ey < within * within || !(length > 0)) {
+    return false;
+  }
+  double t = std::min(1.0, std::max(0.0, -(px * dx + py * dy) / length));
+  double cx = px + t * dx, cy = py + t * dy;
+  return std::sqrt(cx * cx + cy * cy) < within / 2;
+}
+
+// Steps of Arg 0 / 4 time units, with (Arg 1 = 1) or without continuous
+// collision detection, among 100 robots shrunk to radius 8. "tunnels" is
+// the number of pairs of entities per step that passed through each other;
+// the largest dt with none is the largest that is stable.
+static void BM_ArenaStepDt(benchmark::State &state) {  // NOLINT
+  csci3081::arena_params aparams;
+  aparams.dt = static_cast<double>(state.range(0)) / 4;
+  aparams.ccd = static_cast<int>(state.range(1));
+  csci3081::Arena *arena = MakeArena(aparams, 100);
+  for (auto robot : arena->robot()) {
+    robot->set_radius(8);
+  }
+  std::vector<csci3081::ArenaEntity *> entities = arena->get_entities();
+  std::vector<double> x0(entities.size()), y0(entities.size());
+  double tunnels = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (size_t i = 0; i < entities.size(); ++i) {
+      x0[i] = entities[i]->get_pose().x;
+      y0[i] = entities[i]->get_pose().y;
+    }
+    state.ResumeTiming();
+    arena->AdvanceTime(1);
+    state.PauseTiming();
+    for (size_t a = 0; a < entities.size(); ++a) {
+      for (size_t b = a + 1; b < entities.size(); ++b) {
+        tunnels += PassedThrough(x0[a], y0[a], x0[b], y0[b], entities[a],
+                                 entities[b]);
+      }
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["tunnels"] =
+      benchmark::Counter(tunnels, benchmark::Counter::kAvgIterations);
+  delete arena;
+}
+BENCHMARK(BM_ArenaStepDt)
+    ->ArgsProduct({{2, 3, 4, 8, 16, 32, 64}, {0, 1}})
+    ->Iterations(2000);
+
+// 1000 steps in a sparse 4000 by 3000 arena with Arg 0 robots that sense
+// within 100 and never get hungry, with (Arg 1 = 1) or without kinetic mode.
+// "coasted" is the fraction of the steps that were run as part of a quiet
+// run; the end state is the same either way.
+static void BM_ArenaStepKinetic(benchmark::State &state) {  // NOLINT
+  csci3081::arena_params aparams;
+  aparams.x_dim = 4000;
+  aparams.y_dim = 3000;
+  aparams.sensor_range = 100;
+  aparams.kinetic = static_cast<int>(state.range(1));
+  csci3081::Arena *arena = MakeArena(aparams, state.range(0));
+  arena->set_behavior_sensitivity_robot(state.range(0) * 2 / 5, 1.0, 0);
+  uint64_t steps = 0;
+  for (auto _ : state) {
+    uint32_t end = arena->get_step() + 1000;
+    while (arena->get_step() < end) {
+      arena->AdvanceSteps(end - arena->get_step());
+    }
+    steps += 1000;
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(steps));
+  state.counters["coasted"] =
+      static_cast<double>(arena->get_coasted_steps()) / steps;
+  delete arena;
+}
+BENCHMARK(BM_ArenaStepKinetic)->ArgsProduct({{5, 20, 80}, {0, 1}});
+
+// Simulated time per second in a 4000 by 3000 arena with Arg 0 robots,
+// with fixed steps of 1 (Arg 1 = 0) or adaptive steps of up to 4 (Arg 1 =
+// 1). Items are units of simulated time, so the two compare directly;
+// "mean_dt" is the average step, which falls as the arena fills up.
+static void BM_ArenaStepAdaptive(benchmark::State &state) {  // NOLINT
+  csci3081::arena_params aparams;
+  aparams.x_dim = 4000;
+  aparams.y_dim = 3000;
+  aparams.neighbor_skin = 160;
+  aparams.adaptive_dt = static_cast<int>(state.range(1));
+  aparams.dt = aparams.adaptive_dt ? 4 : 1;
+  csci3081::Arena *arena = MakeArena(aparams, state.range(0));
+  double time = 0;
+  for (auto _ : state) {
+    arena->AdvanceTime(1);
+    time += arena->get_step_dt();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(time));
+  state.counters["mean_dt"] = time / state.iterations();
+  delete arena;
+}
+BENCHMARK(BM_ArenaStepAdaptive)->ArgsProduct({{5, 20, 80}, {0, 1}});
+
+// The timestep with robots sensing in full only every `interval` steps and
+// carrying their readings on in between. Next to the throughput, "drift" is
+// the median distance between where a robot ends up and where sensing every
+// step takes it, 5 steps on from the same state, and "carried" the share of
+// sensings carried on.
+static void BM_ArenaSenseInterval(benchmark::State &state) {  // NOLINT
+  csci3081::arena_params aparams;
+  aparams.sense_interval = static_cast<uint32_t>(state.range(1));
+  csci3081::Arena *arena = MakeArena(aparams, state.range(0));
+  for (auto _ : state) {
+    arena->AdvanceTime(1);
+  }
+  state.SetItemsProcessed(state.iterations());
+  const csci3081::SenseDecimation &decimation = arena->get_sense_decimation();
+  uint64_t sensings = decimation.get_recorded() + decimation.get_extrapolated();
+  state.counters["carried"] =
+      sensings ? static_cast<double>(decimation.get_extrapolated()) / sensings
+               : 0;
+
+  aparams.sense_interval = 1;
+  csci3081::Arena *every = MakeArena(aparams, state.range(0));
+  std::vector<double> drift;
+  for (int r = 0; r < 20; ++r) {
+    arena->CopyFrom(*every);
+    for (int s = 0; s < 5; ++s) {
+      every->AdvanceTime(1);
+      arena->AdvanceTime(1);
+    }
+    for (size_t i = 0; i < every->robot().size(); ++i) {
+      drift.push_back(std::hypot(
+          every->robot()[i]->get_pose().x - arena->robot()[i]->get_pose().x,
+          every->robot()[i]->get_pose().y - arena->robot()[i]->get_pose().y));
+    }
+  }
+  std::sort(drift.begin(), drift.end());
+  state.counters["drift"] = drift[drift.size() / 2];
+  delete every;
+  delete arena;
+}
+BENCHMARK(BM_ArenaSenseInterval)->ArgsProduct({{20, 80}, {1, 2, 4, 8}});
+
+// The same timestep with every entity's trajectory being recorded. The
+// difference from BM_ArenaStep is the recorder's cost to the simulation
+// thread; the disk writes happen on the recorder's own thread.
+static void BM_ArenaStepRecorder(benchmark::State &state) {  // NOLINT
+  const char *path = "arena_benchmark.traj";
+  csci3081::arena_params aparams;
+  csci3081::Arena *arena = MakeArena(aparams, state.range(0));
+  csci3081::TrajectoryRecorder recorder;
+  recorder.Open(path);
+  arena->set_trajectory_recorder(&recorder);
+  for (auto _ : state) {
+    arena->AdvanceTime(1);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["extra_buffers"] = recorder.get_extra_buffers();
+  recorder.Close();
+  delete arena;
+  std::remove(path);
+}
+BENCHMARK(BM_ArenaStepRecorder)->Arg(10)->Arg(100);
+
+// Forking a branch off a warm arena into an existing branch, as a sweep
+// would for each variant; compare with the cost of re-running the warm-up.
+static void BM_ArenaCopyFrom(benchmark::State &state) {  // NOLINT
+  csci3081::arena_params aparams;
+  csci3081::Arena *arena = MakeArena(aparams, state.range(0));
+  for (int i = 0; i < 100; ++i) {
+    arena->AdvanceTime(1);
+  }
+  csci3081::Arena *branch = arena->Clone();
+  for (auto _ : state) {
+    branch->CopyFrom(*arena);
+  }
+  state.SetItemsProcessed(state.iterations());
+  delete branch;
+  delete arena;
+}
+BENCHMARK(BM_ArenaCopyFrom)->Arg(10)->Arg(100);
+
@@ -12,13 +12,27 @@
 #include "src/food.h"
 #include "src/arena.h"
 #include "src/arena_params.h"
+#include "src/binary_io.h"
 #include "src/light.h"
 #include "src/sensor.h"
+#include "src/trajectory_recorder.h"
 /*******************************************************************************
  * Namespaces
  ******************************************************************************/
 NAMESPACE_BEGIN(csci3081);
 
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+// The most steps run singly, after finding none quiet, before looking again.
+static const uint32_t kKineticMaxBackoff = 64;
+// The most the log of a robot's sensor reading may change in an adaptive
+// step.
+static const double kMaxSensorChange = 1;
+// The most entities the collision pass lets leave the broadphase's skin
+// before it finds the candidates anew.
+static const size_t kMaxEscaped = 64;
+
 /*******************************************************************************
  * Constructors/Destructor
  ******************************************************************************/
@@ -27,21 +41,142 @@ Arena::Arena(const struct arena_params *const params)
       y_dim_(params->y_dim),
       factory_(new EntityFactory),
       robot_(),
+      robot_states_(),
+      sense_partition_(),
       entities_(),
       mobile_entities_(),
+      sensor_range_(params->sensor_range),
+      sense_tree_(),
+      sensed_ids_(),
+      sensed_marks_(),
+      sensed_(),
+      sense_interval_(std::max(params->sense_interval, 1u)),
+      sense_decimation_(),
+      broadphase_(CreateBroadphase(params->broadphase,
+                                   params->neighbor_skin)),
+      relax_passes_(params->relax_passes),
+      overlap_solver_(),
+      escaped_(),
+      dt_(params->dt),
+      adaptive_dt_(params->adaptive_dt),
+      dt_min_(params->dt_min),
+      step_dt_(params->dt),
+      ccd_(params->ccd),
+      swept_collision_(),
+      wall_collision_(),
+      kinetic_(params->kinetic),
+      kinetic_schedule_(),
+      kinetic_bodies_(),
+      active_robots_(),
+      kinetic_backoff_(0),
+      kinetic_wait_(0),
+      coasted_steps_(0),
       game_status_(PLAYING),
       robot_count_(5),
       light_count_(0),
-      food_count_(0) {
+      food_count_(0),
+      step_(0),
+      recorder_(nullptr),
+      session_log_(nullptr),
+      robot_timers_(),
+      robot_timers_stale_(true),
+      fired_timers_() {
+  factory_->set_arena_size(static_cast<uint>(x_dim_),
+                           static_cast<uint>(y_dim_));
+  if (broadphase_ && relax_passes_ > 0) {
+    broadphase_->set_margin(RELAX_CONTACT_MARGIN);
+  }
   // AddRobot(kRobot, robot_count_);
   // AddFood(kFood, food_count_);
   // AddLight(kLight, light_count_);
 }
 
 Arena::~Arena() {
-  for (auto ent : entities_) {
-    delete ent;
-  } /* for(ent..) */
+  ReleaseEntities();
+  delete factory_;
+}
+
+/*******************************************************************************
+ * Snapshot Format
+ ******************************************************************************/
+// Bump kSnapshotVersion whenever the header or EntityState encoding changes.
+static const char kSnapshotMagic[4] = {'R', 'S', 'N', 'P'};
+static const uint32_t kSnapshotVersion = 4;
+// Encoded size of one EntityState, written to the header as a sanity check.
+static const uint32_t kSnapshotRecordSize = 3 * 4 + 4 * 8 + 3 + 2 * 8 +
+                                            4 + 2 * 8 + 2 * 4 + 4 + 4 * 8;
+
+// Records are encoded straight into a pre-sized buffer; going through the
+// per-value BinaryWriter calls costs several times more on large arenas.
+template <typename T>
+static void Put(T v, uint8_t **out) {
+  StoreLE(v, *out);
+  *out += sizeof(T);
+}
+
+template <typename T>
+static void Get(const uint8_t **in, T *v) {
+  *v = LoadLE<T>(*in);
+  *in += sizeof(T);
+}
+
+static void EncodeState(const EntityState &st, uint8_t *out) {
+  Put(st.type, &out);
+  Put(st.id, &out);
+  Put(st.flags, &out);
+  Put(st.x, &out);
+  Put(st.y, &out);
+  Put(st.theta, &out);
+  Put(st.radius, &out);
+  Put(st.color_r, &out);
+  Put(st.color_g, &out);
+  Put(st.color_b, &out);
+  Put(st.vel_left, &out);
+  Put(st.vel_right, &out);
+  Put(st.lives, &out);
+  Put(st.time_counter, &out);
+  Put(st.collision_timer, &out);
+  Put(st.behavior_flag, &out);
+  Put(st.food_on_off, &out);
+  Put(st.light_base, &out);
+  Put(st.left_light_reading, &out);
+  Put(st.right_light_reading, &out);
+  Put(st.left_food_reading, &out);
+  Put(st.right_food_reading, &out);
+}
+
+static void DecodeState(const uint8_t *in, EntityState *st) {
+  Get(&in, &st->type);
+  Get(&in, &st->id);
+  Get(&in, &st->flags);
+  Get(&in, &st->x);
+  Get(&in, &st->y);
+  Get(&in, &st->theta);
+  Get(&in, &st->radius);
+  Get(&in, &st->color_r);
+  Get(&in, &st->color_g);
+  Get(&in, &st->color_b);
+  Get(&in, &st->vel_left);
+  Get(&in, &st->vel_right);
+  Get(&in, &st->lives);
+  Get(&in, &st->time_counter);
+  Get(&in, &st->collision_timer);
+  Get(&in, &st->behavior_flag);
+  Get(&in, &st->food_on_off);
+  Get(&in, &st->light_base);
+  Get(&in, &st->left_light_reading);
+  Get(&in, &st->right_light_reading);
+  Get(&in, &st->left_food_reading);
+  Get(&in, &st->right_food_reading);
+}
+
+// Whether a decoded record is of an entity the factory can create, with no
+// flags but the known ones.
+static bool IsValidState(const EntityState &st) {
+  const uint32_t known_flags = kStateMobile | kStateArcing | kStateHungry |
+                               kStateReallyHungry | kStateCaptured;
+  return (st.type == kRobot || st.type == kLight || st.type == kFood) &&
+         (st.flags & ~known_flags) == 0;
 }
 
 /*******************************************************************************
@@ -50,9 +185,8 @@ Arena::~Arena() {
 
 // Function for adding robots to the arena.
 void Arena::AddRobot(EntityType type, int quantity) {
-  robot_.clear();
-  entities_.clear();
-  mobile_entities_.clear();
+  LogInput(kInputAddRobot, quantity);
+  ReleaseEntities();
   factory_ -> Reset();
   for (int i = 0; i < quantity; i++) {
     Robot * robot_temp_ = dynamic_cast<Robot *>(factory_->CreateEntity(type));
@@ -60,10 +194,13 @@ void Arena::AddRobot(EntityType type, int quantity) {
     entities_.push_back(robot_temp_);
     mobile_entities_.push_back(robot_temp_);
   }
+  BindRobotStates();
+  InvalidateRobotTimers();
 }
 
 // Function for adding lights to the arena
 void Arena::AddLight(EntityType type, int quantity) {
+  LogInput(kInputAddLight, quantity);
   for (int i = 0; i < quantity; i++) {
     Light *obs_ = dynamic_cast<Light*>(factory_->CreateEntity(type));
     entities_.push_back(obs_);
@@ -72,6 +209,7 @@ void Arena::AddLight(EntityType type, int quantity) {
 }
 // Function for adding foods to the arena
 void Arena::AddFood(EntityType type, int quantity) {
+  LogInput(kInputAddFood, quantity);
   for (int i = 0; i < quantity; i++) {
     entities_.push_back(factory_->CreateEntity(type));
   }
@@ -83,8 +221,211 @@ void Arena::Reset() {
   for (auto ent : entities_) {
     ent->Reset();
   } /* for(ent..) */
+  InvalidateRobotTimers();
+  sense_decimation_.Reset(robot_.size());
+  if (broadphase_) {
+    broadphase_->Invalidate();
+  }
 } /* reset() */
 
+void Arena::ReleaseEntities() {
+  for (auto ent : entities_) {
+    delete ent;
+  } /* for(ent..) */
+  robot_.clear();
+  robot_states_.clear();
+  sense_partition_.Reset(robot_states_);
+  entities_.clear();
+  mobile_entities_.clear();
+  InvalidateRobotTimers();
+}
+
+void Arena::CaptureEntities(std::vector<EntityState> *states) const {
+  states->assign(entities_.size(), EntityState());
+  for (size_t i = 0; i < entities_.size(); ++i) {
+    entities_[i]->SaveState(&(*states)[i]);
+  }
+}
+
+void Arena::RestoreEntities(const std::vector<EntityState> &states) {
+  bool same_layout = states.size() == entities_.size();
+  for (size_t i = 0; same_layout && i < states.size(); ++i) {
+    same_layout = entities_[i]->get_type() == states[i].type;
+  }
+  if (!same_layout) {
+    ReleaseEntities();
+    for (auto &st : states) {
+      ArenaEntity *ent =
+          factory_->CreateEntity(static_cast<EntityType>(st.type));
+      entities_.push_back(ent);
+      if (st.type == kRobot) {
+        robot_.push_back(dynamic_cast<Robot *>(ent));
+      }
+      if (ent->is_mobile()) {
+        mobile_entities_.push_back(dynamic_cast<ArenaMobileEntity *>(ent));
+      }
+    }
+    BindRobotStates();
+  }
+  for (size_t i = 0; i < states.size(); ++i) {
+    entities_[i]->LoadState(states[i]);
+  }
+  sense_decimation_.Reset(robot_.size());
+  InvalidateRobotTimers();
+  if (broadphase_) {
+    broadphase_->Invalidate();
+  }
+}
+
+void Arena::EncodeSnapshot(BinaryWriter *writer) const {
+  std::vector<EntityState> states;
+  CaptureEntities(&states);
+
+  BinaryWriter &out = *writer;
+  out.Reserve(128 + states.size() * kSnapshotRecordSize);
+  out.PutBytes(kSnapshotMagic, sizeof(kSnapshotMagic));
+  out.PutU32(kSnapshotVersion);
+  out.PutU32(kSnapshotRecordSize);
+  out.PutU32(step_);
+  out.PutF64(x_dim_);
+  out.PutF64(y_dim_);
+  out.PutI32(game_status_);
+  out.PutI32(robot_count_);
+  out.PutI32(light_count_);
+  out.PutI32(food_count_);
+  out.PutI32(factory_->get_entity_count());
+  out.PutI32(factory_->get_robot_count());
+  out.PutI32(factory_->get_light_count());
+  out.PutI32(factory_->get_food_count());
+  out.PutI32(factory_->get_robot_light_behavior_flag());
+  out.PutU64(factory_->get_random_generator()->get_state());
+  out.PutU64(states.size());
+  uint8_t *records = out.Append(states.size() * kSnapshotRecordSize);
+  for (auto &st : states) {
+    EncodeState(st, records);
+    records += kSnapshotRecordSize;
+  }
+}
+
+bool Arena::SaveSnapshot(const std::string &path) const {
+  BinaryWriter out;
+  EncodeSnapshot(&out);
+  return out.WriteFile(path);
+}
+
+uint64_t Arena::StateChecksum() const {
+  BinaryWriter out;
+  EncodeSnapshot(&out);
+  return Fnv1a(out.bytes().data(), out.bytes().size());
+}
+
+void Arena::Seed(uint64_t seed) {
+  factory_->get_random_generator()->Seed(seed);
+}
+
+bool Arena::LoadSnapshot(const std::string &path) {
+  std::vector<uint8_t> bytes;
+  if (!ReadFileBytes(path, &bytes)) {
+    return false;
+  }
+  BinaryReader in(bytes.data(), bytes.size());
+  if (!in.Expect(kSnapshotMagic, sizeof(kSnapshotMagic)) ||
+      in.GetU32() != kSnapshotVersion ||
+      in.GetU32() != kSnapshotRecordSize) {
+    return false;
+  }
+  uint32_t step = in.GetU32();
+  double x_dim = in.GetF64();
+  double y_dim = in.GetF64();
+  int counts[4];
+  for (auto &c : counts) c = in.GetI32();
+  int factory_counts[5];
+  for (auto &c : factory_counts) c = in.GetI32();
+  uint64_t rng_state = in.GetU64();
+  uint64_t n = in.GetU64();
+  if (!in.ok() || n > in.remaining() / kSnapshotRecordSize) {
+    return false;
+  }
+  std::vector<EntityState> states(n);
+  const uint8_t *records = in.Take(n * kSnapshotRecordSize);
+  for (auto &st : states) {
+    DecodeState(records, &st);
+    records += kSnapshotRecordSize;
+    if (!IsValidState(st)) {
+      return false;
+    }
+  }
+
+  step_ = step;
+  x_dim_ = x_dim;
+  y_dim_ = y_dim;
+  factory_->set_arena_size(static_cast<uint>(x_dim_),
+                           static_cast<uint>(y_dim_));
+  game_status_ = counts[0];
+  robot_count_ = counts[1];
+  light_count_ = counts[2];
+  food_count_ = counts[3];
+  RestoreEntities(states);
+  factory_->RestoreCounters(factory_counts[0], factory_counts[1],
+                            factory_counts[2], factory_counts[3],
+                            factory_counts[4]);
+  factory_->get_random_generator()->set_state(rng_state);
+  return true;
+}
+
+Arena *Arena::Clone() const {
+  arena_params params;
+  params.x_dim = static_cast<uint>(x_dim_);
+  params.y_dim = static_cast<uint>(y_dim_);
+  params.sensor_range = sensor_range_;
+  params.sense_interval = sense_interval_;
+  params.relax_passes = relax_passes_;
+  params.dt = dt_;
+  params.adaptive_dt = adaptive_dt_;
+  params.dt_min = dt_min_;
+  params.ccd = ccd_;
+  params.kinetic = kinetic_;
+  if (broadphase_) {
+    params.broadphase = broadphase_->get_kind();
+    params.neighbor_skin = broadphase_->get_skin();
+  } else {
+    params.broadphase = kBroadphaseAllPairs;
+  }
+  Arena *copy = new Arena(&params);
+  copy->CopyFrom(*this);
+  return copy;
+}
+
+void Arena::CopyFrom(const Arena &other) {
+  if (&other == this) {
+    return;
+  }
+  // Entities hold pointers to themselves (sensors, motion handlers), so they
+  // are copied through their flat EntityState rather than byte for byte.
+  std::vector<EntityState> states;
+  other.CaptureEntities(&states);
+
+  step_ = other.step_;
+  x_dim_ = other.x_dim_;
+  y_dim_ = other.y_dim_;
+  factory_->set_arena_size(static_cast<uint>(x_dim_),
+                           static_cast<uint>(y_dim_));
+  game_status_ = other.game_status_;
+  robot_count_ = other.robot_count_;
+  light_count_ = other.light_count_;
+  food_count_ = other.food_count_;
+  RestoreEntities(states);
+  const EntityFactory &factory = *other.factory_;
+  factory_->RestoreCounters(factory.get_entity_count(),
+                            factory.get_robot_count(),
+                            factory.get_light_count(),
+                            factory.get_food_count(),
+                            factory.get_robot_light_behavior_flag());
+  factory_->get_random_generator()->set_state(
+      other.factory_->get_random_generator()->get_state());
+  sense_decimation_ = other.sense_decimation_;
+}
+
 // The primary driver of simulation movement. Called from the Controller
 // but originated from the graphics viewer.
 void Arena::AdvanceTime(double dt) {
@@ -96,102 +437,320 @@ void Arena::AdvanceTime(double dt) {
   } /* for(i..) */
 } /* AdvanceTime() */
 
+uint32_t Arena::AdvanceSteps(uint32_t limit) {
+  if (limit == 0) {
+    return 0;
+  }
+  // After finding no quiet steps, the next few steps are run singly without
+  // looking, for longer the more often that happens in a row.
+  uint32_t quiet = 0;
+  if (kinetic_wait_ > 0) {
+    --kinetic_wait_;
+  } else if (kinetic_) {
+    quiet = QuietSteps(limit);
+    kinetic_backoff_ = quiet > 0 ? 0 : std::min(2 * kinetic_backoff_ + 1,
+                                                 kKineticMaxBackoff);
+    kinetic_wait_ = kinetic_backoff_;
+  }
+  if (quiet == 0) {
+    UpdateEntitiesTimestep();
+    return 1;
+  }
+  Coast(quiet);
+  return quiet;
+}
+
+uint32_t Arena::QuietSteps(uint32_t limit) {
+  if (!kinetic_ || adaptive_dt_ || sense_interval_ > 1 ||
+      robot_timers_stale_) {
+    return 0;
+  }
+  // Arcing and hungry robots change every step, and robots that respond to
+  // light without a sensor range sense it at every step: they go on sensing
+  // through a quiet run. The others only sense something that changes them
+  // when it comes within their reach.
+  bool lights = std::any_of(mobile_entities_.begin(), mobile_entities_.end(),
+                            [](const ArenaMobileEntity *ent) {
+                              return ent->get_type() == kLight;
+                            });
+  active_robots_.clear();
+  for (uint32_t i = 0; i < robot_.size(); ++i) {
+    uint8_t state = robot_states_[i];
+    if ((state & (kRobotArcing | kRobotHungry)) ||
+        (lights && !(sensor_range_ > 0) &&
+         RobotRespondsToLight(state) != kLightIgnore)) {
+      active_robots_.push_back(i);
+    }
+  }
+  // Contacts the overlap solver would be given count as meetings too.
+  double margin = relax_passes_ > 0 ? RELAX_CONTACT_MARGIN : 0;
+  kinetic_bodies_.resize(entities_.size());
+  size_t m = 0, r = 0, a = 0;
+  for (size_t i = 0; i < entities_.size(); ++i) {
+    ArenaEntity *ent = entities_[i];
+    KineticBody &body = kinetic_bodies_[i];
+    body = KineticBody();
+    body.x = ent->get_pose().x;
+    body.y = ent->get_pose().y;
+    body.radius = ent->get_radius();
+    for (double &reach : body.reach) {
+      reach = body.radius + margin;
+    }
+    bool sensing = false;
+    if (ent->get_type() == kRobot) {
+      body.kind = kKineticRobot;
+      sensing = a < active_robots_.size() && active_robots_[a] == r;
+      a += sensing ? 1 : 0;
+      ++r;
+      // Robots eat food within 5 of it.
+      if (!sensing) {
+        body.reach[kKineticFood] = body.radius + std::max(5.0, margin);
+      }
+      if (!sensing &&
+          RobotRespondsToLight(static_cast<Robot *>(ent)->get_state()) !=
+              kLightIgnore) {
+        body.reach[kKineticLight] =
+            std::max(body.reach[kKineticLight], sensor_range_);
+      }
+    } else if (ent->get_type() == kLight) {
+      body.kind = kKineticLight;
+    }
+    if (m == mobile_entities_.size() || mobile_entities_[m] != ent) {
+      continue;
+    }
+    ++m;
+    WheelVelocity v =
+        static_cast<ArenaMobileEntity *>(ent)->get_wheel_velocity();
+    body.straight = !sensing && !(std::fabs(v.left - v.right) > 0);
+    if (sensing) {
+      // Sensing may set its wheels to anything up to the robots' top speed.
+      body.step_reach = std::max(std::max(std::fabs(v.left),
+                                          std::fabs(v.right)),
+                                 static_cast<double>(ROBOT_MAX_SPEED)) * dt_;
+    } else if (body.straight) {
+      // As MotionBehaviorDifferential::UpdatePose() moves it.
+      double theta = deg2rad(ent->get_pose().theta);
+      body.step_x = std::cos(theta) * v.left * dt_;
+      body.step_y = std::sin(theta) * v.left * dt_;
+      body.step_reach = std::hypot(body.step_x, body.step_y);
+    } else {
+      // A chord of a circle of the ICC radius, turned by omega * dt.
+      double icc = std::fabs(0.25 * (v.left + v.right) / (v.left - v.right));
+      body.step_reach =
+          std::min(2 * icc, 0.5 * std::fabs(v.left + v.right) * dt_);
+    }
+    if (!body.straight) {
+      body.step_reach *= 1 + 1e-9;
+    }
+  }
+  uint64_t next = std::min(
+      kinetic_schedule_.Update(kinetic_bodies_, step_, x_dim_, y_dim_),
+      robot_timers_.NextDue());
+  if (next <= static_cast<uint64_t>(step_) + 1) {
+    return 0;
+  }
+  return static_cast<uint32_t>(
+      std::min<uint64_t>(next - step_ - 1, limit));
+}
+
+void Arena::Coast(uint32_t steps) {
+  for (uint32_t s = 0; s < steps; ++s) {
+    for (auto ent : mobile_entities_) {
+      ent->TimestepUpdate(dt_);
+    }
+    // No timer is due; this only moves the wheel's clock on.
+    fired_timers_.clear();
+    robot_timers_.Advance(&fired_timers_);
+    if (!active_robots_.empty()) {
+      IndexForSensing();
+    }
+    for (uint32_t i : active_robots_) {
+      SenseRobot(i);
+    }
+    ++step_;
+    if (recorder_ != nullptr) {
+      recorder_->Record(step_, entities_);
+    }
+  }
+  coasted_steps_ += steps;
+}
+
 void Arena::UpdateEntitiesTimestep() {
   /*
    * First, update the position of all entities, according to their current
    * velocities.
    * @TODO: Should this be just the mobile entities ??
    */
+  step_dt_ = ChooseDt();
+  if (ccd_) {
+    swept_collision_.Begin(mobile_entities_);
+  }
   for (auto ent : mobile_entities_) {
-    ent->TimestepUpdate(1);
+    ent->TimestepUpdate(step_dt_);
   }
-  // Checking if any of the robots in the arena are starving or not because
-  // if they are, then the simulation should be over.
-  for (auto& robot : robot_) {
-    if (robot->RobotStarving()) {
+  // With ccd on, entities that met something along the way are moved back
+  // to their first contact, where the collision pass finds it.
+  if (ccd_) {
+    swept_collision_.Rewind(entities_, mobile_entities_, x_dim_, y_dim_,
+                            broadphase_.get());
+  }
+  // Robots only need their hunger checked, and can only start starving,
+  // at the steps their timers are due. If any robot is starving, then the
+  // simulation should be over.
+  if (robot_timers_stale_) {
+    robot_timers_.Clear(step_);
+    for (uint32_t i = 0; i < robot_.size(); ++i) {
+      robot_timers_.Schedule(step_ + 1, i);
+    }
+    robot_timers_stale_ = false;
+  }
+  fired_timers_.clear();
+  robot_timers_.Advance(&fired_timers_);
+  for (uint32_t i : fired_timers_) {
+    robot_[i]->UpdateHungerState();
+    if (robot_[i]->RobotStarving()) {
       set_game_status(LOST);
     }
+    ScheduleRobotTimer(i);
   }
-   /* Determine if any mobile entity is colliding with wall.
+  /* Determine if any mobile entity is colliding with walls.
    * Adjust the position accordingly so it doesn't overlap.
    */
-  for (auto &ent1 : mobile_entities_) {
-     EntityType wall = GetCollisionWall(ent1);
-     if (kUndefined != wall) {
-       AdjustWallOverlap(ent1, wall);
-       if (ent1->get_type() == kRobot) {
-         dynamic_cast <Robot*> (ent1)-> HandleCollision(wall);
-       } else if (ent1->get_type() == kLight) {
-         dynamic_cast <Light*> (ent1)-> HandleCollision(wall);
-       }
-     }
+  ResolveWallCollisions(true);
+  /* With a broadphase, a mobile entity is tested only against its candidates
+   * (in entity order, as without them), and against the entities that an
+   * adjustment has carried beyond the broadphase's skin earlier in the pass,
+   * which other candidates may miss. Once an adjustment carries the entity
+   * itself that far, the rest of its tests are against every entity. When
+   * too many entities have escaped, the candidates are found anew.
+   */
+  bool use_lists =
+      broadphase_ && broadphase_->Refresh(entities_, mobile_entities_);
+  escaped_.clear();
+  overlap_solver_.Clear();
+  uint32_t self = 0;
+  for (size_t m = 0; m < mobile_entities_.size(); ++m) {
+    ArenaMobileEntity *ent1 = mobile_entities_[m];
+    while (entities_[self] != ent1) { ++self; }
     /* Determine if that mobile entity is colliding with any other entity.
     * Adjust the position accordingly so they don't overlap.
     */
-    for (auto &ent2 : entities_) {
-      if (ent2 == ent1) { continue; }
-      if (IsColliding(ent1, ent2)) {
-        AdjustEntityOverlap(ent1, ent2);
-        if (ent1->get_type() == kRobot) {
-          dynamic_cast <Robot*> (ent1)-> HandleCollision
-          (ent2->get_type(), ent2);
+    size_t next = 0;
+    if (use_lists && broadphase_->Covers(m, ent1->get_pose())) {
+      next = entities_.size();
+      const uint32_t *it = broadphase_->begin(m);
+      auto esc = escaped_.begin();
+      while (it != broadphase_->end(m) || esc != escaped_.end()) {
+        uint32_t j = 0;
+        if (esc == escaped_.end() ||
+            (it != broadphase_->end(m) && *it <= *esc)) {
+          j = *it++;
+          if (esc != escaped_.end() && *esc == j) { ++esc; }
         } else {
-          dynamic_cast <Light*> (ent1)-> HandleCollision
-          (ent2->get_type(), ent2);
+          j = *esc++;
+        }
+        if (IsColliding(ent1, entities_[j])) {
+          ResolveCollision(m, j);
+          if (!broadphase_->Covers(m, ent1->get_pose())) {
+            next = j + 1;
+            break;
+          }
+        } else if (relax_passes_ > 0 && IsNear(ent1, entities_[j])) {
+          overlap_solver_.AddContact(static_cast<uint32_t>(m), j);
         }
       }
     }
+    for (; next < entities_.size(); ++next) {
+      ArenaEntity *ent2 = entities_[next];
+      if (ent2 == ent1) { continue; }
+      if (IsColliding(ent1, ent2)) {
+        ResolveCollision(m, next);
+      } else if (relax_passes_ > 0 && IsNear(ent1, ent2)) {
+        overlap_solver_.AddContact(static_cast<uint32_t>(m),
+                                   static_cast<uint32_t>(next));
+      }
+    }
+    if (use_lists && !broadphase_->Covers(m, ent1->get_pose())) {
+      escaped_.insert(
+          std::upper_bound(escaped_.begin(), escaped_.end(), self), self);
+      if (escaped_.size() > kMaxEscaped) {
+        broadphase_->Refresh(entities_, mobile_entities_);
+        escaped_.clear();
+      }
+    }
+  }
+  // The solver separates the contacts the pass found all at once, and may
+  // push entities into the walls.
+  if (relax_passes_ > 0) {
+    overlap_solver_.Solve(entities_, mobile_entities_, relax_passes_);
+    ResolveWallCollisions(false);
   }
   /* Checking if any of the light or food sensors of the robot
   * have been triggered or not by sending the entity to robot class
   * and letting robot decide for itself by calculating its sensor reading
   * based on the position of the entity. All this is happening in the Robot
   * class since robot is the observer.
+  * Robots sense class by class, so that each sensing kernel runs over all of
+  * its robots back to back. A robot's sensing changes only itself, so the
+  * order the robots sense in does not change the outcome.
   */
-  for (auto& robot : robot_) {
-    for (auto& ent : entities_) {
-      robot->RobotDecideMotion(ent->get_type(), ent);
-    }
+  sense_partition_.Update(robot_states_);
+  IndexForSensing();
+  for (uint32_t i : sense_partition_.order()) {
+    SenseOrCarryOn(i);
+  }
+  ++step_;
+  if (recorder_ != nullptr) {
+    recorder_->Record(step_, entities_);
   }
 }  // UpdateEntitiesTimestep()
 
-/* Determine if the entity is colliding with a wall.
- * Always returns an entity type. If not collision, returns kUndefined.
- */
-EntityType Arena::GetCollisionWall(ArenaMobileEntity *const ent) {
-  if (ent->get_pose().x + ent->get_radius() >= x_dim_) {
-    return kRightWall;  // at x = x_dim_
-  } else if (ent->get_pose().x - ent->get_radius() <= 0) {
-    return kLeftWall;  // at x = 0
-  } else if (ent->get_pose().y + ent->get_radius() >= y_dim_) {
-    return kBottomWall;  // at y = y_dim
-  } else if (ent->get_pose().y - ent->get_radius() <= 0) {
-    return kTopWall;  // at y = 0
-  } else {
-    return kUndefined;
+// Entities move at most `speed` a unit of time, so a pair closes by at most
+// twice that; robots' readings are sums of 1200 / base^d over the sources.
+// Both bounds are found from the state at the start of the step, so the
+// same state always gets the same step.
+double Arena::ChooseDt() {
+  if (!adaptive_dt_) {
+    return dt_;
+  }
+  double speed = 0;
+  for (auto ent : mobile_entities_) {
+    WheelVelocity v = ent->get_wheel_velocity();
+    speed = std::max(speed, std::max(std::fabs(v.left), std::fabs(v.right)));
+  }
+  if (!(speed > 0)) {
+    return dt_;
+  }
+  // Gaps wider than a step of dt_ can close do not shorten the step.
+  double cap = 2 * speed * dt_;
+  double clearance =
+      broadphase_ ? broadphase_->Clearance(entities_, mobile_entities_, cap)
+                  : AllPairsClearance(entities_, mobile_entities_, cap);
+  double dt = std::min(dt_, clearance / (2 * speed));
+  for (auto robot : robot_) {
+    WheelVelocity v = robot->get_wheel_velocity();
+    double change = robot->SensorGradient() *
+                    std::max(std::fabs(v.left), std::fabs(v.right));
+    if (change * dt > kMaxSensorChange) {
+      dt = kMaxSensorChange / change;
+    }
   }
-} /* GetCollisionWall() */
+  return std::max(dt, std::min(dt_min_, dt_));
+}
 
-/* The entity type indicates which wall the entity is colliding with.
-* This determines which way to move the entity to set it slightly off the wall.
-*/
-void Arena::AdjustWallOverlap(ArenaMobileEntity *const ent, EntityType object) {
-  Pose entity_pos = ent->get_pose();
-  switch (object) {
-    case (kRightWall):  // at x = x_dim_
-    ent->set_position(x_dim_-(ent->get_radius()+5), entity_pos.y);
-    break;
-    case (kLeftWall):  // at x = 0
-    ent->set_position(ent->get_radius()+5, entity_pos.y);
-    break;
-    case (kTopWall):  // at y = 0
-    ent->set_position(entity_pos.x, ent->get_radius()+5);
-    break;
-    case (kBottomWall):  // at y = y_dim_
-    ent->set_position(entity_pos.x, y_dim_-(ent->get_radius()+5));
-    break;
-    default:
-    {}
+/* Entities are moved off the walls all together, then each reacts to the
+ * walls it touched through its own HandleWallCollision().
+ */
+void Arena::ResolveWallCollisions(bool react) {
+  if (wall_collision_.Apply(mobile_entities_, x_dim_, y_dim_) == 0 ||
+      !react) {
+    return;
+  }
+  const std::vector<uint8_t> &walls = wall_collision_.get_masks();
+  for (size_t m = 0; m < mobile_entities_.size(); ++m) {
+    if (walls[m] != 0) {
+      mobile_entities_[m]->HandleWallCollision(walls[m]);
+    }
   }
 }
 
@@ -206,30 +765,138 @@ bool Arena::IsColliding(
     (distance_between <= (mobile_e->get_radius() + other_e->get_radius()));
 }
 
+bool Arena::IsNear(ArenaMobileEntity *const mobile_e,
+                   ArenaEntity *const other_e) {
+  double dx = other_e->get_pose().x - mobile_e->get_pose().x;
+  double dy = other_e->get_pose().y - mobile_e->get_pose().y;
+  double near = mobile_e->get_radius() + other_e->get_radius() +
+                RELAX_CONTACT_MARGIN;
+  return dx * dx + dy * dy < near * near;
+}
 
 /* This is called when it is known that the two entities overlap.
 * We determine by how much they overlap then move the mobile entity to
-* the edge of the other
-*/
-/* @TODO: Add functionality to Pose to determine the distance distance_between two instances (e.g. overload operator -)
+* the edge of the other, along the unit vector between their centers.
+* (Moving both axes by the cosine of the contact angle, as this once did,
+* sent robots through food in some quadrants.)
 */
-/* @BUG: The robot will pass through the home food on occasion. The problem
- * is likely due to the adjustment being in the wrong direction. This could
- * be because the cos/sin generate the wrong sign of the distance_to_move
- * when the collision is in a specific quadrant relative to the center of the
- * colliding entities..
- */
 void Arena::AdjustEntityOverlap(ArenaMobileEntity * const mobile_e,
   ArenaEntity *const other_e) {
-    double delta_x = mobile_e->get_pose().x - other_e->get_pose().x;
-    double delta_y = mobile_e->get_pose().y - other_e->get_pose().y;
-    double distance_between = sqrt(delta_x*delta_x + delta_y*delta_y);
+    double nx = 0, ny = 0;
+    double distance_between = ContactNormal(
+        mobile_e->get_pose().x, mobile_e->get_pose().y,
+        other_e->get_pose().x, other_e->get_pose().y, &nx, &ny);
     double distance_to_move =
       mobile_e->get_radius() + other_e->get_radius() - distance_between;
-    double angle = atan2(delta_y, delta_x);
     mobile_e->set_position(
-     mobile_e->get_pose().x+cos(angle)*distance_to_move,
-     mobile_e->get_pose().y+cos(angle)*distance_to_move);
+     mobile_e->get_pose().x + nx * distance_to_move,
+     mobile_e->get_pose().y + ny * distance_to_move);
+}
+
+void Arena::IndexForSensing() {
+  if (!(sensor_range_ > 0)) {
+    return;
+  }
+  if (sense_tree_.size() != entities_.size()) {
+    sense_tree_.Reset(0, 0, std::max(x_dim_, y_dim_));
+  }
+  for (uint32_t i = 0; i < entities_.size(); ++i) {
+    sense_tree_.Update(i, entities_[i]->get_pose().x,
+                       entities_[i]->get_pose().y,
+                       entities_[i]->get_radius());
+  }
+}
+
+void Arena::SenseRobot(uint32_t i) {
+  ArenaEntity *const *sensed = nullptr;
+  size_t n_sensed = SensedBy(robot_[i], &sensed);
+  for (size_t done = 0; done < n_sensed;) {
+    done += robot_[i]->SenseEntities(sensed + done, n_sensed - done);
+  }
+}
+
+// Sensing in full costs two pow() per light, where carrying the readings on
+// costs two multiplies. What the robot does at once -- eating, reacting to
+// a collision, a change of class -- is never carried on.
+void Arena::SenseOrCarryOn(uint32_t i) {
+  if (sense_interval_ == 1) {
+    SenseRobot(i);
+    return;
+  }
+  Robot *robot = robot_[i];
+  if (sense_decimation_.size() != robot_.size()) {
+    sense_decimation_.Reset(robot_.size());
+  }
+  uint8_t state = robot_states_[i];
+  bool due = RobotSpeedsUp(state) ||
+             sense_decimation_.Due(i, RobotSenseClass(state),
+                                   sense_interval_) ||
+             robot->get_touch_sensor()->get_output();
+  ArenaEntity *const *sensed = nullptr;
+  size_t n_sensed = due ? 0 : SensedBy(robot, &sensed);
+  for (size_t k = 0; k < n_sensed && !due; ++k) {
+    due = sensed[k]->get_type() == kFood && robot->IsFoodConsumed(sensed[k]);
+  }
+  if (due) {
+    SenseRobot(i);
+    sense_decimation_.Record(
+        i, RobotSenseClass(robot_states_[i]),
+        robot->get_left_light_sensor()->get_sensor_reading(),
+        robot->get_right_light_sensor()->get_sensor_reading());
+    return;
+  }
+  double left = 0, right = 0;
+  sense_decimation_.Extrapolate(i, &left, &right);
+  robot->SenseLightReadings(left, right);
+}
+
+size_t Arena::SensedBy(const Robot *robot, ArenaEntity *const **sensed) {
+  if (!(sensor_range_ > 0)) {
+    *sensed = entities_.data();
+    return entities_.size();
+  }
+  sensed_ids_.clear();
+  sense_tree_.Query(robot->get_pose().x, robot->get_pose().y, sensor_range_,
+                    &sensed_ids_);
+  // Entities are sensed in entities_'s order, as without a range. When most
+  // of them are in range, marking them is cheaper than sorting their ids.
+  sensed_.clear();
+  if (sensed_ids_.size() * 8 > entities_.size()) {
+    sensed_marks_.assign(entities_.size(), 0);
+    for (uint32_t id : sensed_ids_) {
+      sensed_marks_[id] = 1;
+    }
+    for (size_t id = 0; id < entities_.size(); ++id) {
+      if (sensed_marks_[id]) {
+        sensed_.push_back(entities_[id]);
+      }
+    }
+  } else {
+    std::sort(sensed_ids_.begin(), sensed_ids_.end());
+    for (uint32_t id : sensed_ids_) {
+      sensed_.push_back(entities_[id]);
+    }
+  }
+  *sensed = sensed_.data();
+  return sensed_.size();
+}
+
+void Arena::ResolveCollision(size_t m, size_t j) {
+  ArenaMobileEntity *mobile_e = mobile_entities_[m];
+  ArenaEntity *other_e = entities_[j];
+  if (relax_passes_ > 0) {
+    overlap_solver_.AddContact(static_cast<uint32_t>(m),
+                               static_cast<uint32_t>(j));
+  } else {
+    AdjustEntityOverlap(mobile_e, other_e);
+  }
+  if (mobile_e->get_type() == kRobot) {
+    dynamic_cast <Robot*> (mobile_e)-> HandleCollision
+    (other_e->get_type(), other_e);
+  } else {
+    dynamic_cast <Light*> (mobile_e)-> HandleCollision
+    (other_e->get_type(), other_e);
+  }
 }
 
 
@@ -238,6 +905,7 @@ void Arena::AdjustEntityOverlap(ArenaMobileEntity * const mobile_e,
   * for controlling the robot.
   */
 void Arena::AcceptCommand(Communication com) {
+  LogInput(kInputCommand, com);
   switch (com) {
     case(kIncreaseSpeed):  // robot_ -> IncreaseSpeed();
     break;
@@ -264,6 +932,7 @@ void Arena::AcceptCommand(Communication com) {
 // makes sure that the robot knows if food is on or off.
 void Arena::set_behavior_sensitivity_robot(int fcount, float lsensor_base,
                                                       int fonoff) {
+  LogInput(kInputBehavior, fcount, fonoff, lsensor_base);
   for (auto& robot : robot_) {
     if (fcount > 0) {
       robot->set_behavior_flag(1);
@@ -272,8 +941,34 @@ void Arena::set_behavior_sensitivity_robot(int fcount, float lsensor_base,
       robot->set_behavior_flag(0);
     }
     robot-> set_sensitivity_to_light(lsensor_base);
-    robot-> set_food_on_off(fonoff);
   }
+  // Food is on or off for every robot alike: one pass over the states.
+  RobotEvent food = fonoff != 0 ? kRobotSetFoodOn : kRobotSetFoodOff;
+  for (auto &state : robot_states_) {
+    state = RobotTransition(state, food);
+  }
+  InvalidateRobotTimers();
+}
+
+size_t Arena::CountRobots(uint8_t mask, uint8_t value) const {
+  size_t count = 0;
+  for (uint8_t state : robot_states_) {
+    count += (state & mask) == value;
+  }
+  return count;
+}
+
+void Arena::BindRobotStates() {
+  // Robots copy their state back into themselves before the array moves.
+  for (auto robot : robot_) {
+    robot->BindState(nullptr);
+  }
+  robot_states_.assign(robot_.size(), 0);
+  for (size_t i = 0; i < robot_.size(); ++i) {
+    robot_[i]->BindState(&robot_states_[i]);
+  }
+  sense_partition_.Reset(robot_states_);
+  sense_decimation_.Reset(robot_.size());
 }
 
 
@@ -10,15 +10,30 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <vector>
 
+#include "src/broadphase.h"
 #include "src/common.h"
 #include "src/food.h"
+#include "src/kinetic_schedule.h"
+#include "src/loose_quadtree.h"
 #include "src/entity_factory.h"
+#include "src/entity_state.h"
 #include "src/robot.h"
+#include "src/robot_partition.h"
+#include "src/sense_decimation.h"
 #include "src/communication.h"
+#include "src/overlap_solver.h"
+#include "src/session_log.h"
+#include "src/swept_collision.h"
+#include "src/timer_wheel.h"
+#include "src/wall_collision.h"
 
 /*******************************************************************************
  * Namespaces
@@ -29,6 +44,8 @@ NAMESPACE_BEGIN(csci3081);
  * Class Definitions
  ******************************************************************************/
 struct arena_params;
+class BinaryWriter;
+class TrajectoryRecorder;
 
 /**
  * @brief The main class for the simulation of a 2D world with many entities
@@ -69,6 +86,21 @@ class Arena {
    */
   void AdvanceTime(double dt);
 
+  /**
+   * @brief Advance the simulation by at least one and at most `limit` steps.
+   *
+   * With kinetic mode off (see arena_params::kinetic) this is one step.
+   * With it on, if the next steps are quiet -- no entities meet, no robot
+   * timer is due, and of the robots that are cruising none senses anything
+   * that would change it -- all of them up to `limit` are run at once,
+   * without the collision pass and without sensing for the cruising robots.
+   * Either way the Arena ends in the state the same number of single steps
+   * would leave it in.
+   *
+   * @return The number of steps run; 0 only if `limit` is 0.
+   */
+  uint32_t AdvanceSteps(uint32_t limit);
+
   /**
    * @brief Function that adds the desired number of robots to the Arena.
    *
@@ -104,6 +136,63 @@ class Arena {
    */
   void Reset();
 
+  /**
+   * @brief Write the complete simulation state to a binary snapshot file.
+   *
+   * The file is little-endian and versioned. It holds the Arena's geometry
+   * and counters, the factory's creation counters, the random stream and
+   * one fixed-size record (see EntityState) per entity, in entity order.
+   *
+   * @param[in] path The file to create or overwrite.
+   *
+   * @return false if the file could not be written.
+   */
+  bool SaveSnapshot(const std::string &path) const;
+
+  /**
+   * @brief Replace the simulation state with one written by SaveSnapshot().
+   *
+   * The file is read with a single read. If the Arena already holds the same
+   * sequence of entity types (the usual case when restarting a scenario),
+   * the existing entities are overwritten in place and nothing is allocated.
+   *
+   * @param[in] path The snapshot file to read.
+   *
+   * @return false, leaving the Arena untouched, if the file is missing,
+   * truncated or of an unknown version.
+   */
+  bool LoadSnapshot(const std::string &path);
+
+  /**
+   * @brief Restart the Arena's random stream from `seed`. Call before adding
+   * entities; together with the fixed one-step-per-call AdvanceTime() this
+   * makes a run reproducible.
+   */
+  void Seed(uint64_t seed);
+
+  /**
+   * @brief A new Arena in exactly this Arena's state -- entities, counters,
+   * factory counters and random stream -- which from here on runs exactly
+   * as this one would, e.g. to branch variants off a shared warm-up.
+   *
+   * The copy has no trajectory recorder or session log. The caller owns it.
+   */
+  Arena *Clone() const;
+
+  /**
+   * @brief Make this Arena an exact copy of `other` (see Clone()). If this
+   * Arena already holds the same sequence of entity types, e.g. an earlier
+   * branch of the same warm-up, its entities are overwritten in place and
+   * nothing is allocated.
+   */
+  void CopyFrom(const Arena &other);
+
+  /**
+   * @brief A 64-bit FNV-1a hash of everything SaveSnapshot() would write.
+   * Two Arenas in identical states have the same checksum.
+   */
+  uint64_t StateChecksum() const;
+
   /**
    * @brief Under certain circumstance, the compiler requires that the
    * assignment operator is not defined. This `deletes` the default
@@ -130,37 +219,38 @@ class Arena {
   bool IsColliding(
     ArenaMobileEntity * const mobile_e, ArenaEntity * const other_e);
 
+  /**
+   * @brief Whether the entities are less than RELAX_CONTACT_MARGIN from
+   * touching: a contact for the overlap solver even if they do not collide.
+   */
+  bool IsNear(ArenaMobileEntity *const mobile_e, ArenaEntity *const other_e);
+
 
 
   /**
-  * @brief Move the mobile entity to the edge of the other without overlap.
+  * @brief Move the mobile entity to the edge of the other without overlap,
+  * along the line between their centers.
   * Without this, entities tend to get stuck inside one another.
   **/
   void AdjustEntityOverlap(ArenaMobileEntity * const mobile_e,
     ArenaEntity *const other_e);
 
   /**
-   * @brief Determine if a particular entity has gone out of the boundaries of
-   * the simulation (i.e. has collided with any one of the walls).
-   *
-   * @param ent The entity to check.
-   * @param [out] An entity type signifying wall (e.g. kRightWall). kUndefined
-   * if no collision.
-   *
-   * The checked entity's position will be updated to a "back-off position" so
-   * that it won't get stuck into a wall. The calculation of the "back-off
-   * position" is technically not accurate, but good enough for our purpose.
+   * @brief Let mobile entity `m` react to its collision with entity `j`,
+   * and separate them: at once, or, with the overlap solver, after the
+   * collision pass.
    */
-  EntityType GetCollisionWall(ArenaMobileEntity * const ent);
+  void ResolveCollision(size_t m, size_t j);
 
   /**
-  * @brief Move the entity to the edge of the wall without overlap.
-  * Without this, entities tend to get stuck in walls.
-  *
-  * @param[in] ent The entity that has to be moved to the edge of the wall.
-  * @param[in] wall Denotes which wall it is - i.e. left, right etc.
-  **/
-  void AdjustWallOverlap(ArenaMobileEntity * const ent, EntityType wall);
+   * @brief Move every mobile entity that has gone out of the boundaries of
+   * the simulation (i.e. touches any of the walls) back off every wall it
+   * touches, and, if `react`, let each handle the walls it touched.
+   *
+   * The "back-off position" keeps entities from getting stuck in the walls.
+   * It is technically not accurate, but good enough for our purpose.
+   */
+  void ResolveWallCollisions(bool react);
 
 
   /**
@@ -187,13 +277,22 @@ class Arena {
   void set_game_status(int status) { game_status_ = status; }
 
   int get_robot_count() { return robot_count_; }
-  void set_robot_count(int rcount) { robot_count_ = rcount; }
+  void set_robot_count(int rcount) {
+    robot_count_ = rcount;
+    LogInput(kInputRobotCount, rcount);
+  }
 
   int get_light_count() { return light_count_; }
-  void set_light_count(int lcount) { light_count_ = lcount; }
+  void set_light_count(int lcount) {
+    light_count_ = lcount;
+    LogInput(kInputLightCount, lcount);
+  }
 
   int get_food_count() { return food_count_; }
-  void set_food_count(int fcount) { food_count_ = fcount; }
+  void set_food_count(int fcount) {
+    food_count_ = fcount;
+    LogInput(kInputFoodCount, fcount);
+  }
 
   /**
   *
@@ -209,7 +308,175 @@ class Arena {
   void set_behavior_sensitivity_robot(int fcount, float lsensor_base,
                                                  int fonoff);
 
+  /**
+   * @brief Every robot's behavior state (see RobotStateBit), in robot order.
+   */
+  const std::vector<uint8_t> &get_robot_states() const {
+    return robot_states_;
+  }
+
+  /**
+   * @brief The number of robots whose state has the bits of `value` within
+   * `mask`, e.g. CountRobots(kRobotHungry, kRobotHungry).
+   */
+  size_t CountRobots(uint8_t mask, uint8_t value) const;
+
+  /**
+   * @brief The collision pass's broadphase, for its counts, or nullptr if
+   * it tests all pairs.
+   */
+  const Broadphase *get_broadphase() const { return broadphase_.get(); }
+
+  /**
+   * @brief Number of timesteps completed since the Arena was created.
+   */
+  uint32_t get_step() const { return step_; }
+
+  /**
+   * @brief The time the last step moved entities by: arena_params::dt, or
+   * with adaptive_dt on, what ChooseDt() picked for it.
+   */
+  double get_step_dt() const { return step_dt_; }
+
+  /**
+   * @brief The robots' full sensings and carried-on readings, for their
+   * counts (see arena_params::sense_interval).
+   */
+  const SenseDecimation &get_sense_decimation() const {
+    return sense_decimation_;
+  }
+
+  /**
+   * @brief Change the steps between the robots' full sensings (at least 1)
+   * from the next step on; every robot then senses in full at that step.
+   */
+  void set_sense_interval(uint32_t interval) {
+    interval = std::max(interval, 1u);
+    if (interval != sense_interval_) {
+      sense_interval_ = interval;
+      sense_decimation_.Reset(robot_.size());
+      LogInput(kInputSenseInterval, static_cast<int>(interval));
+    }
+  }
+  uint32_t get_sense_interval() const { return sense_interval_; }
+
+  /**
+   * @brief Number of steps AdvanceSteps() has run as part of a quiet run.
+   */
+  uint64_t get_coasted_steps() const { return coasted_steps_; }
+
+  /**
+   * @brief Feed every subsequent timestep to `recorder` (not owned), or stop
+   * recording if it is nullptr.
+   */
+  void set_trajectory_recorder(TrajectoryRecorder *recorder) {
+    recorder_ = recorder;
+  }
+
+  /**
+   * @brief Append every subsequent input (entity creation, counts, behavior
+   * settings and commands) to `log` (not owned), or stop logging if nullptr.
+   */
+  void set_session_log(SessionLog *log) { session_log_ = log; }
+
  private:
+  /**
+   * @brief Record an input in the session log, if one is attached.
+   */
+  void LogInput(SessionInput kind, int a = 0, int b = 0, float c = 0) {
+    if (session_log_ != nullptr) {
+      session_log_->Append(step_, kind, a, b, c);
+    }
+  }
+
+  /**
+   * @brief Give every robot its slot in robot_states_, and partition them
+   * afresh; call after the set of robots changes.
+   */
+  void BindRobotStates();
+
+  /**
+   * @brief Schedule every robot's hunger check for the next step, after
+   * anything that may have changed the robots other than a step.
+   */
+  void InvalidateRobotTimers() { robot_timers_stale_ = true; }
+
+  /**
+   * @brief How many of the next steps, up to `limit`, are quiet (see
+   * AdvanceSteps()), and which robots must still sense in them.
+   */
+  uint32_t QuietSteps(uint32_t limit);
+
+  /**
+   * @brief Run `steps` quiet steps as UpdateEntitiesTimestep() would, with
+   * no collisions to find, and only the robots QuietSteps() chose sensing.
+   */
+  void Coast(uint32_t steps);
+
+  /**
+   * @brief The time the next step moves entities by. With adaptive_dt on,
+   * the longest step up to dt in which no two entities close more than
+   * their gap and no robot's sensor readings change by more than a factor
+   * of e, but never less than dt_min; otherwise dt.
+   */
+  double ChooseDt();
+
+  /**
+   * @brief Index the entities by position for sensing, if robots have a
+   * sensor range.
+   */
+  void IndexForSensing();
+
+  /**
+   * @brief Let robot `i` sense what it senses this step.
+   */
+  void SenseRobot(uint32_t i);
+
+  /**
+   * @brief Let robot `i` sense in full, or with a sense interval, carry its
+   * light readings on if it is not due to sense (see SenseDecimation).
+   */
+  void SenseOrCarryOn(uint32_t i);
+
+  /**
+   * @brief Point `sensed` at the entities `robot` senses, in entity order,
+   * and return how many there are: every entity, or with a sensor range
+   * those within it.
+   */
+  size_t SensedBy(const Robot *robot, ArenaEntity *const **sensed);
+
+  /**
+   * @brief Schedule robot `index`'s next hunger check, in as many steps as
+   * are sure not to pass it even if they are all dt long.
+   */
+  void ScheduleRobotTimer(uint32_t index) {
+    double steps = std::floor(robot_[index]->TimeToHungerCheck() / dt_);
+    robot_timers_.Schedule(
+        robot_timers_.get_now() + static_cast<uint64_t>(std::max(1.0, steps)),
+        index);
+  }
+
+  /**
+   * @brief Encode the complete state in snapshot format.
+   */
+  void EncodeSnapshot(BinaryWriter *out) const;
+
+  /**
+   * @brief `delete` every entity and empty all entity vectors.
+   */
+  void ReleaseEntities();
+
+  /**
+   * @brief Copy the state of every entity, in entity order, into `states`.
+   */
+  void CaptureEntities(std::vector<EntityState> *states) const;
+
+  /**
+   * @brief Make the Arena's entities match `states`, reusing the existing
+   * entities when the type sequence is unchanged.
+   */
+  void RestoreEntities(const std::vector<EntityState> &states);
+
   // Dimensions of graphics window inside which entities must operate
   double x_dim_;
   double y_dim_;
@@ -220,11 +487,60 @@ class Arena {
 
   // Vector for all the robots in the arena.
   std::vector<class Robot *> robot_;
+  // The robots' behavior states, packed, in robot_ order; each robot keeps
+  // its state here rather than in itself.
+  std::vector<uint8_t> robot_states_;
+  // Robot indices grouped by sense class, the order in which they sense.
+  RobotPartition sense_partition_;
   // All entities mobile and immobile.
   std::vector<class ArenaEntity *> entities_;
 
   // A subset of the entities -- only those that can move.
   std::vector<class ArenaMobileEntity *> mobile_entities_;
+  // How far robots sense (see arena_params::sensor_range), and, if they do
+  // not sense everything, the entities indexed by position for it.
+  double sensor_range_;
+  LooseQuadtree sense_tree_;
+  std::vector<uint32_t> sensed_ids_;
+  std::vector<uint8_t> sensed_marks_;
+  std::vector<ArenaEntity *> sensed_;
+  // Steps between the robots' full sensings (see arena_params::
+  // sense_interval), and their readings in between.
+  uint32_t sense_interval_;
+  SenseDecimation sense_decimation_;
+  // Finds the collision pass's candidate pairs (see arena_params::broadphase).
+  std::unique_ptr<Broadphase> broadphase_;
+  // Passes of the overlap solver, or 0 to separate each pair as found (see
+  // arena_params::relax_passes), and the solver with this step's contacts.
+  int relax_passes_;
+  OverlapSolver overlap_solver_;
+  // The entities, by ascending index, that the collision pass has carried
+  // beyond the broadphase's skin since it last found the candidates.
+  std::vector<uint32_t> escaped_;
+  // The time each step moves entities by, and whether they are stopped at
+  // their first contact along it (see arena_params::dt). With adaptive_dt_,
+  // dt_ is the longest step and dt_min_ the shortest; step_dt_ is the last
+  // step's.
+  double dt_;
+  int adaptive_dt_;
+  double dt_min_;
+  double step_dt_;
+  int ccd_;
+  SweptCollision swept_collision_;
+  // Finds and undoes the mobile entities' wall contacts.
+  WallCollision wall_collision_;
+  // Whether quiet steps are run at once (see arena_params::kinetic), the
+  // schedule that finds them, the entities as it sees them, the robots that
+  // go on sensing through them, and the steps run that way.
+  int kinetic_;
+  KineticSchedule kinetic_schedule_;
+  std::vector<KineticBody> kinetic_bodies_;
+  std::vector<uint32_t> active_robots_;
+  // Steps to run singly before looking for quiet steps again, and how many
+  // were waited last time.
+  uint32_t kinetic_backoff_;
+  uint32_t kinetic_wait_;
+  uint64_t coasted_steps_;
 
   // win/lose/playing state
   int game_status_;
@@ -234,6 +550,17 @@ class Arena {
   int light_count_;
   // number of food entities in the arena
   int food_count_;
+  // number of timesteps completed
+  uint32_t step_;
+  // optional sink for per-step trajectories
+  TrajectoryRecorder *recorder_;
+  // optional record of every input
+  SessionLog *session_log_;
+  // Hunger and starvation checks, by index in robot_. The wheel's clock is
+  // the number of the step last run.
+  TimerWheel robot_timers_;
+  bool robot_timers_stale_;
+  std::vector<uint32_t> fired_timers_;
 };
 
 NAMESPACE_END(csci3081);
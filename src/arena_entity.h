@@ -13,9 +13,11 @@
 #include <string>
 
 #include "src/common.h"
+#include "src/entity_state.h"
 #include "src/entity_type.h"
 #include "src/params.h"
 #include "src/pose.h"
+#include "src/random_generator.h"
 #include "src/rgb_color.h"
 
 /*******************************************************************************
@@ -50,6 +52,8 @@ class ArenaEntity {
  * @brief ArenaEntity constructor initialized with default values from params.h
  */
   ArenaEntity() : pose_(DEFAULT_POSE), color_(DEFAULT_COLOR) {}
+  ArenaEntity(const ArenaEntity& other) = default;
+  ArenaEntity& operator=(const ArenaEntity& other) = default;
 
   /**
    * @brief Default destructor -- as defined by compiler.
@@ -62,13 +66,48 @@ class ArenaEntity {
    *
    * @param[in] dt is time elapsed since the last update. Unused.
    */
-  virtual void TimestepUpdate(__unused unsigned int dt) {}
+  virtual void TimestepUpdate(__unused double dt) {}
 
   /**
    * @brief Reset entity to a newly constructed state.
    */
   virtual void Reset() {}
 
+  /**
+   * @brief Copy the entity's complete state into a flat record.
+   *
+   * Derived classes extend this with their own fields and must call the
+   * base version first.
+   *
+   * @param[out] state The record to fill.
+   */
+  virtual void SaveState(EntityState *state) const {
+    state->type = type_;
+    state->id = id_;
+    state->flags = is_mobile_ ? kStateMobile : 0;
+    state->x = pose_.x;
+    state->y = pose_.y;
+    state->theta = pose_.theta;
+    state->radius = radius_;
+    state->color_r = static_cast<uint8_t>(color_.r);
+    state->color_g = static_cast<uint8_t>(color_.g);
+    state->color_b = static_cast<uint8_t>(color_.b);
+  }
+
+  /**
+   * @brief Restore the entity from a record produced by SaveState().
+   *
+   * @param[in] state The record to restore from.
+   */
+  virtual void LoadState(const EntityState &state) {
+    type_ = static_cast<EntityType>(state.type);
+    id_ = state.id;
+    is_mobile_ = (state.flags & kStateMobile) != 0;
+    pose_ = Pose(state.x, state.y, state.theta);
+    radius_ = state.radius;
+    color_ = RgbColor(state.color_r, state.color_g, state.color_b);
+  }
+
   /**
    * @brief Get the name of the entity for visualization and for debugging.
    *
@@ -134,13 +173,20 @@ class ArenaEntity {
    */
   void set_mobility(bool value) { is_mobile_ = value; }
 
+  /**
+   * @brief Setter for the random stream used by Reset(). Entities made by the
+   * EntityFactory share the stream of their Arena.
+   */
+  void set_random_generator(RandomGenerator *rng) { rng_ = rng; }
+  RandomGenerator *get_random_generator() const { return rng_; }
+
   /**
    * @brief For creating random positions within the graphics window
    */
   Pose SetPoseRandomly() {
   // Dividing arena into 19x14 grid. Each grid square is 50x50
-  return {static_cast<double>((30 + (random() % 19) * 50)),
-        static_cast<double>((30 + (random() % 14) * 50))};
+  return {static_cast<double>((30 + (rng_->Next() % 19) * 50)),
+        static_cast<double>((30 + (rng_->Next() % 14) * 50))};
 }
 
 
@@ -151,6 +197,7 @@ class ArenaEntity {
   EntityType type_{kEntity};
   int id_{-1};
   bool is_mobile_{false};
+  RandomGenerator *rng_{RandomGenerator::Default()};
 };
 
 NAMESPACE_END(csci3081);
@@ -15,6 +15,7 @@
 #include "src/arena_entity.h"
 #include "src/common.h"
 #include "src/sensor_touch.h"
+#include "src/wheel_velocity.h"
 
 /*******************************************************************************
  * Namespaces
@@ -53,6 +54,14 @@ class ArenaMobileEntity : public ArenaEntity {
   virtual double get_speed() { return speed_; }
   virtual void set_speed(double sp) { speed_ = sp; }
 
+  /**
+   * @brief The wheel velocities the next TimestepUpdate() moves the entity
+   * with, by the differential drive model (see MotionBehaviorDifferential).
+   */
+  virtual WheelVelocity get_wheel_velocity() const {
+    return WheelVelocity(0, 0);
+  }
+
   /**
    * @brief Get a pointer to the ArenaMobileEntity's touch sensor.
    */
@@ -63,6 +72,12 @@ class ArenaMobileEntity : public ArenaEntity {
    */
   void HandleCollision(EntityType object_type, ArenaEntity * object = NULL);
 
+  /**
+   * @brief React to touching the walls in `walls`, a mask of WallBit()s, as
+   * one collision: in a corner the entity turns away once, not twice.
+   */
+  virtual void HandleWallCollision(__unused uint8_t walls) {}
+
 
 
  private:
@@ -11,6 +11,10 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+
+#include "src/broadphase.h"
 #include "src/common.h"
 #include "src/light.h"
 #include "src/params.h"
@@ -20,6 +24,18 @@
  ******************************************************************************/
 NAMESPACE_BEGIN(csci3081);
 
+/*******************************************************************************
+ * Enums
+ ******************************************************************************/
+/**
+ * @brief Whether a headless run stops when robots starve (see Termination).
+ */
+enum StarvationStop {
+  kStarvationIgnore = 0,
+  kStarvationFirst,  // when any robot starves
+  kStarvationAll,    // when every robot is starving
+};
+
 /*******************************************************************************
  * Structure Definitions
  ******************************************************************************/
@@ -27,12 +43,73 @@ NAMESPACE_BEGIN(csci3081);
 * @brief Struct holding parameters for initializing the Arena.
 *
 * These parameters include the parameters for Arena's geometry as well as the
-* parameters for initializing ALL entities within the Arena.
+* parameters for initializing ALL entities within the Arena. The defaults are
+* the GUI's starting values; a scenario file (see LoadScenario()) can set
+* any of them, beyond the range of the GUI sliders.
 */
 struct arena_params {
-  size_t n_lights{4};
+  size_t n_robots{5};
+  size_t n_lights{0};
+  size_t n_food{0};
   uint x_dim{ARENA_X_DIM};
   uint y_dim{ARENA_Y_DIM};
+  // Number of robots that fear light; the rest are exploratory.
+  size_t fear_count{0};
+  float light_sensitivity{1.0f};
+  int food_on{1};
+  // How far, from a robot's center to an entity's edge, robots sense; 0 for
+  // no limit, as the robots' sensors have.
+  double sensor_range{0};
+  // Robots sense every light in full at least once in this many steps, and
+  // in between carry their light readings on (see SenseDecimation). They
+  // still sense in full at once when their sense class changes, when they
+  // collide and when they can eat; 1 senses every step. Kinetic mode is off
+  // unless this is 1.
+  uint32_t sense_interval{1};
+  // How the collision pass finds candidate pairs (a BroadphaseKind), and the
+  // skin distance they are found with; a skin of 0 tests every pair. The
+  // outcome is the same whichever is used.
+  int broadphase{kBroadphaseNeighborList};
+  double neighbor_skin{40};
+  // Passes of the overlap solver (see OverlapSolver) that separates the
+  // collision pass's contacts together; 0 separates each pair as it is
+  // found, in entity order.
+  int relax_passes{0};
+  // Time each step moves the mobile entities by, in the units of their
+  // speeds; hunger and arcing after a collision run on the same time.
+  // With ccd on, each mobile entity is stopped at its first contact along
+  // the step's motion (see SweptCollision), so that long steps do not carry
+  // entities through each other.
+  double dt{1};
+  int ccd{0};
+  // With adaptive_dt on, dt is the longest step, and each step is shortened
+  // (down to dt_min) so that no two entities can close more than their gap
+  // in it and no robot's sensor readings change much: long steps when the
+  // arena is sparse and calm, short ones when it is crowded.
+  int adaptive_dt{0};
+  double dt_min{0.25};
+  // With kinetic on, runs of steps in which no entities meet, no robot
+  // senses anything that changes it and no timer is due are run without the
+  // collision pass and sensing (see KineticSchedule). The outcome is the
+  // same either way. Off with adaptive_dt.
+  int kinetic{0};
+  // Random seed. 0 lets the viewer seed from the clock.
+  uint64_t seed{0};
+  // Worker threads for tools that run several arenas at once.
+  size_t n_threads{1};
+  // Steps to run for; 0 for no limit (the viewer only).
+  uint32_t max_steps{0};
+  // Early stops for headless runs (see Termination). A StarvationStop.
+  int stop_on_starvation{kStarvationIgnore};
+  // Stop once no entity has moved more than steady_epsilon in steady_window
+  // steps; off if either is 0.
+  double steady_epsilon{0};
+  uint32_t steady_window{0};
+  // Wall-clock budget in seconds; 0 for none.
+  double max_seconds{0};
+  // The viewer's frame time budget in milliseconds, held by trading away
+  // quality (see FrameGovernor); 0 keeps full quality. The viewer only.
+  double frame_budget_ms{16};
 };
 
 NAMESPACE_END(csci3081);
@@ -0,0 +1,140 @@
+/**
+ * @file binary_io.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstring>
+#include <fstream>
+
+#include "src/binary_io.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * BinaryWriter Member Functions
+ ******************************************************************************/
+uint8_t *BinaryWriter::Append(size_t n) {
+  size_t at = bytes_.size();
+  bytes_.resize(at + n);
+  return &bytes_[at];
+}
+
+void BinaryWriter::PutU16(uint16_t v) { StoreLE(v, Append(sizeof(v))); }
+void BinaryWriter::PutU32(uint32_t v) { StoreLE(v, Append(sizeof(v))); }
+void BinaryWriter::PutU64(uint64_t v) { StoreLE(v, Append(sizeof(v))); }
+void BinaryWriter::PutF32(float v) { StoreLE(v, Append(sizeof(v))); }
+void BinaryWriter::PutF64(double v) { StoreLE(v, Append(sizeof(v))); }
+
+void BinaryWriter::PutBytes(const void *data, size_t n) {
+  const uint8_t *p = static_cast<const uint8_t *>(data);
+  bytes_.insert(bytes_.end(), p, p + n);
+}
+
+void BinaryWriter::PatchU32(size_t offset, uint32_t v) {
+  StoreLE(v, &bytes_[offset]);
+}
+
+bool BinaryWriter::WriteFile(const std::string &path) const {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return false;
+  }
+  out.write(reinterpret_cast<const char *>(bytes_.data()),
+            static_cast<std::streamsize>(bytes_.size()));
+  return static_cast<bool>(out);
+}
+
+/*******************************************************************************
+ * BinaryReader Member Functions
+ ******************************************************************************/
+bool BinaryReader::Need(size_t n) {
+  if (!ok_ || size_ - pos_ < n) {
+    ok_ = false;
+    return false;
+  }
+  return true;
+}
+
+uint8_t BinaryReader::GetU8() {
+  if (!Need(1)) return 0;
+  return data_[pos_++];
+}
+
+const uint8_t *BinaryReader::Take(size_t n) {
+  if (!Need(n)) return nullptr;
+  const uint8_t *p = data_ + pos_;
+  pos_ += n;
+  return p;
+}
+
+template <typename T>
+static T TakeLE(BinaryReader *in) {
+  const uint8_t *p = in->Take(sizeof(T));
+  return p ? LoadLE<T>(p) : T();
+}
+
+uint16_t BinaryReader::GetU16() { return TakeLE<uint16_t>(this); }
+uint32_t BinaryReader::GetU32() { return TakeLE<uint32_t>(this); }
+uint64_t BinaryReader::GetU64() { return TakeLE<uint64_t>(this); }
+float BinaryReader::GetF32() { return TakeLE<float>(this); }
+double BinaryReader::GetF64() { return TakeLE<double>(this); }
+
+void BinaryReader::GetBytes(void *out, size_t n) {
+  if (!Need(n)) {
+    std::memset(out, 0, n);
+    return;
+  }
+  std::memcpy(out, data_ + pos_, n);
+  pos_ += n;
+}
+
+bool BinaryReader::Expect(const char *expected, size_t n) {
+  if (!Need(n)) return false;
+  bool match = std::memcmp(data_ + pos_, expected, n) == 0;
+  pos_ += n;
+  return match;
+}
+
+void BinaryReader::Seek(size_t pos) {
+  if (pos > size_) {
+    ok_ = false;
+    return;
+  }
+  pos_ = pos;
+}
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+bool ReadFileBytes(const std::string &path, std::vector<uint8_t> *out) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+    return false;
+  }
+  std::streamsize size = in.tellg();
+  if (size < 0) {
+    return false;
+  }
+  out->resize(static_cast<size_t>(size));
+  in.seekg(0, std::ios::beg);
+  in.read(reinterpret_cast<char *>(out->data()), size);
+  return static_cast<bool>(in);
+}
+
+uint64_t Fnv1a(const void *data, size_t n) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  uint64_t hash = UINT64_C(14695981039346656037);
+  for (size_t i = 0; i < n; ++i) {
+    hash = (hash ^ bytes[i]) * UINT64_C(1099511628211);
+  }
+  return hash;
+}
+
+NAMESPACE_END(csci3081);
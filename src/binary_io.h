@@ -0,0 +1,201 @@
+/**
+ * @file binary_io.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_BINARY_IO_H_
+#define SRC_BINARY_IO_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Byte Order Helpers
+ ******************************************************************************/
+/**
+ * @brief Store `v` at `out` in little-endian byte order.
+ *
+ * On little-endian hosts (all of the lab and cluster machines) this is a
+ * plain copy; elsewhere the bytes are assembled one at a time. Floating point
+ * values are stored as their IEEE-754 bit pattern.
+ */
+template <typename T>
+inline void StoreLE(T v, uint8_t *out) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  std::memcpy(out, &v, sizeof(T));
+#else
+  uint8_t raw[sizeof(T)];
+  std::memcpy(raw, &v, sizeof(T));
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    out[i] = raw[sizeof(T) - 1 - i];
+  }
+#endif
+}
+
+/**
+ * @brief Load a little-endian value of type `T` from `in`.
+ */
+template <typename T>
+inline T LoadLE(const uint8_t *in) {
+  T v;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  std::memcpy(&v, in, sizeof(T));
+#else
+  uint8_t raw[sizeof(T)];
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    raw[i] = in[sizeof(T) - 1 - i];
+  }
+  std::memcpy(&v, raw, sizeof(T));
+#endif
+  return v;
+}
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Appends little-endian encoded values to a growing byte buffer.
+ *
+ * All of the simulator's binary files (snapshots, trajectories, session logs)
+ * are written through this class so that they are byte-for-byte identical on
+ * every host, whatever its native byte order.
+ */
+class BinaryWriter {
+ public:
+  BinaryWriter() : bytes_() {}
+
+  /**
+   * @brief Pre-size the buffer when the final size is known.
+   */
+  void Reserve(size_t n) { bytes_.reserve(n); }
+
+  /**
+   * @brief Grow the buffer by `n` bytes and return where they start, for
+   * callers that encode a fixed-size record in one go with StoreLE().
+   */
+  uint8_t *Append(size_t n);
+
+  void PutU8(uint8_t v) { bytes_.push_back(v); }
+  void PutU16(uint16_t v);
+  void PutU32(uint32_t v);
+  void PutU64(uint64_t v);
+  void PutI32(int32_t v) { PutU32(static_cast<uint32_t>(v)); }
+  void PutF32(float v);
+  void PutF64(double v);
+  void PutBytes(const void *data, size_t n);
+
+  /**
+   * @brief Overwrite a previously written 32-bit value, e.g. a length that
+   * was only known once the payload had been appended.
+   */
+  void PatchU32(size_t offset, uint32_t v);
+
+  size_t size() const { return bytes_.size(); }
+  const std::vector<uint8_t> &bytes() const { return bytes_; }
+  void Clear() { bytes_.clear(); }
+
+  /**
+   * @brief Write the whole buffer to `path` with a single write.
+   *
+   * @return false if the file could not be written.
+   */
+  bool WriteFile(const std::string &path) const;
+
+ private:
+  std::vector<uint8_t> bytes_;
+};
+
+/**
+ * @brief Decodes little-endian values from a byte range.
+ *
+ * Reads past the end of the range do not crash: they return zero and clear
+ * ok(), so a caller can decode a whole structure and check once at the end.
+ */
+class BinaryReader {
+ public:
+  BinaryReader(const uint8_t *data, size_t size)
+      : data_(data), size_(size), pos_(0), ok_(true) {}
+  BinaryReader(const BinaryReader &other) = default;
+  BinaryReader &operator=(const BinaryReader &other) = default;
+
+  uint8_t GetU8();
+  uint16_t GetU16();
+  uint32_t GetU32();
+  uint64_t GetU64();
+  int32_t GetI32() { return static_cast<int32_t>(GetU32()); }
+  float GetF32();
+  double GetF64();
+  void GetBytes(void *out, size_t n);
+
+  /**
+   * @brief Consume `n` bytes and return a pointer to them, or nullptr if
+   * fewer than `n` remain. Pairs with LoadLE() for fixed-size records.
+   */
+  const uint8_t *Take(size_t n);
+
+  /**
+   * @brief Consume `n` bytes and return true if they equal `expected`.
+   */
+  bool Expect(const char *expected, size_t n);
+
+  void Seek(size_t pos);
+  size_t position() const { return pos_; }
+  size_t size() const { return size_; }
+  size_t remaining() const { return size_ - pos_; }
+  bool ok() const { return ok_; }
+
+ private:
+  bool Need(size_t n);
+
+  const uint8_t *data_;
+  size_t size_;
+  size_t pos_;
+  bool ok_;
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Read an entire file into `out` with a single read.
+ *
+ * @return false if the file could not be opened or read.
+ */
+bool ReadFileBytes(const std::string &path, std::vector<uint8_t> *out);
+
+/**
+ * @brief 64-bit FNV-1a hash of `n` bytes, for checksums and cache keys.
+ */
+uint64_t Fnv1a(const void *data, size_t n);
+
+/**
+ * @brief The bits of `v`, for keys that must tell every value apart.
+ */
+inline uint64_t BitsOf(double v) {
+  uint64_t bits = 0;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+inline uint32_t BitsOf(float v) {
+  uint32_t bits = 0;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_BINARY_IO_H_
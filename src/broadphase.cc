@@ -0,0 +1,234 @@
+/**
+ * @file broadphase.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "src/arena_entity.h"
+#include "src/arena_mobile_entity.h"
+#include "src/broadphase.h"
+#include "src/neighbor_list.h"
+#include "src/quadtree_broadphase.h"
+#include "src/sweep_and_prune.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+Broadphase *CreateBroadphase(int kind, double skin) {
+  switch (kind) {
+    case kBroadphaseNeighborList: return new NeighborList(skin);
+    case kBroadphaseSweepAndPrune: return new SweepAndPrune(skin);
+    case kBroadphaseQuadtree: return new QuadtreeBroadphase(skin);
+    default: return nullptr;
+  }
+}
+
+// The gap between two entities' edges; negative if they overlap.
+static double Gap(const ArenaEntity *a, const ArenaEntity *b) {
+  return std::hypot(a->get_pose().x - b->get_pose().x,
+                    a->get_pose().y - b->get_pose().y) -
+         a->get_radius() - b->get_radius();
+}
+
+double AllPairsClearance(const std::vector<ArenaEntity *> &entities,
+                         const std::vector<ArenaMobileEntity *> &mobile,
+                         double cap) {
+  double clearance = cap;
+  for (auto ent : mobile) {
+    for (auto other : entities) {
+      if (other != ent) {
+        clearance = std::min(clearance, Gap(ent, other));
+      }
+    }
+  }
+  return clearance;
+}
+
+const char *BroadphaseName(int kind) {
+  switch (kind) {
+    case kBroadphaseAllPairs: return "all_pairs";
+    case kBroadphaseNeighborList: return "neighbor_list";
+    case kBroadphaseSweepAndPrune: return "sweep_and_prune";
+    case kBroadphaseQuadtree: return "quadtree";
+    default: return "unknown";
+  }
+}
+
+bool ParseBroadphase(const std::string &name, int *kind) {
+  for (int k = kBroadphaseAllPairs; k <= kBroadphaseQuadtree; ++k) {
+    if (name == BroadphaseName(k)) {
+      *kind = k;
+      return true;
+    }
+  }
+  return false;
+}
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+const uint32_t Broadphase::kNotMobile;
+
+Broadphase::Broadphase(double skin)
+    : skin_(skin), margin_(0), x_(), y_(), radius_(), index_(), mobile_of_(),
+      valid_(false), statics_(), static_ids_(), found_(), start_(1, 0),
+      candidates_(), builds_(0), refreshes_(0) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+bool Broadphase::Refresh(const std::vector<ArenaEntity *> &entities,
+                         const std::vector<ArenaMobileEntity *> &mobile) {
+  if (!(skin_ > 0)) {
+    return false;
+  }
+  ++refreshes_;
+  bool reset = !valid_ || entities.size() != x_.size() ||
+               mobile.size() != index_.size();
+  if (Update(entities, mobile, reset)) {
+    ++builds_;
+  }
+  valid_ = true;
+  return true;
+}
+
+// A pair that is not a candidate was more than the skin apart at the last
+// Record(), and has closed by at most twice the furthest any entity has
+// moved since: while that leaves it `cap` apart, the candidates hold every
+// pair nearer than `cap`.
+double Broadphase::Clearance(const std::vector<ArenaEntity *> &entities,
+                             const std::vector<ArenaMobileEntity *> &mobile,
+                             double cap) {
+  if (!(skin_ > 0) || 2 * cap > skin_) {
+    return AllPairsClearance(entities, mobile, cap);
+  }
+  bool reset = !valid_ || entities.size() != x_.size() ||
+               mobile.size() != index_.size();
+  double moved = 0;
+  for (uint32_t i = 0; !reset && i < entities.size(); ++i) {
+    moved = std::max(moved, std::hypot(entities[i]->get_pose().x - x_[i],
+                                       entities[i]->get_pose().y - y_[i]));
+  }
+  if (reset || skin_ - 2 * moved < cap) {
+    Update(entities, mobile, true);
+    ++builds_;
+    valid_ = true;
+  }
+  double clearance = cap;
+  for (size_t m = 0; m < mobile.size(); ++m) {
+    for (auto it = begin(m); it != end(m); ++it) {
+      clearance = std::min(clearance, Gap(mobile[m], entities[*it]));
+    }
+  }
+  return clearance;
+}
+
+// As for Clearance(): a pair that is not a candidate closes by at most
+// twice the furthest any entity has moved since the last Record() and then
+// reaches, which must leave it apart.
+bool Broadphase::Reach(const std::vector<ArenaEntity *> &entities,
+                       const std::vector<ArenaMobileEntity *> &mobile,
+                       double reach) {
+  if (!(skin_ > 0) || 2 * reach > skin_) {
+    return false;
+  }
+  bool reset = !valid_ || entities.size() != x_.size() ||
+               mobile.size() != index_.size();
+  double moved = 0;
+  for (uint32_t i = 0; !reset && i < entities.size(); ++i) {
+    moved = std::max(moved, std::hypot(entities[i]->get_pose().x - x_[i],
+                                       entities[i]->get_pose().y - y_[i]));
+  }
+  if (reset || 2 * (moved + reach) > skin_) {
+    Update(entities, mobile, true);
+    ++builds_;
+    valid_ = true;
+  }
+  return true;
+}
+
+bool Broadphase::AnyMoved(const std::vector<ArenaEntity *> &entities) const {
+  for (uint32_t i = 0; i < entities.size(); ++i) {
+    if (!Within(i, entities[i]->get_pose())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Broadphase::Record(const std::vector<ArenaEntity *> &entities,
+                        const std::vector<ArenaMobileEntity *> &mobile) {
+  size_t n = entities.size();
+  x_.resize(n);
+  y_.resize(n);
+  radius_.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    x_[i] = entities[i]->get_pose().x;
+    y_[i] = entities[i]->get_pose().y;
+    radius_[i] = entities[i]->get_radius() + margin_ / 2;
+  }
+  index_.clear();
+  mobile_of_.assign(n, kNotMobile);
+  size_t next = 0;
+  for (auto ent : mobile) {
+    while (entities[next] != ent) {
+      ++next;
+    }
+    mobile_of_[next] = static_cast<uint32_t>(index_.size());
+    index_.push_back(static_cast<uint32_t>(next));
+  }
+
+  static_ids_.clear();
+  for (uint32_t i = 0; i < n; ++i) {
+    if (mobile_of_[i] == kNotMobile) {
+      static_ids_.push_back(i);
+    }
+  }
+  if (static_ids_ != statics_.get_ids()) {
+    statics_.Build(static_ids_, x_.data(), y_.data(), radius_.data());
+  } else {
+    statics_.Refit(x_.data(), y_.data(), radius_.data());
+  }
+}
+
+// Binned by mobile entity, then each short list sorted.
+void Broadphase::SetCandidates(
+    std::vector<std::pair<uint32_t, uint32_t>> *pairs) {
+  for (uint32_t m = 0; m < index_.size(); ++m) {
+    uint32_t i = index_[m];
+    found_.clear();
+    statics_.Query(x_[i], y_[i], radius_[i] + skin_, &found_);
+    for (uint32_t j : found_) {
+      pairs->push_back({m, j});
+    }
+  }
+  start_.assign(index_.size() + 1, 0);
+  for (auto &pair : *pairs) {
+    ++start_[pair.first + 1];
+  }
+  for (size_t m = 1; m < start_.size(); ++m) {
+    start_[m] += start_[m - 1];
+  }
+  candidates_.resize(pairs->size());
+  std::vector<uint32_t> fill(start_.begin(), start_.end() - 1);
+  for (auto &pair : *pairs) {
+    candidates_[fill[pair.first]++] = pair.second;
+  }
+  for (size_t m = 0; m + 1 < start_.size(); ++m) {
+    std::sort(candidates_.begin() + start_[m],
+              candidates_.begin() + start_[m + 1]);
+  }
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,255 @@
+/**
+ * @file broadphase.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_BROADPHASE_H_
+#define SRC_BROADPHASE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/common.h"
+#include "src/pose.h"
+#include "src/static_bvh.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+class ArenaEntity;
+class ArenaMobileEntity;
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+/**
+ * @brief How the collision pass finds the pairs worth testing.
+ */
+enum BroadphaseKind {
+  kBroadphaseAllPairs = 0,   // every mobile entity against every entity
+  kBroadphaseNeighborList,   // NeighborList
+  kBroadphaseSweepAndPrune,  // SweepAndPrune
+  kBroadphaseQuadtree,       // QuadtreeBroadphase
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A collision broadphase: for each mobile entity, the entities it may
+ * touch, found with a skin distance to spare.
+ *
+ * The candidates of a mobile entity include every entity that could touch
+ * it without either having moved skin/2 from where it was at the last
+ * Refresh(), so the collision pass can test only the candidates for as long
+ * as Covers() holds. Each mobile entity's candidates are indices into the
+ * entity vector in ascending order, so testing them visits entities in the
+ * same order as testing the whole vector.
+ *
+ * Each kind of broadphase pairs mobile entities with each other. Immobile
+ * entities, which only move when food is added or the arena reset, are kept
+ * apart in a StaticBvh, built when they change and refit if they move, and
+ * every mobile entity is paired with those it finds in it.
+ */
+class Broadphase {
+ public:
+  /**
+   * @param[in] skin The margin added to each pair's radii; 0 turns the
+   * broadphase off.
+   */
+  explicit Broadphase(double skin);
+  virtual ~Broadphase() {}
+
+  /**
+   * @brief Start afresh at the next Refresh(), e.g. after radii change.
+   */
+  void Invalidate() { valid_ = false; }
+
+  /**
+   * @brief Make the candidates cover the current poses. `mobile` must be
+   * the mobile subset of `entities`, in order.
+   *
+   * @return Whether the candidates can be used, i.e. whether the
+   * broadphase is on.
+   */
+  bool Refresh(const std::vector<ArenaEntity *> &entities,
+               const std::vector<ArenaMobileEntity *> &mobile);
+
+  /**
+   * @brief Whether mobile entity `m`, now at `pose`, is still within skin/2
+   * of where it was when the candidates were found. Once it is not, its
+   * candidates, and those of the entities it may now touch, are no longer
+   * complete.
+   */
+  bool Covers(size_t m, const Pose &pose) const {
+    return Within(index_[m], pose);
+  }
+
+  /**
+   * @brief The candidates of mobile entity `m`, as ascending entity indices.
+   */
+  const uint32_t *begin(size_t m) const {
+    return candidates_.data() + start_[m];
+  }
+  const uint32_t *end(size_t m) const {
+    return candidates_.data() + start_[m + 1];
+  }
+
+  /**
+   * @brief The smallest gap between the edges of a mobile entity and any
+   * other entity, or `cap` if none is smaller; exactly what
+   * AllPairsClearance() finds. Found among the candidates, found anew first
+   * if they may miss a pair less than `cap` apart, when `cap` is at most
+   * skin/2, and otherwise among all pairs.
+   */
+  double Clearance(const std::vector<ArenaEntity *> &entities,
+                   const std::vector<ArenaMobileEntity *> &mobile,
+                   double cap);
+
+  /**
+   * @brief Make the candidates hold every pair that may touch while each
+   * entity moves up to `reach` from where it is now, found anew first if
+   * need be.
+   *
+   * @return false if no candidates can, i.e. `reach` is more than skin/2
+   * or the broadphase is off.
+   */
+  bool Reach(const std::vector<ArenaEntity *> &entities,
+             const std::vector<ArenaMobileEntity *> &mobile, double reach);
+
+  double get_skin() const { return skin_; }
+
+  /**
+   * @brief Also find every pair less than `margin` apart, as though every
+   * radius were margin/2 larger.
+   */
+  void set_margin(double margin) {
+    margin_ = margin;
+    valid_ = false;
+  }
+
+  /**
+   * @brief This broadphase's BroadphaseKind.
+   */
+  virtual int get_kind() const = 0;
+
+  /**
+   * @brief Number of times the candidates were found anew, and of
+   * Refresh() calls; their ratio is how often the work had to be redone.
+   */
+  uint64_t get_builds() const { return builds_; }
+  uint64_t get_refreshes() const { return refreshes_; }
+
+  /**
+   * @brief The immobile entities, by entity index.
+   */
+  const StaticBvh &get_statics() const { return statics_; }
+
+ protected:
+  /**
+   * @brief Bring the candidates up to date; `reset` if the entities, or
+   * their radii, may have changed since the last call.
+   *
+   * @return Whether the candidates were found anew.
+   */
+  virtual bool Update(const std::vector<ArenaEntity *> &entities,
+                      const std::vector<ArenaMobileEntity *> &mobile,
+                      bool reset) = 0;
+
+  /**
+   * @brief Whether entity `i`, now at `pose`, is less than skin/2 from
+   * where it was at the last Record().
+   */
+  bool Within(uint32_t i, const Pose &pose) const {
+    double dx = pose.x - x_[i];
+    double dy = pose.y - y_[i];
+    return 4 * (dx * dx + dy * dy) < skin_ * skin_;
+  }
+
+  /**
+   * @brief Whether any of `entities` is skin/2 or more from where it was at
+   * the last Record().
+   */
+  bool AnyMoved(const std::vector<ArenaEntity *> &entities) const;
+
+  /**
+   * @brief Copy the entities' poses and radii into x_, y_ and radius_, and
+   * map each mobile entity to its entity index. The immobile entities'
+   * StaticBvh is built again if they are not the same ones as before, and
+   * otherwise refit if any of them moved.
+   */
+  void Record(const std::vector<ArenaEntity *> &entities,
+              const std::vector<ArenaMobileEntity *> &mobile);
+
+  /**
+   * @brief Replace every candidate list with `pairs` of (mobile entity,
+   * entity index of another mobile entity), in any order, and the immobile
+   * entities each mobile entity finds in the StaticBvh.
+   */
+  void SetCandidates(std::vector<std::pair<uint32_t, uint32_t>> *pairs);
+
+  double skin_;
+  double margin_;
+  // Every entity's pose and radius (plus margin_/2) at the last Record().
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> radius_;
+  // Mobile entity -> entity index, and entity index -> mobile entity, or
+  // kNotMobile.
+  std::vector<uint32_t> index_;
+  std::vector<uint32_t> mobile_of_;
+  static const uint32_t kNotMobile = UINT32_MAX;
+
+ private:
+  bool valid_;
+  StaticBvh statics_;
+  std::vector<uint32_t> static_ids_;
+  std::vector<uint32_t> found_;
+  // Mobile entity m's candidates are candidates_[start_[m], start_[m + 1]).
+  std::vector<uint32_t> start_;
+  std::vector<uint32_t> candidates_;
+  uint64_t builds_;
+  uint64_t refreshes_;
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief A new broadphase of `kind` (a BroadphaseKind) with `skin`, or
+ * nullptr for kBroadphaseAllPairs.
+ */
+Broadphase *CreateBroadphase(int kind, double skin);
+
+/**
+ * @brief The smallest gap between the edges of a mobile entity and any
+ * other entity, or `cap` if none is smaller, testing every pair. `mobile`
+ * must be the mobile subset of `entities`.
+ */
+double AllPairsClearance(const std::vector<ArenaEntity *> &entities,
+                         const std::vector<ArenaMobileEntity *> &mobile,
+                         double cap);
+
+/**
+ * @brief The name of broadphase `kind` in scenario files, e.g.
+ * "sweep_and_prune".
+ */
+const char *BroadphaseName(int kind);
+
+/**
+ * @brief Parse a BroadphaseName() into `kind`; false if it names none.
+ */
+bool ParseBroadphase(const std::string &name, int *kind);
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_BROADPHASE_H_
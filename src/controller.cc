@@ -8,6 +8,9 @@
  * Includes
  ******************************************************************************/
 #include <nanogui/nanogui.h>
+#include <algorithm>
+#include <ctime>
+#include <iostream>
 #include <string>
 
 #include "src/arena_params.h"
@@ -19,26 +22,39 @@
  ******************************************************************************/
 NAMESPACE_BEGIN(csci3081);
 
-Controller::Controller() : last_dt(0) {
-  // Initialize default properties for various arena entities
-  arena_params aparams;
-  aparams.n_lights = N_LIGHTS;
-  aparams.x_dim = ARENA_X_DIM;
-  aparams.y_dim = ARENA_Y_DIM;
-
+Controller::Controller(const arena_params &aparams,
+                       const std::string &replay_path,
+                       const std::string &session_path)
+    : last_dt(0), max_steps_(aparams.max_steps), session_path_(session_path) {
   arena_ = new Arena(&aparams);
+  // Seeding explicitly lets the session be re-executed from its log.
+  uint64_t seed = aparams.seed != 0 ? aparams.seed
+                                    : static_cast<uint64_t>(time(nullptr));
+  arena_->Seed(seed);
+  if (!session_path_.empty()) {
+    session_log_.Start(seed, aparams.x_dim, aparams.y_dim);
+    arena_->set_session_log(&session_log_);
+  }
 
   // Start up the graphics (which creates the arena).
   // Run() will enter the nanogui::mainloop().
-  viewer_ = new GraphicsArenaViewer(&aparams, arena_, this);
+  viewer_ = new GraphicsArenaViewer(&aparams, arena_, this, replay_path);
 }
 
-void Controller::Run() { viewer_->Run(); }
+void Controller::Run() {
+  viewer_->Run();
+  if (!session_path_.empty()) {
+    session_log_.Finish(arena_->get_step());
+    if (!session_log_.Save(session_path_)) {
+      std::cerr << "Cannot write session log " << session_path_ << std::endl;
+    }
+  }
+}
 
-void Controller::AdvanceTime(double dt) {
+uint32_t Controller::AdvanceTime(double dt) {
   if ((last_dt + dt) <= .05) {
     last_dt += dt;
-    return;
+    return 0;
   }
   // Checking game status before advancing time in the arena
   if ( arena_->get_game_status() == LOST ) {
@@ -46,11 +62,27 @@ void Controller::AdvanceTime(double dt) {
     // deal with the situation accordingly
   }
 
+  // One timestep per .05 seconds passed, within the viewer's limit.
+  uint32_t steps = std::min(
+      std::max(static_cast<uint32_t>((last_dt + dt) / .05), 1u),
+      std::max(max_substeps_, 1u));
   last_dt = 0;
-  arena_->AdvanceTime(dt);
+  for (uint32_t s = 0; s < steps; ++s) {
+    // A scenario's step budget ends the game like a loss does.
+    if (max_steps_ > 0 && steps_run_ >= max_steps_) {
+      viewer_ -> GameOver();
+      return s;
+    }
+    arena_->AdvanceTime(dt);
+    ++steps_run_;
+  }
+  return steps;
 }
 
 void Controller::AcceptCommunication(Communication com) {
+  if (com == kNewGame) {
+    steps_run_ = 0;
+  }
   arena_->AcceptCommand(ConvertComm(com));
 }
 
@@ -14,6 +14,7 @@
 #include <string>
 
 #include "src/arena.h"
+#include "src/arena_params.h"
 #include "src/common.h"
 #include "src/communication.h"
 #include "src/graphics_arena_viewer.h"
@@ -45,12 +46,26 @@ class Controller {
  public:
   /**
    * @brief Controller's constructor that will create Arena and Viewer.
+   *
+   * @param[in] aparams The arena's size and starting configuration, e.g.
+   * read from a scenario file. A non-zero seed makes the run reproducible
+   * and a non-zero max_steps ends each game after that many steps.
+   * @param[in] replay_path A trajectory file for the viewer to replay
+   * instead of running the simulation, or empty.
+   * @param[in] session_path Where to save the session's input log (see
+   * SessionLog) when the viewer is closed, or empty.
    */
-  Controller();
+  explicit Controller(const arena_params &aparams = arena_params(),
+                      const std::string &replay_path = "",
+                      const std::string &session_path = "");
+
+  Controller(const Controller &other) = delete;
+  Controller &operator=(const Controller &other) = delete;
 
 
   /**
-   * @brief Run launches the graphics and starts the game.
+   * @brief Run launches the graphics and starts the game. Returns once the
+   * window is closed, after saving the session log if one was requested.
    */
   void Run();
 
@@ -59,8 +74,17 @@ class Controller {
    * simulation.
    *
    * @param[in] dt The time period to advance the simulation by.
+   *
+   * @return The number of timesteps run, 0 while the time for the next one
+   * adds up.
+   */
+  uint32_t AdvanceTime(double dt);
+
+  /**
+   * @brief The most timesteps one AdvanceTime() call runs to catch up with
+   * the time that has passed (at least 1); the rest of the time is dropped.
    */
-  void AdvanceTime(double dt);
+  void set_max_substeps(uint32_t steps) { max_substeps_ = steps; }
 
   /**
    * @brief AcceptCommunication from either the viewer or the Arena
@@ -83,8 +107,14 @@ class Controller {
 
  private:
   double last_dt{0};
+  // Steps since the current game started, and the game's step budget.
+  uint32_t steps_run_{0};
+  uint32_t max_steps_{0};
+  uint32_t max_substeps_{1};
   Arena* arena_{nullptr};
   GraphicsArenaViewer* viewer_{nullptr};
+  std::string session_path_;
+  SessionLog session_log_{};
 };
 
 NAMESPACE_END(csci3081);
@@ -7,6 +7,7 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <algorithm>
 #include <string>
 #include <ctime>
 #include <iostream>
@@ -27,9 +28,7 @@ NAMESPACE_BEGIN(csci3081);
  * Class Definitions
  ******************************************************************************/
 
-EntityFactory::EntityFactory() {
-  srand(time(nullptr));
-}
+EntityFactory::EntityFactory() {}
 
 void EntityFactory::Reset() {
   entity_count_ = 0;
@@ -38,6 +37,16 @@ void EntityFactory::Reset() {
   food_count_ = 0;
   robot_light_behavior_flag_ = 1;
 }
+
+void EntityFactory::RestoreCounters(int entity_count, int robot_count,
+                                    int light_count, int food_count,
+                                    int robot_light_behavior_flag) {
+  entity_count_ = entity_count;
+  robot_count_ = robot_count;
+  light_count_ = light_count;
+  food_count_ = food_count;
+  robot_light_behavior_flag_ = robot_light_behavior_flag;
+}
 ArenaEntity* EntityFactory::CreateEntity(EntityType etype) {
   switch (etype) {
     case (kRobot):
@@ -58,6 +67,7 @@ ArenaEntity* EntityFactory::CreateEntity(EntityType etype) {
 
 Robot* EntityFactory::CreateRobot() {
   auto* robot = new Robot(robot_light_behavior_flag_);
+  robot->set_random_generator(&rng_);
   robot->set_type(kRobot);
   robot->set_color(ROBOT_COLOR);
   robot->set_pose(ROBOT_INIT_POS);
@@ -72,6 +82,7 @@ Robot* EntityFactory::CreateRobot() {
 
 Light* EntityFactory::CreateLight() {
   auto* light = new Light;
+  light->set_random_generator(&rng_);
   light->set_type(kLight);
   light->set_color(LIGHT_COLOR);
   light->set_pose(SetPoseRandomly());
@@ -84,6 +95,7 @@ Light* EntityFactory::CreateLight() {
 
 Food* EntityFactory::CreateFood() {
   auto* food = new Food;
+  food->set_random_generator(&rng_);
   food->set_type(kFood);
   food->set_color(FOOD_COLOR);
   food->set_pose(SetPoseRandomly());
@@ -94,21 +106,27 @@ Food* EntityFactory::CreateFood() {
   return food;
 }
 
+void EntityFactory::set_arena_size(uint x_dim, uint y_dim) {
+  // One square of margin, e.g. 19x14 squares for the 1024x768 arena.
+  grid_x_ = std::max(x_dim / 50, 2u) - 1;
+  grid_y_ = std::max(y_dim / 50, 2u) - 1;
+}
+
 Pose EntityFactory::SetPoseRandomly() {
-  // Dividing arena into 19x14 grid. Each grid square is 50x50
-  return {static_cast<double>((30 + (random() % 19) * 50)),
-        static_cast<double>((30 + (random() % 14) * 50))};
+  // Dividing arena into a grid (19x14 by default). Each grid square is 50x50
+  return {static_cast<double>((30 + (rng_.Next() % grid_x_) * 50)),
+        static_cast<double>((30 + (rng_.Next() % grid_y_) * 50))};
 }
 
 double EntityFactory::SetRadiusRandomlyLight() {
   // Returning the radius randomly.
-  return static_cast<double>  (random() %
+  return static_cast<double>  (rng_.Next() %
   (LIGHT_MAX_RADIUS + 1 - LIGHT_MIN_RADIUS) + LIGHT_MIN_RADIUS);
 }
 
 double EntityFactory::SetRadiusRandomlyRobot() {
   // returning a number between 8 and 14
-  return static_cast<int> (8+(random()%(14-8+1)));
+  return static_cast<int> (8+(rng_.Next()%(14-8+1)));
 }
 
 NAMESPACE_END(csci3081);
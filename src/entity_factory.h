@@ -18,6 +18,7 @@
 #include "src/light.h"
 #include "src/params.h"
 #include "src/pose.h"
+#include "src/random_generator.h"
 #include "src/rgb_color.h"
 #include "src/robot.h"
 
@@ -70,6 +71,34 @@ class EntityFactory {
   */
   void Reset();
 
+  /**
+  * @brief The random stream shared by the factory and every entity it
+  * creates. Seeded from the clock on construction.
+  */
+  RandomGenerator *get_random_generator() { return &rng_; }
+
+  int get_entity_count() const { return entity_count_; }
+  int get_robot_count() const { return robot_count_; }
+  int get_light_count() const { return light_count_; }
+  int get_food_count() const { return food_count_; }
+  int get_robot_light_behavior_flag() const {
+    return robot_light_behavior_flag_;
+  }
+
+  /**
+  * @brief Restore the creation counters, e.g. when loading a snapshot, so
+  * that entities created afterwards get the same ids and behaviors they
+  * would have had in the original run.
+  */
+  void RestoreCounters(int entity_count, int robot_count, int light_count,
+                       int food_count, int robot_light_behavior_flag);
+
+  /**
+  * @brief Size of the arena new entities are placed in. The placement grid
+  * of 50x50 squares grows with it; the default is the 1024x768 GUI arena.
+  */
+  void set_arena_size(uint x_dim, uint y_dim);
+
  private:
    /**
    * @brief CreateRobot called from within CreateEntity.
@@ -110,6 +139,10 @@ class EntityFactory {
   * behavior
   */
   int robot_light_behavior_flag_{1};
+  /* Number of placement grid squares across and down the arena */
+  uint grid_x_{19};
+  uint grid_y_{14};
+  RandomGenerator rng_{};
 };
 
 NAMESPACE_END(csci3081);
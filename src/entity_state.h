@@ -0,0 +1,77 @@
+/**
+ * @file entity_state.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_ENTITY_STATE_H_
+#define SRC_ENTITY_STATE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+/**
+ * @brief Bits of EntityState::flags.
+ */
+enum EntityStateFlag {
+  kStateMobile = 1 << 0,
+  kStateArcing = 1 << 1,
+  kStateHungry = 1 << 2,
+  kStateReallyHungry = 1 << 3,
+  kStateCaptured = 1 << 4
+};
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Plain-old-data copy of everything that defines one entity between
+ * two timesteps.
+ *
+ * Every entity type fills the same fixed-size record (fields that do not
+ * apply stay zero), so a whole Arena can be captured as one flat array. This
+ * is the unit of Arena snapshots and clones.
+ */
+struct EntityState {
+  int32_t type{0};
+  int32_t id{-1};
+  uint32_t flags{0};
+  double x{0};
+  double y{0};
+  double theta{0};
+  double radius{0};
+  uint8_t color_r{0};
+  uint8_t color_g{0};
+  uint8_t color_b{0};
+  double vel_left{0};
+  double vel_right{0};
+  // Robot only.
+  int32_t lives{0};
+  // Simulated time since the robot last ate.
+  double time_counter{0};
+  // Simulated time spent arcing.
+  double collision_timer{0};
+  int32_t behavior_flag{0};
+  int32_t food_on_off{0};
+  float light_base{0};
+  double left_light_reading{0};
+  double right_light_reading{0};
+  double left_food_reading{0};
+  double right_food_reading{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_ENTITY_STATE_H_
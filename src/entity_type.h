@@ -10,6 +10,8 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <cstdint>
+
 #include "src/common.h"
 
 /*******************************************************************************
@@ -29,6 +31,27 @@ enum EntityType {
   kUndefined
 };
 
+/**
+ * @brief The bit for `wall` (kRightWall to kBottomWall) in a mask of the
+ * walls an entity touches at once, e.g. two in a corner.
+ */
+inline uint8_t WallBit(EntityType wall) {
+  return static_cast<uint8_t>(1u << (wall - kRightWall));
+}
+
+/**
+ * @brief The first wall, in EntityType order, in a mask of WallBit()s;
+ * kUndefined if there is none.
+ */
+inline EntityType FirstWall(uint8_t walls) {
+  for (int wall = kRightWall; wall <= kBottomWall; ++wall) {
+    if (walls & WallBit(static_cast<EntityType>(wall))) {
+      return static_cast<EntityType>(wall);
+    }
+  }
+  return kUndefined;
+}
+
 NAMESPACE_END(csci3081);
 
 #endif  // SRC_ENTITY_TYPE_H_
@@ -36,4 +36,14 @@ void Food::Reset() {
   set_captured(false);
 } /* Reset */
 
+void Food::SaveState(EntityState *state) const {
+  ArenaImmobileEntity::SaveState(state);
+  if (captured_) state->flags |= kStateCaptured;
+}
+
+void Food::LoadState(const EntityState &state) {
+  ArenaImmobileEntity::LoadState(state);
+  captured_ = (state.flags & kStateCaptured) != 0;
+}
+
 NAMESPACE_END(csci3081);
@@ -47,6 +47,16 @@ class Food : public ArenaImmobileEntity {
    */
   void Reset() override;
 
+  /**
+   * @brief Add the captured state to the base entity record.
+   */
+  void SaveState(EntityState *state) const override;
+
+  /**
+   * @brief Restore everything written by SaveState().
+   */
+  void LoadState(const EntityState &state) override;
+
   /**
    * @brief Get the name of the Food for visualization purposes, and to
    * aid in debugging.
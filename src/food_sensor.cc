@@ -31,7 +31,7 @@ void FoodSensor::CalculateSensorReading(Pose location_entity) {
   double distance_x_ = pow(get_sensor_position().x - location_entity.x, 2);
   double distance_y_ = pow(get_sensor_position().y - location_entity.y, 2);
   double distance_ = pow(distance_x_ + distance_y_, 0.5) - FOOD_RADIUS;
-  reading_ += 1200/(pow(1.08, distance_));
+  reading_ += 1200/(pow(FOOD_BASE_VALUE, distance_));
   set_sensor_reading(reading_);
   if (reading_ > 1000)
     set_sensor_reading(1000);
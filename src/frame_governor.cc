@@ -0,0 +1,98 @@
+/**
+ * @file frame_governor.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/frame_governor.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+// What each quality level runs and draws, from full quality down.
+struct FrameQuality {
+  uint32_t sense_interval;
+  uint32_t max_substeps;
+  bool labels;
+  bool sensors;
+};
+static const FrameQuality kQuality[] = {
+  {1, 4, true, true},
+  {1, 2, false, true},
+  {1, 2, false, false},
+  {2, 1, false, false},
+  {4, 1, false, false},
+  {8, 1, false, false},
+};
+static const int kMaxLevel = sizeof(kQuality) / sizeof(kQuality[0]) - 1;
+
+// Weight of the latest frame in the smoothed frame time.
+static const double kSmoothing = 0.2;
+// Frames to wait after a change before changing level again.
+static const int kSettleFrames = 10;
+// A level is won back after this many frames in a row under this share of
+// the budget.
+static const int kRecoverFrames = 60;
+static const double kRecoverShare = 0.6;
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+FrameGovernor::FrameGovernor(double budget_ms)
+    : budget_ms_(budget_ms), frame_ms_(-1), level_(0), settled_(0),
+      under_(0) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+int FrameGovernor::get_max_level() { return kMaxLevel; }
+
+bool FrameGovernor::Update(uint32_t steps, double step_ms, double draw_ms) {
+  if (steps == 0) {
+    return false;
+  }
+  double frame = step_ms + draw_ms;
+  frame_ms_ += frame_ms_ < 0 ? frame - frame_ms_
+                             : kSmoothing * (frame - frame_ms_);
+  if (!(budget_ms_ > 0)) {
+    return false;
+  }
+  ++settled_;
+  under_ = frame_ms_ < kRecoverShare * budget_ms_ ? under_ + 1 : 0;
+  int level = level_;
+  if (settled_ >= kSettleFrames && frame_ms_ > budget_ms_ &&
+      level_ < kMaxLevel) {
+    ++level;
+  } else if (under_ >= kRecoverFrames && level_ > 0) {
+    --level;
+  }
+  if (level == level_) {
+    return false;
+  }
+  level_ = level;
+  settled_ = 0;
+  under_ = 0;
+  return true;
+}
+
+uint32_t FrameGovernor::sense_interval() const {
+  return kQuality[level_].sense_interval;
+}
+
+uint32_t FrameGovernor::max_substeps() const {
+  return kQuality[level_].max_substeps;
+}
+
+bool FrameGovernor::draw_labels() const { return kQuality[level_].labels; }
+
+bool FrameGovernor::draw_sensors() const { return kQuality[level_].sensors; }
+
+NAMESPACE_END(csci3081);
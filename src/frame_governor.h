@@ -0,0 +1,98 @@
+/**
+ * @file frame_governor.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_FRAME_GOVERNOR_H_
+#define SRC_FRAME_GOVERNOR_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Holds the viewer's frames within a time budget by trading away
+ * quality as the arena grows, and winning it back as the arena shrinks.
+ *
+ * Fed each frame's measured step and draw times, the governor keeps a
+ * smoothed time of the frames that ran steps, and moves between quality levels, from 0 (full
+ * quality) to get_max_level(). Each level down first stops drawing the
+ * entities' name labels and catching up on more than a couple of steps per
+ * frame, then stops drawing the robots' sensors, then has the robots sense
+ * in full only every 2, 4 and 8 steps (see SenseDecimation), and runs only
+ * one step per frame.
+ *
+ * A level is given up as soon as the smoothed frame time is over budget,
+ * and won back only once it has stayed well under budget for a while, so
+ * that the level does not flicker between two neighbours. After each change
+ * the governor waits for the smoothed time to reflect the new level.
+ */
+class FrameGovernor {
+ public:
+  /**
+   * @param budget_ms The frame time to stay within, in milliseconds; 0
+   * keeps full quality.
+   */
+  explicit FrameGovernor(double budget_ms = 16);
+
+  /**
+   * @brief Account for one frame that ran `steps` steps of the simulation
+   * in `step_ms`, and took `draw_ms` to draw.
+   *
+   * Most frames run no step while the time for the next one adds up; they
+   * are left out, or their short times would hide how long the frames
+   * that do step take.
+   *
+   * @return true if the quality level changed.
+   */
+  bool Update(uint32_t steps, double step_ms, double draw_ms);
+
+  int get_level() const { return level_; }
+  static int get_max_level();
+  double get_budget_ms() const { return budget_ms_; }
+  // The smoothed time of the frames that ran steps, in milliseconds.
+  double get_frame_ms() const { return frame_ms_; }
+
+  /**
+   * @brief The steps between the robots' full sensings at this level.
+   */
+  uint32_t sense_interval() const;
+
+  /**
+   * @brief The most steps to run in one frame to catch up with the time
+   * that passed, at this level.
+   */
+  uint32_t max_substeps() const;
+
+  /**
+   * @brief Whether to draw the entities' name labels and the robots'
+   * sensors at this level.
+   */
+  bool draw_labels() const;
+  bool draw_sensors() const;
+
+ private:
+  double budget_ms_;
+  double frame_ms_;
+  int level_;
+  // Frames since the level last changed.
+  int settled_;
+  // Frames in a row the smoothed time has been well under budget.
+  int under_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_FRAME_GOVERNOR_H_
@@ -7,6 +7,11 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
 #include <vector>
 #include <iostream>
 #include <string>
@@ -21,24 +26,45 @@
  ******************************************************************************/
 NAMESPACE_BEGIN(csci3081);
 
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+// Steps per second of the live simulation (see Controller::AdvanceTime()),
+// i.e. the replay rate at speed 1x.
+static const double kReplayStepsPerSecond = 20.0;
+// The speed slider covers -kReplayMaxSpeed..kReplayMaxSpeed.
+static const double kReplayMaxSpeed = 8.0;
+
+/*******************************************************************************
+ * Static Functions
+ ******************************************************************************/
+// Milliseconds from `start` until now.
+static double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count();
+}
+
 /*******************************************************************************
  * Constructors/Destructor
  ******************************************************************************/
 GraphicsArenaViewer::GraphicsArenaViewer(
     const struct arena_params *const params,
-    Arena * arena, Controller * controller) :
+    Arena * arena, Controller * controller,
+    const std::string &replay_path) :
     GraphicsApp(
     params->x_dim + GUI_MENU_WIDTH + GUI_MENU_GAP * 2,
     params->y_dim,
     "Robot Simulation"),
 controller_(controller),
 arena_(arena),
-robot_count_(5),
-light_count_(0),
-food_count_(0),
-fear_count_(0),
-light_sensitivity_(0.0f),
-food_on_off_(0) {
+robot_count_(static_cast<int>(params->n_robots)),
+light_count_(static_cast<int>(params->n_lights)),
+food_count_(static_cast<int>(params->n_food)),
+fear_count_(static_cast<int>(params->fear_count)),
+light_sensitivity_(params->light_sensitivity),
+food_on_off_(params->food_on),
+governor_(params->frame_budget_ms),
+sense_interval_(params->sense_interval) {
 auto *gui = new nanogui::FormHelper(screen());
 nanogui::ref<nanogui::Window> window =
   gui->addWindow(
@@ -46,6 +72,19 @@ nanogui::ref<nanogui::Window> window =
       "Menu");
 
 window->setLayout(new nanogui::GroupLayout());
+
+// Replay mode has its own controls and never touches the Arena.
+if (!replay_path.empty()) {
+  if (replay_.Open(replay_path) && replay_.get_step_count() > 0) {
+    replaying_ = true;
+    AddReplayControls(gui, window);
+    SeekReplay(replay_.get_first_step());
+    screen()->performLayout();
+    return;
+  }
+  std::cerr << "Cannot replay " << replay_path
+            << "; running the simulation instead." << std::endl;
+}
 gui->addGroup("Simulation Control");
 
 playing_button_ =
@@ -71,6 +110,7 @@ DrawFoodOnOffSlider(window);
 DrawFearSlider(window);
 DrawLightSensorSlider(window);
 screen()->performLayout();
+ApplyQuality();
 }
 
 /*******************************************************************************
@@ -80,11 +120,25 @@ screen()->performLayout();
 // This is the primary driver for state change in the arena.
 // It will be called at each iteration of nanogui::mainloop()
 void GraphicsArenaViewer::UpdateSimulation(double dt) {
+  if (replaying_) {
+    UpdateReplay(dt);
+    return;
+  }
   if (!paused_) {
-    controller_->AdvanceTime(dt);
+    auto start = std::chrono::steady_clock::now();
+    uint32_t steps = controller_->AdvanceTime(dt);
+    if (governor_.Update(steps, MillisecondsSince(start), draw_ms_)) {
+      ApplyQuality();
+    }
   }
 }
 
+void GraphicsArenaViewer::ApplyQuality() {
+  arena_->set_sense_interval(
+      std::max(sense_interval_, governor_.sense_interval()));
+  controller_->set_max_substeps(governor_.max_substeps());
+}
+
 // Function to deal with the situation once the game is over
 void GraphicsArenaViewer::GameOver() {
   game_result_ = true;  // setting the flag true because we have a result
@@ -158,6 +212,20 @@ void GraphicsArenaViewer::OnPlayingBtnPressed() {
  */
 void GraphicsArenaViewer::OnSpecialKeyDown(int key,
   __unused int scancode, __unused int modifiers) {
+    if (replaying_) {
+      switch (key) {
+        case GLFW_KEY_LEFT: SeekReplay(std::round(replay_step_) - 1);
+          break;
+        case GLFW_KEY_RIGHT: SeekReplay(std::round(replay_step_) + 1);
+          break;
+        case GLFW_KEY_UP: SetReplaySpeed(replay_speed_ + 1);
+          break;
+        case GLFW_KEY_DOWN: SetReplaySpeed(replay_speed_ - 1);
+          break;
+        default: {}
+      }
+      return;
+    }
     Communication key_value = kNone;
     switch (key) {
       case GLFW_KEY_LEFT: key_value = kKeyLeft;
@@ -181,58 +249,60 @@ void GraphicsArenaViewer::OnSpecialKeyDown(int key,
  ******************************************************************************/
 void GraphicsArenaViewer::DrawRobot(NVGcontext *ctx,
                                       const Robot *const robot) {
+  DrawRobot(ctx, robot->get_pose(), robot->get_radius(), robot->get_color(),
+            robot->get_behavior_flag());
+}
+
+void GraphicsArenaViewer::DrawRobot(NVGcontext *ctx, const Pose &pose,
+                                    double radius, const RgbColor &color,
+                                    int behavior_flag) {
   // translate and rotate all graphics calls that follow so that they are
   // centered, at the position and heading of this robot
   nvgSave(ctx);
   nvgTranslate(ctx,
-              static_cast<float>(robot->get_pose().x),
-              static_cast<float>(robot->get_pose().y));
+              static_cast<float>(pose.x),
+              static_cast<float>(pose.y));
   nvgRotate(ctx,
-              static_cast<float>(robot->get_pose().theta * M_PI / 180.0));
+              static_cast<float>(pose.theta * M_PI / 180.0));
 
   // robot's circle
   nvgBeginPath(ctx);
-  nvgCircle(ctx, 0.0, 0.0, static_cast<float>(robot->get_radius()));
+  nvgCircle(ctx, 0.0, 0.0, static_cast<float>(radius));
   nvgFillColor(ctx,
-             nvgRGBA(robot->get_color().r, robot->get_color().g,
-                    robot->get_color().b, 255));
+             nvgRGBA(color.r, color.g, color.b, 255));
   nvgFill(ctx);
   nvgStrokeColor(ctx, nvgRGBA(0, 0, 0, 255));
   nvgStroke(ctx);
 
   // robot id text label
-  nvgSave(ctx);
-  nvgRotate(ctx, static_cast<float>(M_PI / 2.0));
-  nvgFillColor(ctx, nvgRGBA(0, 0, 0, 255));
-  std::string r_ = "Robot:" + std::to_string(robot->get_behavior_flag());
-  nvgText(ctx, 0.0, 4.0, r_.c_str(), nullptr);
-  // nvgText(ctx, 0.0, 10.0, robot->get_lives(), nullptr);
-  nvgRestore(ctx);
+  if (governor_.draw_labels()) {
+    nvgSave(ctx);
+    nvgRotate(ctx, static_cast<float>(M_PI / 2.0));
+    nvgFillColor(ctx, nvgRGBA(0, 0, 0, 255));
+    std::string r_ = "Robot:" + std::to_string(behavior_flag);
+    nvgText(ctx, 0.0, 4.0, r_.c_str(), nullptr);
+    // nvgText(ctx, 0.0, 10.0, robot->get_lives(), nullptr);
+    nvgRestore(ctx);
+  }
   nvgRestore(ctx);
 
-  // Robot's left Light and Food Sensor
-  nvgBeginPath(ctx);
-  nvgCircle(ctx,
-            static_cast<float>(robot->PoseLeftSensor().x),
-            static_cast<float>(robot->PoseLeftSensor().y),
-            static_cast<float>(4.0));
-  nvgFillColor(ctx,
-              nvgRGBA(255, 255, 255, 255));
-  nvgFill(ctx);
-  nvgStrokeColor(ctx, nvgRGBA(0, 0, 0, 255));
-  nvgStroke(ctx);
-
-  // Robot's right Light and Food Sensor
-  nvgBeginPath(ctx);
-  nvgCircle(ctx,
-            static_cast<float>(robot->PoseRightSensor().x),
-            static_cast<float>(robot->PoseRightSensor().y),
-            static_cast<float>(4.0));
-  nvgFillColor(ctx,
-              nvgRGBA(255, 255, 255, 255));
-  nvgFill(ctx);
-  nvgStrokeColor(ctx, nvgRGBA(0, 0, 0, 255));
-  nvgStroke(ctx);
+  // Robot's left and right Light and Food Sensors
+  if (!governor_.draw_sensors()) {
+    return;
+  }
+  for (double offset : {-40.0*M_PI/180.0, 40.0*M_PI/180.0}) {
+    Pose sensor = Robot::SensorPose(pose, radius, offset);
+    nvgBeginPath(ctx);
+    nvgCircle(ctx,
+              static_cast<float>(sensor.x),
+              static_cast<float>(sensor.y),
+              static_cast<float>(4.0));
+    nvgFillColor(ctx,
+                nvgRGBA(255, 255, 255, 255));
+    nvgFill(ctx);
+    nvgStrokeColor(ctx, nvgRGBA(0, 0, 0, 255));
+    nvgStroke(ctx);
+  }
 }
 
 
@@ -246,32 +316,79 @@ void GraphicsArenaViewer::DrawArena(NVGcontext *ctx) {
 
 void GraphicsArenaViewer::DrawEntity(NVGcontext *ctx,
                                         const ArenaEntity *const entity) {
+  DrawEntity(ctx, entity->get_pose(), entity->get_radius(),
+             entity->get_color(), entity->get_name());
+}
+
+void GraphicsArenaViewer::DrawEntity(NVGcontext *ctx, const Pose &pose,
+                                     double radius, const RgbColor &color,
+                                     const std::string &name) {
   // light's circle
   nvgBeginPath(ctx);
   nvgCircle(ctx,
-            static_cast<float>(entity->get_pose().x),
-            static_cast<float>(entity->get_pose().y),
-            static_cast<float>(entity->get_radius()));
+            static_cast<float>(pose.x),
+            static_cast<float>(pose.y),
+            static_cast<float>(radius));
   nvgFillColor(ctx,
-              nvgRGBA(entity->get_color().r, entity->get_color().g,
-                        entity->get_color().b, 255));
+              nvgRGBA(color.r, color.g, color.b, 255));
   nvgFill(ctx);
   nvgStrokeColor(ctx, nvgRGBA(0, 0, 0, 255));
   nvgStroke(ctx);
 
   // light id text label
+  if (!governor_.draw_labels()) {
+    return;
+  }
   nvgFillColor(ctx, nvgRGBA(0, 0, 0, 255));
   nvgText(ctx,
-          static_cast<float>(entity->get_pose().x),
-          static_cast<float>(entity->get_pose().y),
-          entity->get_name().c_str(), nullptr);
+          static_cast<float>(pose.x),
+          static_cast<float>(pose.y),
+          name.c_str(), nullptr);
+}
+
+void GraphicsArenaViewer::DrawReplayFrame(NVGcontext *ctx) {
+  TrajectoryFrame frame;
+  if (!replay_.ReadStep(static_cast<uint32_t>(std::lround(replay_step_)),
+                        &frame)) {
+    return;
+  }
+  // Same order as the live view: everything else first, robots on top.
+  for (int pass = 0; pass < 2; ++pass) {
+    for (uint32_t r = 0; r < frame.rows; ++r) {
+      int type = frame.Get<uint8_t>(kColType, r);
+      if ((type == kRobot) != (pass == 1)) {
+        continue;
+      }
+      Pose pose(frame.Get<double>(kColX, r), frame.Get<double>(kColY, r),
+                frame.Get<double>(kColTheta, r));
+      double radius = frame.Get<float>(kColRadius, r);
+      RgbColor color(frame.Get<uint8_t>(kColColorR, r),
+                     frame.Get<uint8_t>(kColColorG, r),
+                     frame.Get<uint8_t>(kColColorB, r));
+      if (type == kRobot) {
+        DrawRobot(ctx, pose, radius, color,
+                  frame.Get<uint8_t>(kColBehavior, r));
+      } else if (type == kLight) {
+        DrawEntity(ctx, pose, radius, color,
+                   "Light" + std::to_string(frame.Get<int32_t>(kColId, r)));
+      } else {
+        DrawEntity(ctx, pose, radius, color, "Food");
+      }
+    }
+  }
 }
+
 void GraphicsArenaViewer::DrawUsingNanoVG(NVGcontext *ctx) {
   // initialize text rendering settings
   nvgFontSize(ctx, 18.0f);
   nvgFontFace(ctx, "sans-bold");
   nvgTextAlign(ctx, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
   DrawArena(ctx);
+  if (replaying_) {
+    DrawReplayFrame(ctx);
+    return;
+  }
+  auto start = std::chrono::steady_clock::now();
   std::vector<class ArenaEntity *> entities_ = arena_->get_entities();
   for (auto &entity : entities_) {
     if (entity->get_type() != kRobot)
@@ -281,6 +398,23 @@ void GraphicsArenaViewer::DrawUsingNanoVG(NVGcontext *ctx) {
   for (auto &robot : robots_) {
     DrawRobot(ctx, robot); /* for(i..) */
   }
+  draw_ms_ = MillisecondsSince(start);
+  DrawQuality(ctx);
+}
+
+void GraphicsArenaViewer::DrawQuality(NVGcontext *ctx) {
+  std::ostringstream text;
+  text << "Quality " << governor_.get_max_level() - governor_.get_level()
+       << "/" << governor_.get_max_level();
+  if (governor_.get_frame_ms() >= 0) {
+    text << std::fixed << std::setprecision(1) << "  "
+         << governor_.get_frame_ms() << " ms";
+  }
+  nvgSave(ctx);
+  nvgTextAlign(ctx, NVG_ALIGN_LEFT | NVG_ALIGN_TOP);
+  nvgFillColor(ctx, nvgRGBA(255, 255, 255, 255));
+  nvgText(ctx, 8.0f, 8.0f, text.str().c_str(), nullptr);
+  nvgRestore(ctx);
 }
 // Function for drawing the number of robots slider
 void GraphicsArenaViewer::DrawRobotSlider(nanogui::ref<nanogui::Window>
@@ -289,15 +423,16 @@ void GraphicsArenaViewer::DrawRobotSlider(nanogui::ref<nanogui::Window>
   new nanogui::Label(panel, "Number of Robots", "sans-bold");
   nanogui::Slider *slider = new nanogui::Slider(panel);
   // The starting value (range is from 0 to 1)
-  // Note that below the displayed value is 10* slider value.
-  slider->setValue(0.5f);
+  // Note that below the displayed value is 10* slider value. A scenario may
+  // start beyond the slider's range; the textbox shows the actual count.
+  slider->setValue(std::min(robot_count_ / 10.0f, 1.0f));
   slider->setFixedWidth(100);
 
   // Display the corresponding value of the slider in this textbox
   nanogui::TextBox *textBox = new nanogui::TextBox(panel);
   textBox->setFixedSize(nanogui::Vector2i(60, 25));
   textBox->setFontSize(20);
-  textBox->setValue("5");
+  textBox->setValue(std::to_string(robot_count_));
 
   // This is the lambda function called while the user is moving the slider
   slider->setCallback(
@@ -322,14 +457,14 @@ void GraphicsArenaViewer::DrawLightSlider(nanogui::ref<nanogui::Window>
   nanogui::Slider *slider = new nanogui::Slider(panel);
   // The starting value (range is from 0 to 1)
   // Note that below the displayed value is 5* slider value.
-  slider->setValue(0.0f);
+  slider->setValue(std::min(light_count_ / 5.0f, 1.0f));
   slider->setFixedWidth(100);
 
   // Display the corresponding value of the slider in this textbox
   nanogui::TextBox *textBox = new nanogui::TextBox(panel);
   textBox->setFixedSize(nanogui::Vector2i(60, 25));
   textBox->setFontSize(20);
-  textBox->setValue("0");
+  textBox->setValue(std::to_string(light_count_));
 
   // This is the lambda function called while the user is moving the slider
   slider->setCallback(
@@ -353,14 +488,14 @@ void GraphicsArenaViewer::DrawFoodSlider(nanogui::ref<nanogui::Window>
   nanogui::Slider *slider = new nanogui::Slider(panel);
   // The starting value (range is from 0 to 1)
   // Note that below the displayed value is 5* slider value.
-  slider->setValue(0.0f);
+  slider->setValue(std::min(food_count_ / 5.0f, 1.0f));
   slider->setFixedWidth(100);
 
   // Display the corresponding value of the slider in this textbox
   nanogui::TextBox *textBox = new nanogui::TextBox(panel);
   textBox->setFixedSize(nanogui::Vector2i(60, 25));
   textBox->setFontSize(20);
-  textBox->setValue("0");
+  textBox->setValue(std::to_string(food_count_));
 
   // This is the lambda function called while the user is moving the slider
   slider->setCallback(
@@ -386,14 +521,15 @@ void GraphicsArenaViewer::DrawFearSlider(nanogui::ref<nanogui::Window>
   nanogui::Slider *slider = new nanogui::Slider(panel);
   // The starting value (range is from 0 to 1)
   // Note that below the displayed value is 100* slider value.
-  slider->setValue(0.0f);
+  int percent = robot_count_ > 0 ? fear_count_ * 100 / robot_count_ : 0;
+  slider->setValue(percent / 100.0f);
   slider->setFixedWidth(100);
 
   // Display the corresponding value of the slider in this textbox
   nanogui::TextBox *textBox = new nanogui::TextBox(panel);
   textBox->setFixedSize(nanogui::Vector2i(70, 30));
   textBox->setFontSize(20);
-  textBox->setValue("0");
+  textBox->setValue(std::to_string(percent));
   textBox->setUnits("%");
 
   // This is the lambda function called while the user is moving the slider
@@ -420,14 +556,15 @@ void GraphicsArenaViewer::DrawLightSensorSlider(nanogui::ref<nanogui::Window>
   new nanogui::Label(panel, "LightSensor Sensitivity", "sans-bold");
   nanogui::Slider *slider = new nanogui::Slider(panel);
   // The starting value (range is from 0 to 1)
-  slider->setValue(0.0f);
+  slider->setValue(std::min(std::max((light_sensitivity_ - 1) / 0.10f, 0.0f),
+                            1.0f));
   slider->setFixedWidth(100);
 
   // Display the corresponding value of the slider in this textbox
   nanogui::TextBox *textBox = new nanogui::TextBox(panel);
   textBox->setFixedSize(nanogui::Vector2i(60, 25));
   textBox->setFontSize(20);
-  textBox->setValue("1");
+  textBox->setValue(std::to_string(light_sensitivity_));
 
   // This is the lambda function called while the user is moving the slider
   slider->setCallback(
@@ -453,14 +590,14 @@ void GraphicsArenaViewer::DrawFoodOnOffSlider(nanogui::ref<nanogui::Window>
   new nanogui::Label(panel, "Food On Off", "sans-bold");
   nanogui::Slider *slider = new nanogui::Slider(panel);
   // The starting value (range is from 0 to 1)
-  slider->setValue(0.5f);
+  slider->setValue(food_on_off_ == 1 ? 0.5f : 0.0f);
   slider->setFixedWidth(100);
 
   // Display the corresponding value of the slider in this textbox
   nanogui::TextBox *textBox = new nanogui::TextBox(panel);
   textBox->setFixedSize(nanogui::Vector2i(60, 25));
   textBox->setFontSize(20);
-  textBox->setValue("On");
+  textBox->setValue(food_on_off_ == 1 ? "On" : "Off");
 
   // This is the lambda function called while the user is moving the slider
   slider->setCallback(
@@ -481,4 +618,103 @@ void GraphicsArenaViewer::DrawFoodOnOffSlider(nanogui::ref<nanogui::Window>
   panel->setLayout(new nanogui::BoxLayout(nanogui::Orientation::Vertical,
     nanogui::Alignment::Middle, 0, 15));
 }
+
+/*******************************************************************************
+ * Replay Mode
+ ******************************************************************************/
+void GraphicsArenaViewer::AddReplayControls(nanogui::FormHelper *gui,
+                                  nanogui::ref<nanogui::Window> window) {
+  gui->addGroup("Replay Control");
+  replay_button_ =
+  gui->addButton(
+    "Play",
+    std::bind(&GraphicsArenaViewer::OnReplayBtnPressed, this));
+  replay_button_->setFixedWidth(100);
+
+  // Step slider: seeks anywhere in the recording through its index.
+  nanogui::Widget *panel = new nanogui::Widget(window);
+  new nanogui::Label(panel, "Step", "sans-bold");
+  replay_slider_ = new nanogui::Slider(panel);
+  replay_slider_->setValue(0.0f);
+  replay_slider_->setFixedWidth(100);
+  replay_step_box_ = new nanogui::TextBox(panel);
+  replay_step_box_->setFixedSize(nanogui::Vector2i(80, 25));
+  replay_step_box_->setFontSize(20);
+  replay_slider_->setCallback(
+    [this](float value) {
+      double first = replay_.get_first_step();
+      double last = replay_.get_last_step();
+      SeekReplay(first + value * (last - first));
+    });
+  panel->setLayout(new nanogui::BoxLayout(nanogui::Orientation::Vertical,
+    nanogui::Alignment::Middle, 0, 15));
+
+  // Speed slider: the left half plays in reverse.
+  panel = new nanogui::Widget(window);
+  new nanogui::Label(panel, "Playback Speed", "sans-bold");
+  replay_speed_slider_ = new nanogui::Slider(panel);
+  replay_speed_slider_->setFixedWidth(100);
+  replay_speed_box_ = new nanogui::TextBox(panel);
+  replay_speed_box_->setFixedSize(nanogui::Vector2i(80, 25));
+  replay_speed_box_->setFontSize(20);
+  replay_speed_slider_->setCallback(
+    [this](float value) {
+      SetReplaySpeed((value * 2 - 1) * kReplayMaxSpeed);
+    });
+  panel->setLayout(new nanogui::BoxLayout(nanogui::Orientation::Vertical,
+    nanogui::Alignment::Middle, 0, 15));
+  SetReplaySpeed(1.0);
+}
+
+void GraphicsArenaViewer::OnReplayBtnPressed() {
+  // Restart from the far end if playback had stopped there.
+  if (paused_ && replay_speed_ > 0 &&
+      replay_step_ >= replay_.get_last_step()) {
+    SeekReplay(replay_.get_first_step());
+  } else if (paused_ && replay_speed_ < 0 &&
+             replay_step_ <= replay_.get_first_step()) {
+    SeekReplay(replay_.get_last_step());
+  }
+  paused_ = !paused_;
+  replay_button_->setCaption(paused_ ? "Play" : "Pause");
+}
+
+void GraphicsArenaViewer::UpdateReplay(double dt) {
+  if (paused_) {
+    return;
+  }
+  SeekReplay(replay_step_ + replay_speed_ * kReplayStepsPerSecond * dt);
+  // Stop at whichever end of the recording playback is heading for.
+  if ((replay_speed_ > 0 && replay_step_ >= replay_.get_last_step()) ||
+      (replay_speed_ < 0 && replay_step_ <= replay_.get_first_step())) {
+    paused_ = true;
+    replay_button_->setCaption("Play");
+  }
+}
+
+void GraphicsArenaViewer::SeekReplay(double step) {
+  double first = replay_.get_first_step();
+  double last = replay_.get_last_step();
+  replay_step_ = std::min(std::max(step, first), last);
+  if (replay_slider_ != nullptr && last > first) {
+    replay_slider_->setValue(
+        static_cast<float>((replay_step_ - first) / (last - first)));
+  }
+  if (replay_step_box_ != nullptr) {
+    replay_step_box_->setValue(std::to_string(std::lround(replay_step_)));
+  }
+}
+
+void GraphicsArenaViewer::SetReplaySpeed(double speed) {
+  replay_speed_ = std::min(std::max(speed, -kReplayMaxSpeed), kReplayMaxSpeed);
+  if (replay_speed_slider_ != nullptr) {
+    replay_speed_slider_->setValue(
+        static_cast<float>((replay_speed_ / kReplayMaxSpeed + 1) / 2));
+  }
+  if (replay_speed_box_ != nullptr) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1) << replay_speed_ << "x";
+    replay_speed_box_->setValue(text.str());
+  }
+}
 NAMESPACE_END(csci3081);
@@ -11,11 +11,16 @@
  * Includes
  ******************************************************************************/
 #include <MinGfx-1.0/mingfx.h>
+#include <string>
 
 #include "src/arena.h"
 #include "src/controller.h"
 #include "src/common.h"
 #include "src/communication.h"
+#include "src/frame_governor.h"
+#include "src/pose.h"
+#include "src/rgb_color.h"
+#include "src/trajectory_reader.h"
 
 /*******************************************************************************
  * Namespaces
@@ -52,6 +57,19 @@ class Controller;
  *
  *  Fill in the `Draw*()` methods to draw graphics on the screen using
  *  either the `nanovg` library or raw `OpenGL`.
+ *
+ *  Given a trajectory file (see TrajectoryRecorder), the viewer runs in
+ *  replay mode instead: the Arena is never stepped and each frame is drawn
+ *  straight from the memory-mapped recording, so playback costs the same
+ *  whatever the recorded scenario cost to simulate. The menu then offers
+ *  play/pause, a step slider to seek anywhere, and a playback speed slider
+ *  whose negative half plays in reverse. The left/right arrow keys step one
+ *  frame and up/down change the speed.
+ *
+ *  While the simulation runs, a FrameGovernor times each frame's steps and
+ *  drawing, and trades away quality -- labels, sensors, full sensings and
+ *  catch-up steps -- to keep frames within the scenario's frame budget. The
+ *  current quality level is shown in the arena's corner.
  */
 class GraphicsArenaViewer : public GraphicsApp {
  public:
@@ -59,10 +77,14 @@ class GraphicsArenaViewer : public GraphicsApp {
    * @brief Constructor.
    *
    * @param params A arena_params passed down from main.cc for the
-   * initialization of the Arena and the entities therein.
+   * initialization of the Arena and the entities therein. Its counts and
+   * behavior are the sliders' starting values.
+   * @param replay_path A trajectory file to replay, or empty to run the
+   * simulation. If the file cannot be opened the simulation is run.
    */
   explicit GraphicsArenaViewer(const struct arena_params *const params,
-                               Arena *arena, Controller *controller);
+                               Arena *arena, Controller *controller,
+                               const std::string &replay_path = "");
 
   /**
    * @brief Destructor.
@@ -93,6 +115,13 @@ class GraphicsArenaViewer : public GraphicsApp {
    */
   void OnResultBtnPressed();
 
+  /**
+   * @brief Handle the user pressing the play/pause button in replay mode.
+   */
+  void OnReplayBtnPressed();
+
+  bool is_replaying() const { return replaying_; }
+
   /**
    * @brief Called each time the mouse moves on the screen within the GUI
    * window.
@@ -215,6 +244,18 @@ class GraphicsArenaViewer : public GraphicsApp {
 
  private:
   void DrawArena(NVGcontext *ctx);
+
+  /**
+   * @brief Draw the governor's quality level and frame time in the arena's
+   * top left corner.
+   */
+  void DrawQuality(NVGcontext *ctx);
+
+  /**
+   * @brief Have the Arena and the Controller run at the governor's current
+   * quality level.
+   */
+  void ApplyQuality();
   /**
    * @brief Draw a Robot using `nanogui`.
    *
@@ -226,6 +267,12 @@ class GraphicsArenaViewer : public GraphicsApp {
    */
   void DrawRobot(NVGcontext *ctx, const class Robot *const robot);
 
+  /**
+   * @brief Draw a robot from its recorded pose, radius, color and behavior.
+   */
+  void DrawRobot(NVGcontext *ctx, const Pose &pose, double radius,
+                 const RgbColor &color, int behavior_flag);
+
   /**
    * @brief Draw an Light in the Arena using `nanogui`.
    *
@@ -237,6 +284,41 @@ class GraphicsArenaViewer : public GraphicsApp {
    */
   void DrawEntity(NVGcontext *ctx, const class ArenaEntity *const entity);
 
+  /**
+   * @brief Draw any other entity from its recorded state.
+   */
+  void DrawEntity(NVGcontext *ctx, const Pose &pose, double radius,
+                  const RgbColor &color, const std::string &name);
+
+  /**
+   * @brief Draw the current replay step through DrawRobot()/DrawEntity().
+   */
+  void DrawReplayFrame(NVGcontext *ctx);
+
+  /**
+   * @brief Add the replay controls to the menu in place of the simulation
+   * controls.
+   */
+  void AddReplayControls(nanogui::FormHelper *gui,
+                         nanogui::ref<nanogui::Window> window);
+
+  /**
+   * @brief Advance the replay position by `dt` seconds at the current
+   * playback speed, pausing at either end of the recording.
+   */
+  void UpdateReplay(double dt);
+
+  /**
+   * @brief Move the replay to `step` (clamped to the recording) and update
+   * the step slider.
+   */
+  void SeekReplay(double step);
+
+  /**
+   * @brief Set the playback speed, in multiples of the simulation's own rate.
+   */
+  void SetReplaySpeed(double speed);
+
   /**
    * @brief This function is responsible for drawing a slider in the graphics
    * window so that the user can select the number of robots between 0 and 10.
@@ -309,6 +391,26 @@ class GraphicsArenaViewer : public GraphicsApp {
   float light_sensitivity_;
   // 1 means food is on in the arena, 0 means food is off in the arena.
   int food_on_off_;
+
+  // quality governor
+  FrameGovernor governor_;
+  // the scenario's own steps between full sensings; never sensed more often.
+  uint32_t sense_interval_;
+  // how long the last frame took to draw, in milliseconds.
+  double draw_ms_{0};
+
+  // replay mode
+  TrajectoryReader replay_{};
+  bool replaying_{false};
+  // current position in the recording; fractional at slow speeds.
+  double replay_step_{0};
+  // playback speed, negative for reverse.
+  double replay_speed_{1};
+  nanogui::Button *replay_button_{nullptr};
+  nanogui::Slider *replay_slider_{nullptr};
+  nanogui::TextBox *replay_step_box_{nullptr};
+  nanogui::Slider *replay_speed_slider_{nullptr};
+  nanogui::TextBox *replay_speed_box_{nullptr};
 };
 
 NAMESPACE_END(csci3081);
@@ -0,0 +1,212 @@
+/**
+ * @file kinetic_schedule.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "src/kinetic_schedule.h"
+#include "src/swept_collision.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+// Pairs are predicted to meet this much early, and straight motion taken to
+// drift this far from its prediction before it counts as changed: stepping
+// adds a rounding error every step, where the prediction multiplies once.
+static const double kSafety = 1e-3;
+static const double kDrift = 1e-6;
+// Meetings further ahead than this many steps are not queued.
+static const double kHorizon = 16777216;
+
+/*******************************************************************************
+ * Static Functions
+ ******************************************************************************/
+static bool Same(double a, double b) { return !(a < b || b < a); }
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+const uint32_t KineticSchedule::kWall;
+
+KineticSchedule::KineticSchedule()
+    : bodies_(), since_(), version_(), changed_(), events_(),
+      predictions_(0), discarded_(0) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void KineticSchedule::Clear() {
+  bodies_.clear();
+  since_.clear();
+  version_.clear();
+  events_.clear();
+}
+
+uint64_t KineticSchedule::Update(const std::vector<KineticBody> &bodies,
+                                 uint64_t now, double x_dim, double y_dim) {
+  uint32_t n = static_cast<uint32_t>(bodies.size());
+  bool fresh = bodies_.size() != bodies.size();
+  if (fresh) {
+    Clear();
+    bodies_.resize(n);
+    since_.assign(n, now);
+    version_.assign(n, 0);
+  }
+  changed_.assign(n, 0);
+  for (uint32_t i = 0; i < n; ++i) {
+    if (fresh || Changed(bodies[i], i, now)) {
+      changed_[i] = 1;
+      ++version_[i];
+      bodies_[i] = bodies[i];
+      since_[i] = now;
+    }
+  }
+  // Outdated events wait in the heap until they reach the top; once they
+  // are most of it, they are swept out.
+  if (events_.size() > 2 * static_cast<size_t>(n) * n + 64) {
+    size_t kept = events_.size();
+    events_.erase(
+        std::remove_if(events_.begin(), events_.end(),
+                       [this](const Event &e) {
+                         return e.version_a != version_[e.a] ||
+                                (e.b != kWall && e.version_b != version_[e.b]);
+                       }),
+        events_.end());
+    discarded_ += kept - events_.size();
+    std::make_heap(events_.begin(), events_.end(), Later);
+  }
+  for (uint32_t i = 0; i < n; ++i) {
+    if (!changed_[i]) {
+      continue;
+    }
+    // Food never moves: it meets neither walls nor other food. Anything
+    // else, even if it stands still now, may already be touching.
+    bool food = bodies_[i].kind == kKineticFood;
+    if (!food) {
+      Predict(i, kWall, now, x_dim, y_dim);
+    }
+    for (uint32_t j = 0; j < n; ++j) {
+      if (j == i || (changed_[j] && j < i) ||
+          (food && bodies_[j].kind == kKineticFood)) {
+        continue;
+      }
+      Predict(i, j, now, x_dim, y_dim);
+    }
+  }
+  // Events whose step has come are predicted again from where the bodies
+  // are now: a prediction from bounds on the motion may come well before
+  // the bodies really meet.
+  while (!events_.empty()) {
+    Event top = events_.front();
+    bool stale = top.version_a != version_[top.a] ||
+                 (top.b != kWall && top.version_b != version_[top.b]);
+    if (!stale && top.step > now) {
+      return top.step;
+    }
+    std::pop_heap(events_.begin(), events_.end(), Later);
+    events_.pop_back();
+    if (stale) {
+      ++discarded_;
+    } else {
+      Predict(top.a, top.b, now, x_dim, y_dim);
+    }
+  }
+  return UINT64_MAX;
+}
+
+bool KineticSchedule::Changed(const KineticBody &body, uint32_t i,
+                              uint64_t now) const {
+  const KineticBody &old = bodies_[i];
+  if (body.kind != old.kind || !Same(body.radius, old.radius) ||
+      !body.straight || !old.straight || !Same(body.step_x, old.step_x) ||
+      !Same(body.step_y, old.step_y) ||
+      !Same(body.step_reach, old.step_reach)) {
+    return true;
+  }
+  for (int k = 0; k < kKineticKinds; ++k) {
+    if (!Same(body.reach[k], old.reach[k])) {
+      return true;
+    }
+  }
+  double x = 0, y = 0;
+  Position(i, now, &x, &y);
+  return std::fabs(body.x - x) > kDrift || std::fabs(body.y - y) > kDrift;
+}
+
+void KineticSchedule::Predict(uint32_t a, uint32_t b, uint64_t now,
+                              double x_dim, double y_dim) {
+  ++predictions_;
+  const KineticBody &p = bodies_[a];
+  double ax = 0, ay = 0;
+  Position(a, now, &ax, &ay);
+  // Steps from now to the meeting.
+  double t = kHorizon;
+  if (b == kWall) {
+    double low = p.radius + kSafety;
+    double gap = std::min(std::min(ax - low, x_dim - low - ax),
+                          std::min(ay - low, y_dim - low - ay));
+    if (!(gap > 0)) {
+      t = 0;
+    } else if (!p.straight) {
+      t = p.step_reach > 0 ? gap / p.step_reach : kHorizon;
+    } else {
+      if (p.step_x < 0) t = std::min(t, (ax - low) / -p.step_x);
+      if (p.step_x > 0) t = std::min(t, (x_dim - low - ax) / p.step_x);
+      if (p.step_y < 0) t = std::min(t, (ay - low) / -p.step_y);
+      if (p.step_y > 0) t = std::min(t, (y_dim - low - ay) / p.step_y);
+    }
+  } else {
+    const KineticBody &q = bodies_[b];
+    double bx = 0, by = 0;
+    Position(b, now, &bx, &by);
+    double within = std::max(p.reach[q.kind] + q.radius,
+                             q.reach[p.kind] + p.radius) + kSafety;
+    double px = ax - bx, py = ay - by;
+    double distance = std::sqrt(px * px + py * py);
+    if (!(distance > within)) {
+      t = 0;
+    } else if (p.straight && q.straight) {
+      double hit = 1;
+      if (SweptCircleHit(px, py, (p.step_x - q.step_x) * kHorizon,
+                         (p.step_y - q.step_y) * kHorizon, within, &hit)) {
+        t = hit * kHorizon;
+      }
+    } else if (p.step_reach + q.step_reach > 0) {
+      t = (distance - within) / (p.step_reach + q.step_reach);
+    }
+  }
+  if (t < kHorizon) {
+    Push(now + std::max(uint64_t{1}, static_cast<uint64_t>(std::ceil(t))), a,
+         b);
+  }
+}
+
+void KineticSchedule::Position(uint32_t i, uint64_t now, double *x,
+                               double *y) const {
+  const KineticBody &body = bodies_[i];
+  double steps = static_cast<double>(now - since_[i]);
+  *x = body.x + steps * body.step_x;
+  *y = body.y + steps * body.step_y;
+}
+
+bool KineticSchedule::Later(const Event &a, const Event &b) {
+  return a.step > b.step;
+}
+
+void KineticSchedule::Push(uint64_t step, uint32_t a, uint32_t b) {
+  events_.push_back({step, a, b, version_[a], b == kWall ? 0 : version_[b]});
+  std::push_heap(events_.begin(), events_.end(), Later);
+}
+
+NAMESPACE_END(csci3081);
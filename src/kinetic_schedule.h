@@ -0,0 +1,148 @@
+/**
+ * @file kinetic_schedule.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_KINETIC_SCHEDULE_H_
+#define SRC_KINETIC_SCHEDULE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+// What a KineticBody is, for how near other bodies matter to it.
+enum KineticKind {
+  kKineticRobot,
+  kKineticLight,
+  kKineticFood,
+  kKineticKinds
+};
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief A circle as the kinetic schedule sees it: where it is, how it moves
+ * each step, and how near other circles can come before the step they do is
+ * no longer quiet.
+ */
+struct KineticBody {
+  double x{0};
+  double y{0};
+  double radius{0};
+  KineticKind kind{kKineticFood};
+  // Whether the body moves the same (step_x, step_y) every step; if not, it
+  // moves at most step_reach a step, along some curve.
+  bool straight{true};
+  double step_x{0};
+  double step_y{0};
+  double step_reach{0};
+  // From the body's center to another body's edge, by the other's kind, the
+  // distance within which the pair interacts: touch, eat, sense.
+  double reach[kKineticKinds]{0, 0, 0};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Predicts the next step at which any of a set of moving circles
+ * meets another or a wall, keeping the predictions in a priority queue from
+ * one call to the next.
+ *
+ * Each pair's next meeting is found analytically: exactly, as a swept
+ * circle, when both bodies move straight, and otherwise from how far each
+ * can move per step. The predictions stay queued while the bodies keep the
+ * motion they were made for, and only the pairs of bodies whose motion
+ * changed, and those whose predicted step has come, are predicted again.
+ */
+class KineticSchedule {
+ public:
+  KineticSchedule();
+
+  /**
+   * @brief Forget every prediction; the next Update() predicts every pair.
+   */
+  void Clear();
+
+  /**
+   * @brief Bring the predictions up to date with `bodies`, as they are at
+   * step `now`, in an `x_dim` by `y_dim` arena. The bodies must be the same,
+   * in the same order, as at the last call since Clear().
+   *
+   * @return The first step after `now` at which some pair of bodies, or a
+   * body and a wall, may interact; UINT64_MAX if none ever do.
+   */
+  uint64_t Update(const std::vector<KineticBody> &bodies, uint64_t now,
+                  double x_dim, double y_dim);
+
+  /**
+   * @brief Number of predictions made, and of those discarded unused
+   * because their bodies' motion changed.
+   */
+  uint64_t get_predictions() const { return predictions_; }
+  uint64_t get_discarded() const { return discarded_; }
+
+ private:
+  struct Event {
+    uint64_t step;
+    uint32_t a;
+    uint32_t b;  // kWall for a wall
+    uint32_t version_a;
+    uint32_t version_b;
+  };
+
+  static const uint32_t kWall = UINT32_MAX;
+
+  /**
+   * @brief Whether body `i`'s motion is not what it was predicted with, as
+   * of step `now`.
+   */
+  bool Changed(const KineticBody &body, uint32_t i, uint64_t now) const;
+
+  /**
+   * @brief Queue the next meeting of bodies `a` and `b`, or of body `a` and
+   * a wall if `b` is kWall, predicted from their motion at `now`.
+   */
+  void Predict(uint32_t a, uint32_t b, uint64_t now, double x_dim,
+               double y_dim);
+
+  /**
+   * @brief Body `i`'s position at `now`, from its recorded motion.
+   */
+  void Position(uint32_t i, uint64_t now, double *x, double *y) const;
+
+  void Push(uint64_t step, uint32_t a, uint32_t b);
+
+  // The heap's order: the earliest event on top.
+  static bool Later(const Event &a, const Event &b);
+
+  // The bodies as last predicted with, and the step they were at then.
+  std::vector<KineticBody> bodies_;
+  std::vector<uint64_t> since_;
+  // Bumped whenever a body's motion changes, outdating its queued events.
+  std::vector<uint32_t> version_;
+  std::vector<uint8_t> changed_;
+  // A min-heap on step.
+  std::vector<Event> events_;
+  uint64_t predictions_;
+  uint64_t discarded_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_KINETIC_SCHEDULE_H_
@@ -36,8 +36,20 @@ void Light::Reset() {
   motion_handler_.set_velocity(LIGHT_SPEED, LIGHT_SPEED);
 }/* Reset */
 
+void Light::SaveState(EntityState *state) const {
+  ArenaMobileEntity::SaveState(state);
+  state->vel_left = motion_handler_.get_velocity().left;
+  state->vel_right = motion_handler_.get_velocity().right;
+}
+
+void Light::LoadState(const EntityState &state) {
+  ArenaMobileEntity::LoadState(state);
+  motion_handler_.set_velocity(state.vel_left, state.vel_right);
+  sensor_touch_->Reset();
+}
 
-void Light::TimestepUpdate(unsigned int dt) {
+
+void Light::TimestepUpdate(double dt) {
   motion_behavior_.UpdatePose(dt, motion_handler_.get_velocity());
   // Reset Sensor for next cycle
   sensor_touch_->Reset();
@@ -77,6 +89,12 @@ void Light::HandleCollision(EntityType object_type, ArenaEntity * object) {
   }
 }
 
+void Light::HandleWallCollision(uint8_t walls) {
+  if (walls != 0) {
+    HandleCollision(FirstWall(walls));
+  }
+}
+
 // Function that gives lights the arc movement when lights collide
 void Light::ArcMovement() {
   /*
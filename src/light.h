@@ -49,6 +49,19 @@ class Light : public ArenaMobileEntity {
    */
   void Reset() override;
 
+  /**
+   * @brief Add the wheel velocities to the base entity record.
+   */
+  void SaveState(EntityState *state) const override;
+
+  /**
+   * @brief Restore everything written by SaveState().
+   */
+  void LoadState(const EntityState &state) override;
+
+  WheelVelocity get_wheel_velocity() const override {
+    return motion_handler_.get_velocity();
+  }
 
   std::string get_name() const override {
     return "Light" + std::to_string(get_id());
@@ -58,9 +71,10 @@ class Light : public ArenaMobileEntity {
    * @brief Update the Light's position and velocity after the specified
    * duration has passed.
    *
-   * @param dt The # of timesteps that have elapsed since the last update.
+   * @param dt The time the step moves the Light by, in the units of its
+   * speed (see arena_params::dt).
    */
-  void TimestepUpdate(unsigned int dt) override;
+  void TimestepUpdate(double dt) override;
 
   /**
   * @brief Update the heading angle according to the touch sensor reading.
@@ -83,13 +97,19 @@ class Light : public ArenaMobileEntity {
    */
   void HandleCollision(EntityType object_type, ArenaEntity * object = NULL);
 
+  /**
+   * @brief Handles touching the walls in `walls` (WallBit()s) as a collision
+   * with the first of them.
+   */
+  void HandleWallCollision(uint8_t walls) override;
+
   /**
   * @brief Generates radius for lights randomly and ensures that the radius
   * of light is random.
   */
   double SetRadiusRandomly() {
   // Returning the radius randomly.
-  return static_cast<double>  (random() %
+  return static_cast<double>  (get_random_generator()->Next() %
   (LIGHT_MAX_RADIUS + 1 - LIGHT_MIN_RADIUS) + LIGHT_MIN_RADIUS);
   }
 
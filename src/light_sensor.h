@@ -56,6 +56,11 @@ class LightSensor : public Sensor {
     base_value_ = lsensor_base;
   }
 
+  /**
+  * @brief Getter for the base value for light sensor calculation.
+  */
+  float get_base_value() const { return base_value_; }
+
  private:
   // Variable to store the base value for light sensor calculation as provided
   // the user.
@@ -0,0 +1,157 @@
+/**
+ * @file loose_quadtree.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cmath>
+
+#include "src/loose_quadtree.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+LooseQuadtree::LooseQuadtree(size_t capacity, int max_depth)
+    : nodes_(), items_(), size_(0), capacity_(capacity),
+      max_depth_(max_depth), stack_() {
+  Reset(0, 0, 1);
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void LooseQuadtree::Reset(double x, double y, double size) {
+  nodes_.clear();
+  nodes_.push_back({x + size / 2, y + size / 2, size / 2, -1, 0, {}});
+  items_.clear();
+  size_ = 0;
+}
+
+void LooseQuadtree::Update(uint32_t id, double x, double y, double radius) {
+  if (id >= items_.size()) {
+    items_.resize(id + 1, Item{0, 0, 0, -1, 0});
+  }
+  Item &item = items_[id];
+  item.x = x;
+  item.y = y;
+  item.radius = radius;
+  if (item.node < 0) {
+    ++size_;
+    Place(id, 0);
+    return;
+  }
+  int32_t n = item.node;
+  if ((n == 0 || Fits(n, id)) && ChildFor(n, id) < 0) {
+    return;
+  }
+  Detach(id);
+  Place(id, 0);
+}
+
+void LooseQuadtree::Remove(uint32_t id) {
+  if (Contains(id)) {
+    Detach(id);
+    items_[id].node = -1;
+    --size_;
+  }
+}
+
+void LooseQuadtree::Query(double x, double y, double radius,
+                          std::vector<uint32_t> *found) const {
+  stack_.assign(1, 0);
+  while (!stack_.empty()) {
+    const Node &node = nodes_[stack_.back()];
+    stack_.pop_back();
+    // Everything in the node lies within its loose bounds, cx +- 2 * half.
+    // The root also holds whatever has left the tree's square.
+    double reach = 2 * node.half + radius;
+    if (node.depth > 0 && (std::fabs(x - node.cx) > reach ||
+                           std::fabs(y - node.cy) > reach)) {
+      continue;
+    }
+    for (uint32_t id : node.items) {
+      const Item &item = items_[id];
+      double dx = item.x - x;
+      double dy = item.y - y;
+      double within = radius + item.radius;
+      if (dx * dx + dy * dy <= within * within) {
+        found->push_back(id);
+      }
+    }
+    if (node.child >= 0) {
+      for (int32_t c = node.child; c < node.child + 4; ++c) {
+        stack_.push_back(c);
+      }
+    }
+  }
+}
+
+int32_t LooseQuadtree::ChildFor(int32_t n, uint32_t id) const {
+  const Node &node = nodes_[n];
+  if (node.child < 0) {
+    return -1;
+  }
+  const Item &item = items_[id];
+  int32_t c = node.child + (item.y >= node.cy ? 2 : 0) +
+              (item.x >= node.cx ? 1 : 0);
+  return Fits(c, id) ? c : -1;
+}
+
+bool LooseQuadtree::Fits(int32_t n, uint32_t id) const {
+  const Node &node = nodes_[n];
+  const Item &item = items_[id];
+  return std::fabs(item.x - node.cx) <= node.half &&
+         std::fabs(item.y - node.cy) <= node.half &&
+         item.radius <= node.half;
+}
+
+void LooseQuadtree::Place(uint32_t id, int32_t n) {
+  for (;;) {
+    int32_t c = ChildFor(n, id);
+    if (c >= 0) {
+      n = c;
+    } else if (nodes_[n].child < 0 && nodes_[n].items.size() >= capacity_ &&
+               nodes_[n].depth < max_depth_) {
+      Split(n);
+    } else {
+      break;
+    }
+  }
+  items_[id].node = n;
+  items_[id].slot = static_cast<uint32_t>(nodes_[n].items.size());
+  nodes_[n].items.push_back(id);
+}
+
+void LooseQuadtree::Split(int32_t n) {
+  int32_t child = static_cast<int32_t>(nodes_.size());
+  double half = nodes_[n].half / 2;
+  for (int q = 0; q < 4; ++q) {
+    double cx = nodes_[n].cx + ((q & 1) ? half : -half);
+    double cy = nodes_[n].cy + ((q & 2) ? half : -half);
+    nodes_.push_back({cx, cy, half, -1, nodes_[n].depth + 1, {}});
+  }
+  nodes_[n].child = child;
+  std::vector<uint32_t> items;
+  items.swap(nodes_[n].items);
+  for (uint32_t id : items) {
+    Place(id, n);
+  }
+}
+
+void LooseQuadtree::Detach(uint32_t id) {
+  std::vector<uint32_t> &items = nodes_[items_[id].node].items;
+  uint32_t slot = items_[id].slot;
+  items[slot] = items.back();
+  items_[items[slot]].slot = slot;
+  items.pop_back();
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,125 @@
+/**
+ * @file loose_quadtree.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_LOOSE_QUADTREE_H_
+#define SRC_LOOSE_QUADTREE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A loose quadtree of circles identified by small integer ids, with
+ * radius queries.
+ *
+ * A circle lives in the deepest node whose square holds its center and
+ * whose half-width is at least its radius, so it lies within the node's
+ * loose bounds: the square twice the node's size about the same center.
+ * Nodes split once they hold more than a set number of circles, so crowded
+ * regions get deeper, finer nodes while sparse ones stay coarse. Circles
+ * whose centers leave the tree's square stay in the root.
+ */
+class LooseQuadtree {
+ public:
+  /**
+   * @param[in] capacity Circles a leaf holds before it splits.
+   * @param[in] max_depth Depth below which nodes never split.
+   */
+  explicit LooseQuadtree(size_t capacity = 8, int max_depth = 10);
+
+  /**
+   * @brief Drop every circle and cover the square with corner (`x`, `y`)
+   * and side `size`.
+   */
+  void Reset(double x, double y, double size);
+
+  /**
+   * @brief Add circle `id`, or move it if it is already in the tree. Moves
+   * that keep the circle in its node only update it.
+   */
+  void Update(uint32_t id, double x, double y, double radius);
+
+  /**
+   * @brief Remove circle `id`, if it is in the tree.
+   */
+  void Remove(uint32_t id);
+
+  bool Contains(uint32_t id) const {
+    return id < items_.size() && items_[id].node >= 0;
+  }
+
+  /**
+   * @brief Append to `found` the id of every circle that comes within
+   * `radius` of (`x`, `y`), in no particular order.
+   */
+  void Query(double x, double y, double radius,
+             std::vector<uint32_t> *found) const;
+
+  size_t size() const { return size_; }
+  size_t node_count() const { return nodes_.size(); }
+
+ private:
+  struct Node {
+    double cx;
+    double cy;
+    double half;
+    int32_t child;  // first of four children, or -1 for a leaf
+    int depth;
+    std::vector<uint32_t> items;
+  };
+  struct Item {
+    double x;
+    double y;
+    double radius;
+    int32_t node;  // -1 if not in the tree
+    uint32_t slot;  // index in the node's items
+  };
+
+  /**
+   * @brief The child of node `n` that item `id` belongs in, or -1 if it
+   * belongs in `n` itself.
+   */
+  int32_t ChildFor(int32_t n, uint32_t id) const;
+
+  /**
+   * @brief Whether item `id`'s center lies in node `n`'s square and its
+   * radius is within the node's half-width.
+   */
+  bool Fits(int32_t n, uint32_t id) const;
+
+  /**
+   * @brief Put item `id` in the node below `n` it belongs in, splitting
+   * full leaves on the way.
+   */
+  void Place(uint32_t id, int32_t n);
+  void Split(int32_t n);
+  void Detach(uint32_t id);
+
+  std::vector<Node> nodes_;
+  std::vector<Item> items_;
+  size_t size_;
+  size_t capacity_;
+  int max_depth_;
+  // Query scratch.
+  mutable std::vector<int32_t> stack_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_LOOSE_QUADTREE_H_
@@ -8,17 +8,47 @@
  * Includes
  ******************************************************************************/
 #include <iostream>
+#include <string>
 
 #include "src/arena_params.h"
 #include "src/controller.h"
 #include "src/graphics_arena_viewer.h"
+#include "src/scenario.h"
 
 /*******************************************************************************
  * Non-Member Functions
  ******************************************************************************/
-int main(__unused int argc, __unused char **argv) {
+int main(int argc, char **argv) {
+  // `arenaviewer --replay run.traj` replays a recorded trajectory instead of
+  // running the simulation; `--log-session run.ses` saves the session's
+  // inputs for arenarunner to re-execute; `--scenario file.ini` sets the
+  // arena's size and starting configuration (see scenario.h).
+  std::string replay_path;
+  std::string session_path;
+  csci3081::arena_params aparams;
+  for (int i = 1; i < argc; i += 2) {
+    std::string option = argv[i];
+    std::string error;
+    if (i + 1 < argc && option == "--replay") {
+      replay_path = argv[i + 1];
+    } else if (i + 1 < argc && option == "--log-session") {
+      session_path = argv[i + 1];
+    } else if (i + 1 < argc && option == "--scenario") {
+      if (!csci3081::LoadScenario(argv[i + 1], &aparams, &error)) {
+        std::cerr << error << std::endl;
+        return 1;
+      }
+    } else {
+      std::cerr << "usage: " << argv[0]
+                << " [--scenario scenario_file] [--replay trajectory_file]"
+                << " [--log-session session_file]" << std::endl;
+      return 1;
+    }
+  }
+
   // The controller creates both the arena and viewer
-  auto *controller = new csci3081::Controller;
+  auto *controller =
+      new csci3081::Controller(aparams, replay_path, session_path);
 
   // The controller will call Run of the viewer
   controller->Run();
@@ -14,7 +14,6 @@
 #include "src/motion_handler.h"
 #include "src/motion_handler_robot.h"
 #include "src/wheel_velocity.h"
-#include "src/robot.h"
 /*******************************************************************************
  * Namespaces
  ******************************************************************************/
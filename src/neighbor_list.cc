@@ -0,0 +1,99 @@
+/**
+ * @file neighbor_list.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+
+#include "src/neighbor_list.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+NeighborList::NeighborList(double skin)
+    : Broadphase(skin), cell_start_(), cell_members_(), pairs_() {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+bool NeighborList::Update(const std::vector<ArenaEntity *> &entities,
+                          const std::vector<ArenaMobileEntity *> &mobile,
+                          bool reset) {
+  if (!reset && !AnyMoved(entities)) {
+    return false;
+  }
+  Build(entities, mobile);
+  return true;
+}
+
+// Mobile entities are binned into a grid of cells at least as wide as the
+// largest cutoff, so each one's neighbors lie in its own cell or the eight
+// around it.
+void NeighborList::Build(const std::vector<ArenaEntity *> &entities,
+                         const std::vector<ArenaMobileEntity *> &mobile) {
+  Record(entities, mobile);
+  size_t n = index_.size();
+  double min_x = 0, min_y = 0, max_x = 0, max_y = 0, max_radius = 0;
+  for (size_t m = 0; m < n; ++m) {
+    uint32_t i = index_[m];
+    min_x = m == 0 ? x_[i] : std::min(min_x, x_[i]);
+    min_y = m == 0 ? y_[i] : std::min(min_y, y_[i]);
+    max_x = m == 0 ? x_[i] : std::max(max_x, x_[i]);
+    max_y = m == 0 ? y_[i] : std::max(max_y, y_[i]);
+    max_radius = std::max(max_radius, radius_[i]);
+  }
+  double cell = 2 * max_radius + skin_;
+  int cols = static_cast<int>((max_x - min_x) / cell) + 1;
+  int rows = static_cast<int>((max_y - min_y) / cell) + 1;
+  std::vector<uint32_t> cell_of(n);
+  cell_start_.assign(static_cast<size_t>(cols) * rows + 1, 0);
+  for (size_t m = 0; m < n; ++m) {
+    int cx = static_cast<int>((x_[index_[m]] - min_x) / cell);
+    int cy = static_cast<int>((y_[index_[m]] - min_y) / cell);
+    cell_of[m] = static_cast<uint32_t>(cy * cols + cx);
+    ++cell_start_[cell_of[m] + 1];
+  }
+  for (size_t c = 1; c < cell_start_.size(); ++c) {
+    cell_start_[c] += cell_start_[c - 1];
+  }
+  cell_members_.resize(n);
+  std::vector<uint32_t> fill(cell_start_.begin(), cell_start_.end() - 1);
+  for (size_t m = 0; m < n; ++m) {
+    cell_members_[fill[cell_of[m]]++] = index_[m];
+  }
+
+  pairs_.clear();
+  for (uint32_t m = 0; m < n; ++m) {
+    uint32_t i = index_[m];
+    int cx = static_cast<int>(cell_of[m] % cols);
+    int cy = static_cast<int>(cell_of[m] / cols);
+    for (int ny = std::max(cy - 1, 0); ny <= std::min(cy + 1, rows - 1);
+         ++ny) {
+      for (int nx = std::max(cx - 1, 0); nx <= std::min(cx + 1, cols - 1);
+           ++nx) {
+        size_t c = static_cast<size_t>(ny) * cols + nx;
+        for (uint32_t k = cell_start_[c]; k < cell_start_[c + 1]; ++k) {
+          uint32_t j = cell_members_[k];
+          double dx = x_[j] - x_[i];
+          double dy = y_[j] - y_[i];
+          double cutoff = radius_[i] + radius_[j] + skin_;
+          if (j != i && dx * dx + dy * dy <= cutoff * cutoff) {
+            pairs_.push_back({m, j});
+          }
+        }
+      }
+    }
+  }
+  SetCandidates(&pairs_);
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,59 @@
+/**
+ * @file neighbor_list.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_NEIGHBOR_LIST_H_
+#define SRC_NEIGHBOR_LIST_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "src/broadphase.h"
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Verlet neighbor lists: for each mobile entity, the entities within
+ * the sum of their radii plus the skin distance when the lists were built.
+ *
+ * Until some entity has moved skin/2 from where it was at the build, no two
+ * entities can have come within touching distance without being in each
+ * other's lists, so the lists are rebuilt only then.
+ */
+class NeighborList : public Broadphase {
+ public:
+  explicit NeighborList(double skin);
+
+  int get_kind() const override { return kBroadphaseNeighborList; }
+
+ protected:
+  bool Update(const std::vector<ArenaEntity *> &entities,
+              const std::vector<ArenaMobileEntity *> &mobile,
+              bool reset) override;
+
+ private:
+  void Build(const std::vector<ArenaEntity *> &entities,
+             const std::vector<ArenaMobileEntity *> &mobile);
+
+  // Build scratch: entity indices binned by grid cell, and the pairs found.
+  std::vector<uint32_t> cell_start_;
+  std::vector<uint32_t> cell_members_;
+  std::vector<std::pair<uint32_t, uint32_t>> pairs_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_NEIGHBOR_LIST_H_
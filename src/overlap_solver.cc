@@ -0,0 +1,119 @@
+/**
+ * @file overlap_solver.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cmath>
+
+#include "src/arena_entity.h"
+#include "src/arena_mobile_entity.h"
+#include "src/overlap_solver.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+double ContactNormal(double x1, double y1, double x2, double y2, double *nx,
+                     double *ny) {
+  double dx = x1 - x2;
+  double dy = y1 - y2;
+  double distance = std::sqrt(dx * dx + dy * dy);
+  if (distance > 0) {
+    *nx = dx / distance;
+    *ny = dy / distance;
+  } else {
+    *nx = 1;
+    *ny = 0;
+  }
+  return distance;
+}
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+OverlapSolver::OverlapSolver()
+    : contacts_(), start_(), x_(), y_(), radius_(), index_(), mobile_(),
+      next_x_(), next_y_() {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+int OverlapSolver::Solve(const std::vector<ArenaEntity *> &entities,
+                         const std::vector<ArenaMobileEntity *> &mobile,
+                         int passes) {
+  size_t n = entities.size();
+  x_.resize(n);
+  y_.resize(n);
+  radius_.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    x_[i] = entities[i]->get_pose().x;
+    y_[i] = entities[i]->get_pose().y;
+    radius_[i] = entities[i]->get_radius();
+  }
+  index_.clear();
+  mobile_.assign(n, 0);
+  size_t next = 0;
+  for (auto ent : mobile) {
+    while (entities[next] != ent) {
+      ++next;
+    }
+    mobile_[next] = 1;
+    index_.push_back(static_cast<uint32_t>(next));
+  }
+  start_.assign(index_.size() + 1, 0);
+  for (auto &contact : contacts_) {
+    ++start_[contact.first + 1];
+  }
+  for (size_t m = 1; m < start_.size(); ++m) {
+    start_[m] += start_[m - 1];
+  }
+  next_x_.resize(index_.size());
+  next_y_.resize(index_.size());
+
+  int pass = 0;
+  for (; pass < passes; ++pass) {
+    // Each mobile entity's correction reads only the last pass's poses.
+    bool overlapping = false;
+    for (uint32_t m = 0; m < index_.size(); ++m) {
+      uint32_t i = index_[m];
+      double push_x = 0, push_y = 0;
+      int pushes = 0;
+      for (uint32_t c = start_[m]; c < start_[m + 1]; ++c) {
+        uint32_t j = contacts_[c].second;
+        double nx = 0, ny = 0;
+        double overlap = radius_[i] + radius_[j] -
+                         ContactNormal(x_[i], y_[i], x_[j], y_[j], &nx, &ny);
+        if (overlap > 0) {
+          double share = mobile_[j] ? overlap / 2 : overlap;
+          push_x += nx * share;
+          push_y += ny * share;
+          ++pushes;
+        }
+      }
+      next_x_[m] = x_[i] + push_x;
+      next_y_[m] = y_[i] + push_y;
+      overlapping = overlapping || pushes > 0;
+    }
+    if (!overlapping) {
+      break;
+    }
+    for (uint32_t m = 0; m < index_.size(); ++m) {
+      x_[index_[m]] = next_x_[m];
+      y_[index_[m]] = next_y_[m];
+    }
+  }
+  for (uint32_t m = 0; m < index_.size(); ++m) {
+    mobile[m]->set_position(x_[index_[m]], y_[index_[m]]);
+  }
+  return pass;
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,103 @@
+/**
+ * @file overlap_solver.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_OVERLAP_SOLVER_H_
+#define SRC_OVERLAP_SOLVER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+class ArenaEntity;
+class ArenaMobileEntity;
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Separates overlapping entities by Jacobi relaxation over a list of
+ * contacts, rather than one pair at a time.
+ *
+ * The contacts are the pairs that collide or nearly do. Each pass computes
+ * every mobile entity's correction from the poses at the end of the
+ * previous pass: it is pushed out of each contact it overlaps along the
+ * contact normal, by half the overlap if the other entity is mobile (which
+ * is pushed the other half) and by all of it if not, and moves by the sum
+ * of those pushes. No mobile entity's correction
+ * depends on another's in the same pass, so the passes could be split
+ * among threads, and a dense pack settles over a fixed number of passes
+ * instead of pushing entities into new overlaps one pair at a time.
+ */
+class OverlapSolver {
+ public:
+  OverlapSolver();
+
+  /**
+   * @brief Forget the last step's contacts.
+   */
+  void Clear() { contacts_.clear(); }
+
+  /**
+   * @brief Add the contact of mobile entity `m` with entity index `j`;
+   * contacts must be added in order of `m`.
+   */
+  void AddContact(uint32_t m, uint32_t j) { contacts_.push_back({m, j}); }
+
+  /**
+   * @brief Run up to `passes` passes over the contacts, starting from the
+   * entities' current poses, and move the mobile entities to the result.
+   * `mobile` must be the mobile subset of `entities`, in order.
+   *
+   * @return Number of passes run; fewer than `passes` once no contact
+   * overlaps any more.
+   */
+  int Solve(const std::vector<ArenaEntity *> &entities,
+            const std::vector<ArenaMobileEntity *> &mobile, int passes);
+
+  size_t contact_count() const { return contacts_.size(); }
+
+ private:
+  // (mobile entity, entity index), by mobile entity; mobile entity m's are
+  // contacts_[start_[m], start_[m + 1]).
+  std::vector<std::pair<uint32_t, uint32_t>> contacts_;
+  std::vector<uint32_t> start_;
+  // Every entity's pose, as of the last pass, and radius.
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> radius_;
+  // Mobile entity -> entity index, and whether each entity is mobile.
+  std::vector<uint32_t> index_;
+  std::vector<uint8_t> mobile_;
+  // The mobile entities' poses after the pass in progress.
+  std::vector<double> next_x_;
+  std::vector<double> next_y_;
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief The unit vector from (`x2`, `y2`) to (`x1`, `y1`), into
+ * `nx`, `ny`, and the distance between them, which is returned; (1, 0)
+ * if the points coincide.
+ */
+double ContactNormal(double x1, double y1, double x2, double y2, double *nx,
+                     double *ny);
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_OVERLAP_SOLVER_H_
@@ -33,6 +33,20 @@
 #define ARENA_X_DIM X_DIM
 #define ARENA_Y_DIM Y_DIM
 
+// Entities less than this apart are still contacts of the overlap solver
+// (see OverlapSolver), which keeps it from pushing them into each other.
+#define RELAX_CONTACT_MARGIN 10
+
+// Mobile entities that touch a wall are moved this far clear of it (see
+// WallCollision).
+#define WALL_BACKOFF 5
+
+// simulation
+// Bump whenever a change alters how the simulation evolves (i.e. whenever
+// tests/golden has to be regenerated). Cached sweep results (see
+// ResultCache) from any other version are discarded.
+#define SIMULATION_VERSION 5
+
 // game status
 #define WON 0
 #define LOST 1
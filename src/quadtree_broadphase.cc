@@ -0,0 +1,68 @@
+/**
+ * @file quadtree_broadphase.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+
+#include "src/quadtree_broadphase.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+QuadtreeBroadphase::QuadtreeBroadphase(double skin)
+    : Broadphase(skin), tree_(), found_(), pairs_() {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+bool QuadtreeBroadphase::Update(const std::vector<ArenaEntity *> &entities,
+                                const std::vector<ArenaMobileEntity *> &mobile,
+                                bool reset) {
+  if (!reset && !AnyMoved(entities)) {
+    return false;
+  }
+  Record(entities, mobile);
+  size_t n = index_.size();
+  if (reset) {
+    // The tree covers where the mobile entities are now; any that later
+    // leave it are kept in the root.
+    double min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+    for (size_t m = 0; m < n; ++m) {
+      uint32_t i = index_[m];
+      min_x = m == 0 ? x_[i] : std::min(min_x, x_[i]);
+      min_y = m == 0 ? y_[i] : std::min(min_y, y_[i]);
+      max_x = m == 0 ? x_[i] : std::max(max_x, x_[i]);
+      max_y = m == 0 ? y_[i] : std::max(max_y, y_[i]);
+    }
+    tree_.Reset(min_x, min_y, std::max(max_x - min_x, max_y - min_y) + 1);
+  }
+  for (uint32_t i : index_) {
+    tree_.Update(i, x_[i], y_[i], radius_[i]);
+  }
+
+  pairs_.clear();
+  for (uint32_t m = 0; m < index_.size(); ++m) {
+    uint32_t i = index_[m];
+    found_.clear();
+    tree_.Query(x_[i], y_[i], radius_[i] + skin_, &found_);
+    for (uint32_t j : found_) {
+      if (j != i) {
+        pairs_.push_back({m, j});
+      }
+    }
+  }
+  SetCandidates(&pairs_);
+  return true;
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,58 @@
+/**
+ * @file quadtree_broadphase.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_QUADTREE_BROADPHASE_H_
+#define SRC_QUADTREE_BROADPHASE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "src/broadphase.h"
+#include "src/common.h"
+#include "src/loose_quadtree.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Neighbor lists, as NeighborList, found by radius queries on a
+ * LooseQuadtree of the mobile entities rather than on a uniform grid, so that
+ * their cost holds up when entities crowd together.
+ *
+ * The tree persists and is updated as entities move; the lists are found
+ * anew only once some entity has moved skin/2.
+ */
+class QuadtreeBroadphase : public Broadphase {
+ public:
+  explicit QuadtreeBroadphase(double skin);
+
+  int get_kind() const override { return kBroadphaseQuadtree; }
+
+  const LooseQuadtree &get_tree() const { return tree_; }
+
+ protected:
+  bool Update(const std::vector<ArenaEntity *> &entities,
+              const std::vector<ArenaMobileEntity *> &mobile,
+              bool reset) override;
+
+ private:
+  LooseQuadtree tree_;
+  std::vector<uint32_t> found_;
+  std::vector<std::pair<uint32_t, uint32_t>> pairs_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_QUADTREE_BROADPHASE_H_
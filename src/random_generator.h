@@ -0,0 +1,84 @@
+/**
+ * @file random_generator.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_RANDOM_GENERATOR_H_
+#define SRC_RANDOM_GENERATOR_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <ctime>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A small pseudo-random generator whose whole state is one 64-bit word.
+ *
+ * It replaces the process-wide `random()` so that every Arena owns its own
+ * stream: the state can be written into a snapshot, copied into a cloned
+ * Arena, or seeded explicitly for reproducible runs. Next() returns values
+ * in the same [0, 2^31) range as `random()`, so call sites keep using `%`.
+ *
+ * The generator is splitmix64, which is fast and passes BigCrush.
+ */
+class RandomGenerator {
+ public:
+  /**
+   * @brief Seed from the wall clock, matching the old `srand(time(nullptr))`.
+   */
+  RandomGenerator() : state_(static_cast<uint64_t>(time(nullptr))) {}
+
+  /**
+   * @brief Seed explicitly.
+   *
+   * @param[in] seed Initial state of the stream.
+   */
+  explicit RandomGenerator(uint64_t seed) : state_(seed) {}
+
+  /**
+   * @brief Restart the stream from the given seed.
+   */
+  void Seed(uint64_t seed) { state_ = seed; }
+
+  /**
+   * @brief Return the next value in [0, 2^31).
+   */
+  long Next() {  // NOLINT(runtime/int)
+    uint64_t z = (state_ += UINT64_C(0x9E3779B97F4A7C15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    z ^= (z >> 31);
+    return static_cast<long>(z >> 33);  // NOLINT(runtime/int)
+  }
+
+  uint64_t get_state() const { return state_; }
+  void set_state(uint64_t state) { state_ = state; }
+
+  /**
+   * @brief The generator used by entities that do not belong to an Arena
+   * (e.g. those constructed directly in the unit tests).
+   */
+  static RandomGenerator *Default() {
+    static RandomGenerator generator;
+    return &generator;
+  }
+
+ private:
+  uint64_t state_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_RANDOM_GENERATOR_H_
@@ -0,0 +1,168 @@
+/**
+ * @file result_cache.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "src/binary_io.h"
+#include "src/result_cache.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Entry Format
+ ******************************************************************************/
+// "RRES" u32:key_length key u32:steps i64:starved_step u32:stopped
+// u64:checksum f64:seconds, little-endian, one file per entry.
+static const char kCacheMagic[4] = {'R', 'R', 'E', 'S'};
+static const char kCacheSuffix[] = ".res";
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+ResultCache::ResultCache() : dir_(), version_(0), lookups_(0), hits_(0) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+bool ResultCache::Open(const std::string &dir, uint32_t version) {
+  dir_ = dir;
+  version_ = version;
+  if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+    return false;
+  }
+  std::string version_path = dir + "/VERSION";
+  uint32_t found = 0;
+  std::ifstream(version_path) >> found;
+  if (found == version) {
+    return true;
+  }
+
+  // Results of another simulation version are stale; drop all of them.
+  DIR *listing = opendir(dir.c_str());
+  if (listing == nullptr) {
+    return false;
+  }
+  std::vector<std::string> stale;
+  const size_t suffix = std::strlen(kCacheSuffix);
+  while (struct dirent *entry = readdir(listing)) {
+    std::string name = entry->d_name;
+    if (name.size() > suffix &&
+        name.compare(name.size() - suffix, suffix, kCacheSuffix) == 0) {
+      stale.push_back(dir + "/" + name);
+    }
+  }
+  closedir(listing);
+  for (auto &path : stale) {
+    std::remove(path.c_str());
+  }
+  std::ofstream out(version_path, std::ios::trunc);
+  out << version << "\n";
+  return static_cast<bool>(out.flush());
+}
+
+bool ResultCache::Lookup(const arena_params &params, SweepResult *result) {
+  ++lookups_;
+  std::string key = Key(params);
+  std::vector<uint8_t> bytes;
+  if (!ReadFileBytes(Path(key), &bytes)) {
+    return false;
+  }
+  BinaryReader in(bytes.data(), bytes.size());
+  if (!in.Expect(kCacheMagic, sizeof(kCacheMagic))) {
+    return false;
+  }
+  uint32_t key_length = in.GetU32();
+  const uint8_t *stored = in.Take(key_length);
+  if (stored == nullptr || key_length != key.size() ||
+      std::memcmp(stored, key.data(), key.size()) != 0) {
+    return false;
+  }
+  SweepResult found;
+  found.steps = in.GetU32();
+  found.starved_step = static_cast<int64_t>(in.GetU64());
+  found.stopped = static_cast<StopReason>(in.GetU32());
+  found.checksum = in.GetU64();
+  found.seconds = in.GetF64();
+  if (!in.ok()) {
+    return false;
+  }
+  found.job = result->job;
+  *result = found;
+  ++hits_;
+  return true;
+}
+
+void ResultCache::Store(const arena_params &params,
+                        const SweepResult &result) {
+  std::string key = Key(params);
+  BinaryWriter out;
+  out.PutBytes(kCacheMagic, sizeof(kCacheMagic));
+  out.PutU32(static_cast<uint32_t>(key.size()));
+  out.PutBytes(key.data(), key.size());
+  out.PutU32(result.steps);
+  out.PutU64(static_cast<uint64_t>(result.starved_step));
+  out.PutU32(static_cast<uint32_t>(result.stopped));
+  out.PutU64(result.checksum);
+  out.PutF64(result.seconds);
+
+  // Readers only ever see complete entries.
+  std::string path = Path(key);
+  std::ostringstream tmp;
+  tmp << path << ".tmp" << std::hash<std::thread::id>()(
+      std::this_thread::get_id());
+  if (!out.WriteFile(tmp.str()) ||
+      std::rename(tmp.str().c_str(), path.c_str()) != 0) {
+    std::remove(tmp.str().c_str());
+  }
+}
+
+std::string ResultCache::Key(const arena_params &params) const {
+  // Floating-point values as their bits, so that every value has its own.
+  std::ostringstream key;
+  key << "version=" << version_ << " arena=" << params.x_dim << "x"
+      << params.y_dim << " robots=" << params.n_robots
+      << " lights=" << params.n_lights << " food=" << params.n_food
+      << " fear=" << params.fear_count << " sensitivity=" << std::hex
+      << BitsOf(params.light_sensitivity) << std::dec
+      << " food_on=" << params.food_on << " seed=" << params.seed
+      << " max_steps=" << params.max_steps
+      << " stop_on_starvation=" << params.stop_on_starvation
+      << " steady=" << std::hex << BitsOf(params.steady_epsilon) << std::dec
+      << "/" << params.steady_window << " sensor_range=" << std::hex
+      << BitsOf(params.sensor_range) << std::dec
+      << " sense_interval=" << params.sense_interval
+      << " relax_passes=" << params.relax_passes << " dt=" << std::hex
+      << BitsOf(params.dt) << std::dec << " ccd=" << params.ccd
+      << " adaptive_dt=" << params.adaptive_dt << "/" << std::hex
+      << BitsOf(params.dt_min);
+  return key.str();
+}
+
+std::string ResultCache::Path(const std::string &key) const {
+  std::ostringstream path;
+  path << dir_ << "/" << std::hex << std::setw(16) << std::setfill('0')
+       << Fnv1a(key.data(), key.size()) << kCacheSuffix;
+  return path.str();
+}
+
+NAMESPACE_END(csci3081);
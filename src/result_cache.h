@@ -0,0 +1,90 @@
+/**
+ * @file result_cache.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_RESULT_CACHE_H_
+#define SRC_RESULT_CACHE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "src/arena_params.h"
+#include "src/common.h"
+#include "src/params.h"
+#include "src/sweep.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief On-disk cache of sweep job results, so that re-running a sweep
+ * after an unrelated change does not re-simulate jobs already run.
+ *
+ * An entry is addressed by a hash of everything that determines a run: the
+ * canonical arena parameters, the seed, the termination conditions and
+ * SIMULATION_VERSION. Each entry is a small file holding its full key, so a
+ * hash collision is a miss rather than a wrong result. Entries are written
+ * to a temporary file and renamed into place, so several sweeps may share
+ * a cache directory.
+ *
+ * When SIMULATION_VERSION changes, the whole directory is emptied on Open().
+ */
+class ResultCache {
+ public:
+  ResultCache();
+
+  ResultCache(const ResultCache &other) = delete;
+  ResultCache &operator=(const ResultCache &other) = delete;
+
+  /**
+   * @brief Use `dir`, creating it if needed, for `version` (normally
+   * SIMULATION_VERSION). Entries of any other version are deleted.
+   *
+   * @return false if the directory cannot be created or written.
+   */
+  bool Open(const std::string &dir, uint32_t version = SIMULATION_VERSION);
+
+  /**
+   * @brief The result of running `params` (including its seed and
+   * max_steps), if cached. Safe to call from several threads.
+   */
+  bool Lookup(const arena_params &params, SweepResult *result);
+
+  /**
+   * @brief Add the result of running `params`. Safe to call from several
+   * threads; a failed write only costs a later miss.
+   */
+  void Store(const arena_params &params, const SweepResult &result);
+
+  size_t get_lookups() const { return lookups_; }
+  size_t get_hits() const { return hits_; }
+
+ private:
+  /**
+   * @brief Canonical text of everything that determines a run.
+   */
+  std::string Key(const arena_params &params) const;
+
+  std::string Path(const std::string &key) const;
+
+  std::string dir_;
+  uint32_t version_;
+  std::atomic<size_t> lookups_;
+  std::atomic<size_t> hits_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_RESULT_CACHE_H_
@@ -8,6 +8,7 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <algorithm>
 #include <cmath>
 #include "src/robot.h"
 #include "src/params.h"
@@ -27,69 +28,86 @@ NAMESPACE_BEGIN(csci3081);
  * Constructors/Destructor
  ******************************************************************************/
 Robot::Robot(int behavior) :
-    motion_handler_(),
+    motion_handler_(this),
+    fear_handler_(this),
+    explore_handler_(this),
+    aggression_handler_(this),
     motion_behavior_(this),
     lives_(9),
     time_counter_(0),
-    collision_tracker_(false),
+    step_time_(1),
     right_light_sensor_(PoseRightSensor()),
     left_light_sensor_(PoseLeftSensor()),
     right_food_sensor_(PoseRightSensor()),
     left_food_sensor_(PoseLeftSensor()),
     behavior_light_flag_(behavior),
-    hunger_tracker_(false),
     collision_timer_(0),
     sensitivity_to_light_(0.0f),
-    food_on_off_(0),
-    really_hungry_(false) {
+    own_state_(behavior % 2 == 1 ? kRobotFearsLight : 0),
+    state_(&own_state_) {
   set_type(kRobot);
   set_color(ROBOT_COLOR);
   set_pose(ROBOT_INIT_POS);
   set_heading(0);
   set_radius(ROBOT_RADIUS);
-  motion_handler_ = new MotionHandlerRobot(this);
-  motion_handler_->set_velocity(5, 5);
+  motion_handler_.set_velocity(5, 5);
 }
 /*******************************************************************************
  * Member Functions
  ******************************************************************************/
 /* Updating robot's velocity and position at each timestep. */
-void Robot::TimestepUpdate(unsigned int dt) {
-  motion_behavior_.UpdatePose(dt, motion_handler_->get_velocity());
+void Robot::TimestepUpdate(double dt) {
+  motion_behavior_.UpdatePose(dt, motion_handler_.get_velocity());
   left_light_sensor_.set_sensor_reading(0.0);
   right_light_sensor_.set_sensor_reading(0.0);
   left_food_sensor_.set_sensor_reading(0.0);
   right_food_sensor_.set_sensor_reading(0.0);
-  time_counter_ += 1;
-  RobotStateUpdate();
+  // The hunger clock runs in simulated time, however long the step.
+  time_counter_ += dt;
+  step_time_ = dt;
+  // Arcing and flickering change the robot every step. Outside of them the
+  // hunger and starvation transitions are fired by the Arena's timer wheel
+  // (see StepsToHungerCheck()).
+  if ((*state_ & kRobotArcing) ||
+      ((*state_ & kRobotHungry) && time_counter_ <= 20*120)) {
+    RobotStateUpdate();
+  } else {
+    sensor_touch_->Reset();
+  }
 } /* TimestepUpdate() */
 
 void Robot::RobotStateUpdate() {
 // Checking if the robot is currently in a state of arcing or not.
-  if (collision_tracker_) {
-    collision_timer_ += 1;
-    motion_handler_->set_velocity(6, 6);
+  if (*state_ & kRobotArcing) {
+    collision_timer_ += step_time_;
+    motion_handler_.set_velocity(6, 6);
     ArcMovement();
   }
-// Keeping track of the time for which the robot should be arcing.
-  if (collision_timer_ == 25) {
+// Keeping track of the time for which the robot should be arcing, in
+// simulated time like the hunger clock.
+  if (collision_timer_ >= 25) {
     collision_timer_ = 0;
-    collision_tracker_ = false;
+    Fire(kRobotArcDone);
   }
+  UpdateHungerState();
+  sensor_touch_->Reset();
+}
+
+void Robot::UpdateHungerState() {
 // approximately 21 timestep update corresponds to 1 second.
-// therefore 30 seconds will be equivalent to 620 timestep updates
-  if ( time_counter_ == 620 ) {
-    hunger_tracker_ = true;
-  }
-  if (food_on_off_ == 0) {  // the robot shouldn't get hungry if food is off
-    hunger_tracker_ = false;
+// therefore 30 seconds will be equivalent to 620 timestep updates; the
+// robot gets hungry in the step that brings its time counter to 620.
+  if (time_counter_ >= 620 && time_counter_ - step_time_ < 620) {
+    Fire(kRobotHungerDue);
   }
+  // the robot shouldn't get hungry if food is off
+  Fire(kRobotFoodCheck);
   /* flickering the robot lights to show robot is hungry.
   * Yellow color denotes that the robot is really hungry.
   */
-  if (hunger_tracker_) {
+  if (*state_ & kRobotHungry) {
     if ( time_counter_ < 20*120 ) {
-      if (time_counter_ % 2 == 1) {
+      if (static_cast<int64_t>(time_counter_) % 2 == 1) {
         set_color(CHANGED_ROBOT_COLOR1);
       } else {
         set_color(CHANGED_ROBOT_COLOR2);
@@ -98,14 +116,47 @@ void Robot::RobotStateUpdate() {
       set_color(CHANGED_ROBOT_COLOR3);
     }
   }
-  sensor_touch_->Reset();
+}
+
+/* The hunger state only changes when the time counter reaches 620 (hunger)
+* or 3000 (starvation), or is reset to 0 by eating. As eating only ever
+* pushes those times later, a check at most 620 ahead never misses one.
+*/
+double Robot::TimeToHungerCheck() const {
+  if (time_counter_ < 620) {
+    return 620 - time_counter_;
+  } else if (!(*state_ & kRobotHungry)) {
+    return 620;
+  } else if (time_counter_ < 20*150) {
+    return std::min(20*150 - time_counter_, 620.0);
+  }
+  return 0;
+}
+
+/* A reading sums 1200 / base^d over the sources at distances d, so its log
+* changes by at most ln(base) per unit the robot moves. Readings too weak to
+* steer by are left out.
+*/
+double Robot::SensorGradient() const {
+  double gradient = 0;
+  double light_base = left_light_sensor_.get_base_value();
+  if (light_base > 0 &&
+      std::max(left_light_sensor_.get_sensor_reading(),
+               right_light_sensor_.get_sensor_reading()) >= 1) {
+    gradient = std::fabs(std::log(light_base));
+  }
+  if (std::max(left_food_sensor_.get_sensor_reading(),
+               right_food_sensor_.get_sensor_reading()) >= 1) {
+    gradient = std::max(gradient, std::log(FOOD_BASE_VALUE));
+  }
+  return gradient;
 }
 
 void Robot::Reset() {
   set_pose(SetPoseRandomly());
-  motion_handler_->set_max_speed(ROBOT_MAX_SPEED);
-  motion_handler_->set_max_angle(ROBOT_MAX_ANGLE);
-  motion_handler_->set_velocity(5, 5);
+  motion_handler_.set_max_speed(ROBOT_MAX_SPEED);
+  motion_handler_.set_max_angle(ROBOT_MAX_ANGLE);
+  motion_handler_.set_velocity(5, 5);
   set_radius(SetRadiusRandomlyRobot());
   sensor_touch_->Reset();
   set_color(ROBOT_COLOR);
@@ -119,37 +170,78 @@ void Robot::Reset() {
   left_food_sensor_.set_sensor_reading(0.0);
   // lives_ = 9;
   time_counter_ = 0;
-  collision_tracker_ = false;
-  hunger_tracker_ = false;
+  Fire(kRobotReset);
   collision_timer_ = 0;
 } /* Reset() */
 
+void Robot::SaveState(EntityState *state) const {
+  ArenaMobileEntity::SaveState(state);
+  WheelVelocity v = motion_handler_.get_velocity();
+  state->vel_left = v.left;
+  state->vel_right = v.right;
+  if (*state_ & kRobotArcing) state->flags |= kStateArcing;
+  if (*state_ & kRobotHungry) state->flags |= kStateHungry;
+  if (*state_ & kRobotReallyHungry) state->flags |= kStateReallyHungry;
+  state->lives = lives_;
+  state->time_counter = time_counter_;
+  state->collision_timer = collision_timer_;
+  state->behavior_flag = behavior_light_flag_;
+  state->food_on_off = get_food_on_off();
+  state->light_base = left_light_sensor_.get_base_value();
+  state->left_light_reading = left_light_sensor_.get_sensor_reading();
+  state->right_light_reading = right_light_sensor_.get_sensor_reading();
+  state->left_food_reading = left_food_sensor_.get_sensor_reading();
+  state->right_food_reading = right_food_sensor_.get_sensor_reading();
+} /* SaveState() */
+
+void Robot::LoadState(const EntityState &state) {
+  ArenaMobileEntity::LoadState(state);
+  motion_handler_.set_velocity(state.vel_left, state.vel_right);
+  lives_ = state.lives;
+  time_counter_ = state.time_counter;
+  collision_timer_ = state.collision_timer;
+  *state_ = 0;
+  if (state.flags & kStateArcing) Fire(kRobotCollided);
+  if (state.flags & kStateHungry) Fire(kRobotHungerDue);
+  if (state.flags & kStateReallyHungry) Fire(kRobotGotReallyHungry);
+  set_behavior_flag(state.behavior_flag);
+  set_food_on_off(state.food_on_off);
+  set_sensitivity_to_light(state.light_base);
+  left_light_sensor_.set_sensor_reading(state.left_light_reading);
+  right_light_sensor_.set_sensor_reading(state.right_light_reading);
+  left_food_sensor_.set_sensor_reading(state.left_food_reading);
+  right_food_sensor_.set_sensor_reading(state.right_food_reading);
+  // Sensor positions are not restored: they are recomputed from the pose
+  // before every use.
+  sensor_touch_->Reset();
+} /* LoadState() */
+
 
 // Handling collisions of robots with other entities and walls
 void Robot::HandleCollision(EntityType object_type, ArenaEntity * object) {
   switch (object_type) {
     case (kTopWall) : sensor_touch_->HandleCollision(object_type, object);
-    collision_tracker_ = true;
+    Fire(kRobotCollided);
     collision_timer_ = 0;
     (this)->RelativeChangeHeading(170);
     break;
     case (kBottomWall) : sensor_touch_->HandleCollision(object_type, object);
-    collision_tracker_ = true;
+    Fire(kRobotCollided);
     collision_timer_ = 0;
     (this)->RelativeChangeHeading(170);
     break;
     case (kLeftWall) : sensor_touch_->HandleCollision(object_type, object);
-    collision_tracker_ = true;
+    Fire(kRobotCollided);
     collision_timer_ = 0;
     (this)->RelativeChangeHeading(170);
     break;
     case (kRightWall) : sensor_touch_->HandleCollision(object_type, object);
-    collision_tracker_ = true;
+    Fire(kRobotCollided);
     collision_timer_ = 0;
     (this)->RelativeChangeHeading(170);
     break;
     case (kRobot) : sensor_touch_->HandleCollision(object_type, object);
-    collision_tracker_ = true;
+    Fire(kRobotCollided);
     collision_timer_ = 0;
     (this)->RelativeChangeHeading(170);
     break;
@@ -157,25 +249,31 @@ void Robot::HandleCollision(EntityType object_type, ArenaEntity * object) {
   }
 }
 
+void Robot::HandleWallCollision(uint8_t walls) {
+  if (walls != 0) {
+    HandleCollision(FirstWall(walls));
+  }
+}
+
 void Robot::IncreaseSpeed() {
-  motion_handler_->IncreaseSpeed();
+  motion_handler_.IncreaseSpeed();
 }
 
 void Robot::DecreaseSpeed() {
-  motion_handler_->DecreaseSpeed();
+  motion_handler_.DecreaseSpeed();
 }
 
 void Robot::TurnRight() {
-  motion_handler_->TurnRight();
+  motion_handler_.TurnRight();
 }
 
 void Robot::TurnLeft() {
-  motion_handler_->TurnLeft();
+  motion_handler_.TurnLeft();
 }
 
 // Function that gives robot it's arc movement.
 void Robot::ArcMovement() {
-  motion_handler_->IncreaseSpeed();
+  motion_handler_.IncreaseSpeed();
   left_light_sensor_.set_sensor_position(PoseLeftSensor());
   right_light_sensor_.set_sensor_position(PoseRightSensor());
   left_food_sensor_.set_sensor_position(PoseLeftSensor());
@@ -188,62 +286,137 @@ void Robot::ArcMovement() {
 // motion.
 void Robot::RobotDecideMotion(EntityType object_type,
                                                ArenaEntity * ent) {
-  right_light_sensor_.set_sensor_position(PoseRightSensor());
-  left_food_sensor_.set_sensor_position(PoseLeftSensor());
-  right_food_sensor_.set_sensor_position(PoseRightSensor());
-  left_light_sensor_.set_sensor_position(PoseLeftSensor());
+  PlaceSensors();
   switch (object_type) {
-    case (kLight) : if (!really_hungry_) {  // Robot reacts to light only
-    // till the point when it is not really hungry.
-    left_light_sensor_.CalculateSensorReading(ent->get_pose());
-    right_light_sensor_.CalculateSensorReading(ent->get_pose());
-    double l = left_light_sensor_.get_sensor_reading();
-    double r = right_light_sensor_.get_sensor_reading();
-    if (behavior_light_flag_ % 2 == 1) {  // Checking if the robot fears light
-      // or explores light and then taking the appropriate plan of action.
-      MotionHandlerFear *fear
-          = new MotionHandlerFear(this);
-      WheelVelocity v = fear->UpdateVelocity(l, r,
-                         motion_handler_->get_velocity());
-      motion_handler_->set_velocity(v);
-    } else {
-      MotionHandlerExploratory *explore
-          = new MotionHandlerExploratory(this);
-      WheelVelocity v = explore->UpdateVelocity(l, r,
-                         motion_handler_->get_velocity());
-      motion_handler_->set_velocity(v);
+    case (kLight) : {
+    // Robot reacts to light only till the point when it is not really hungry,
+    // by fearing or exploring it as its state says.
+    RobotLightResponse response = RobotRespondsToLight(*state_);
+    if (response != kLightIgnore) {
+      SenseLight(response, ent);
     }
     }
     break;
     case (kFood) : if (IsFoodConsumed(ent)) {  // checking if the food has been
     // consumed.
-    hunger_tracker_ = false;
-    time_counter_ = 0;
-    set_color(ROBOT_COLOR);
-    motion_handler_->set_velocity(5, 5);
-  } else if (hunger_tracker_) {  // checking if the robot needs to be aggressive
-    // or not.
-    left_food_sensor_.CalculateSensorReading(ent->get_pose());
-    right_food_sensor_.CalculateSensorReading(ent->get_pose());
-    double l = left_food_sensor_.get_sensor_reading();
-    double r = right_food_sensor_.get_sensor_reading();
-    MotionHandlerAggression *aggression
-        = new MotionHandlerAggression(this);
-    WheelVelocity v = aggression->UpdateVelocity(l, r,
-                       motion_handler_->get_velocity());
-    motion_handler_->set_velocity(v);
+    Eat();
+  } else if (RobotChasesFood(*state_)) {  // checking if the robot needs to
+    // be aggressive or not.
+    ChaseFood(ent);
     }
     break;
     default : break;
   }
   // To ensure proper movement of the robot when it is either hungry or arcing.
-  if (hunger_tracker_ || collision_tracker_) {
-    motion_handler_->set_velocity(
-      motion_handler_->clamp_vel
-          (motion_handler_->get_velocity().left+5.0),
-      motion_handler_->clamp_vel
-          (motion_handler_->get_velocity().left+5.0));
+  if (RobotSpeedsUp(*state_)) {
+    SpeedUp();
+  }
+}
+
+size_t Robot::SenseEntities(ArenaEntity *const *entities, size_t n) {
+  typedef size_t (Robot::*Kernel)(ArenaEntity *const *, size_t);
+  // In RobotSenseClass() order.
+  static const Kernel kKernels[kRobotSenseClasses] = {
+    &Robot::SenseKernel<kLightIgnore, kDriveCruise>,
+    &Robot::SenseKernel<kLightIgnore, kDriveArcing>,
+    &Robot::SenseKernel<kLightIgnore, kDriveHungry>,
+    &Robot::SenseKernel<kLightFear, kDriveCruise>,
+    &Robot::SenseKernel<kLightFear, kDriveArcing>,
+    &Robot::SenseKernel<kLightFear, kDriveHungry>,
+    &Robot::SenseKernel<kLightExplore, kDriveCruise>,
+    &Robot::SenseKernel<kLightExplore, kDriveArcing>,
+    &Robot::SenseKernel<kLightExplore, kDriveHungry>,
+  };
+  return (this->*kKernels[RobotSenseClass(*state_)])(entities, n);
+}
+
+// The pose does not change while the robot senses, so the sensors are placed
+// once for the whole range.
+template <RobotLightResponse kResponse, RobotDrive kDrive>
+size_t Robot::SenseKernel(ArenaEntity *const *entities, size_t n) {
+  PlaceSensors();
+  for (size_t i = 0; i < n; ++i) {
+    ArenaEntity *ent = entities[i];
+    EntityType type = ent->get_type();
+    if (type == kLight) {
+      if (kResponse != kLightIgnore) {
+        SenseLight(kResponse, ent);
+      }
+    } else if (type == kFood) {
+      if (IsFoodConsumed(ent)) {
+        Eat();
+        // Eating ends hunger, and with it this kernel.
+        if (kDrive == kDriveHungry) {
+          if (RobotSpeedsUp(*state_)) {
+            SpeedUp();
+          }
+          return i + 1;
+        }
+      } else if (kDrive == kDriveHungry) {
+        ChaseFood(ent);
+      }
     }
+    if (kDrive != kDriveCruise) {
+      SpeedUp();
+    }
+  }
+  return n;
+}
+
+void Robot::PlaceSensors() {
+  right_light_sensor_.set_sensor_position(PoseRightSensor());
+  left_food_sensor_.set_sensor_position(PoseLeftSensor());
+  right_food_sensor_.set_sensor_position(PoseRightSensor());
+  left_light_sensor_.set_sensor_position(PoseLeftSensor());
+}
+
+void Robot::SenseLight(RobotLightResponse response, ArenaEntity *ent) {
+  left_light_sensor_.CalculateSensorReading(ent->get_pose());
+  right_light_sensor_.CalculateSensorReading(ent->get_pose());
+  RespondToLight(response);
+}
+
+void Robot::SenseLightReadings(double left, double right) {
+  left_light_sensor_.set_sensor_reading(left);
+  right_light_sensor_.set_sensor_reading(right);
+  RobotLightResponse response = RobotRespondsToLight(*state_);
+  if (response != kLightIgnore && (left > 0 || right > 0)) {
+    RespondToLight(response);
+  }
+}
+
+void Robot::RespondToLight(RobotLightResponse response) {
+  double l = left_light_sensor_.get_sensor_reading();
+  double r = right_light_sensor_.get_sensor_reading();
+  WheelVelocity v = response == kLightFear ?
+      fear_handler_.UpdateVelocity(l, r, motion_handler_.get_velocity()) :
+      explore_handler_.UpdateVelocity(l, r, motion_handler_.get_velocity());
+  motion_handler_.set_velocity(v);
+}
+
+void Robot::ChaseFood(ArenaEntity *ent) {
+  left_food_sensor_.CalculateSensorReading(ent->get_pose());
+  right_food_sensor_.CalculateSensorReading(ent->get_pose());
+  double l = left_food_sensor_.get_sensor_reading();
+  double r = right_food_sensor_.get_sensor_reading();
+  WheelVelocity v = aggression_handler_.UpdateVelocity(l, r,
+                     motion_handler_.get_velocity());
+  motion_handler_.set_velocity(v);
+}
+
+void Robot::Eat() {
+  Fire(kRobotAte);
+  time_counter_ = 0;
+  set_color(ROBOT_COLOR);
+  motion_handler_.set_velocity(5, 5);
+}
+
+void Robot::SpeedUp() {
+  motion_handler_.set_velocity(
+    motion_handler_.clamp_vel
+        (motion_handler_.get_velocity().left+5.0),
+    motion_handler_.clamp_vel
+        (motion_handler_.get_velocity().left+5.0));
 }
 
 /* Robot is very hungry if it has not consumed food for 2 mins. Returns true if
@@ -252,21 +425,21 @@ void Robot::RobotDecideMotion(EntityType object_type,
 bool Robot::RobotReallyHungry() {
   // 21 timestep update corresponds to approximately 1 second. So in 2 mins,
   // number of timestep update will be 21*120 second.
-  if (time_counter_ >= 20*120 && hunger_tracker_) {
-    motion_handler_->set_velocity(7, 7);
-    really_hungry_ = true;
+  if (time_counter_ >= 20*120 && (*state_ & kRobotHungry)) {
+    motion_handler_.set_velocity(7, 7);
+    Fire(kRobotGotReallyHungry);
   } else {
-    really_hungry_ = false;
+    Fire(kRobotNotReallyHungry);
   }
-  return really_hungry_;
+  return (*state_ & kRobotReallyHungry) != 0;
 }
 /* Robot is starving if it has not consumed food for 2.5 mins. Returns true
 * if robot is starving else false.
 */
-bool Robot::RobotStarving() {
+bool Robot::RobotStarving() const {
   // 21 timestep update corresponds to approximately 1 second. So in 2 mins,
   // number of timestep update will be 21*150 second.
-  return time_counter_ >= 20*150 && hunger_tracker_;
+  return time_counter_ >= 20*150 && (*state_ & kRobotHungry);
 }
 
 /* Calculates the distance between food and robot to check if robot
@@ -281,6 +454,12 @@ bool Robot::IsFoodConsumed(ArenaEntity * const other_e) {
                                             other_e->get_radius()+5.0));
 }
 
+void Robot::BindState(uint8_t *slot) {
+  uint8_t state = *state_;
+  state_ = slot != nullptr ? slot : &own_state_;
+  *state_ = state;
+}
+
 void Robot::set_sensitivity_to_light(float lsensor_base) {
   left_light_sensor_.set_base_value(lsensor_base);
   right_light_sensor_.set_base_value(lsensor_base);
@@ -10,6 +10,8 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 #include "src/arena_mobile_entity.h"
@@ -20,6 +22,9 @@
 #include "src/light_sensor.h"
 #include "src/food_sensor.h"
 #include "src/motion_handler_aggression.h"
+#include "src/motion_handler_exploratory.h"
+#include "src/motion_handler_fear.h"
+#include "src/robot_fsm.h"
 /*******************************************************************************
  * Namespaces
  ******************************************************************************/
@@ -52,8 +57,13 @@ class Robot : public ArenaMobileEntity {
    */
 
   explicit Robot(int behavior);
-  Robot(const Robot& other) = default;
-  Robot& operator=(const Robot& other) = default;
+
+  /**
+   * @brief Robots are not copied: a copy would share the original's state
+   * byte (see BindState()). Arena::Clone() copies them through SaveState().
+   */
+  Robot(const Robot& other) = delete;
+  Robot& operator=(const Robot& other) = delete;
 
   /**
    * @brief Default destructor.
@@ -66,13 +76,25 @@ class Robot : public ArenaMobileEntity {
    */
   void Reset() override;
 
+  /**
+   * @brief Add the wheel velocities, timers, hunger flags and sensor values
+   * to the base entity record.
+   */
+  void SaveState(EntityState *state) const override;
+
+  /**
+   * @brief Restore everything written by SaveState().
+   */
+  void LoadState(const EntityState &state) override;
+
   /**
    * @brief Update the Robot's position and velocity after the specified
    * duration has passed.
    *
-   * @param dt The # of timesteps that have elapsed since the last update.
+   * @param dt The time the step moves the Robot by, in the units of its
+   * speed (see arena_params::dt).
    */
-  void TimestepUpdate(unsigned int dt) override;
+  void TimestepUpdate(double dt) override;
 
   /**
    * @brief This method checks for what behavior state the robot is in
@@ -87,6 +109,28 @@ class Robot : public ArenaMobileEntity {
    * the robot will never be in a hungry state.
    */
   void RobotStateUpdate();
+
+  /**
+   * @brief The part of RobotStateUpdate() driven by the time counter: getting
+   * hungry, losing hunger when food is off, and the hunger colors. Running
+   * it more than once in a step has no further effect.
+   */
+  void UpdateHungerState();
+
+  /**
+   * @brief Simulated time until UpdateHungerState() next needs to run
+   * outside of the arcing and flickering phases, which run it every step,
+   * so that the Arena can schedule it (and the starvation check) on a
+   * TimerWheel. Running it sooner is harmless.
+   */
+  double TimeToHungerCheck() const;
+
+  /**
+   * @brief The largest rate, per unit of distance the robot moves, at which
+   * the natural log of any of its sensor readings changes: how fast what it
+   * senses changes under it.
+   */
+  double SensorGradient() const;
   /**
    * @brief Handles the collision by setting the sensor to activated.
    *
@@ -95,6 +139,12 @@ class Robot : public ArenaMobileEntity {
    */
   void HandleCollision(EntityType object_type, ArenaEntity * object = NULL);
 
+  /**
+   * @brief Handles touching the walls in `walls` (WallBit()s) as a collision
+   * with the first of them.
+   */
+  void HandleWallCollision(uint8_t walls) override;
+
   /**
    * @brief Get the name of the Robot for visualization and for debugging.
    */
@@ -124,7 +174,10 @@ class Robot : public ArenaMobileEntity {
 
   void set_lives(int l) { lives_ = l; }
 
-  MotionHandlerRobot *get_motion_handler() {return motion_handler_;}
+  MotionHandlerRobot *get_motion_handler() {return &motion_handler_;}
+  WheelVelocity get_wheel_velocity() const override {
+    return motion_handler_.get_velocity();
+  }
   MotionBehaviorDifferential *get_motion_behavior() {return &motion_behavior_;}
   /**
   * @brief Generates radius for robots randomly in the range 8-14
@@ -132,26 +185,32 @@ class Robot : public ArenaMobileEntity {
   */
   double SetRadiusRandomlyRobot() {
     // returning a number between 8 and 14
-    return static_cast<int> (8+(random()%(14-8+1)));
+    return static_cast<int>
+        (8+(get_random_generator()->Next()%(14-8+1)));
   }
 
+  /**
+  * @brief Position of a sensor on the rim of a robot with the given pose and
+  * radius, `offset` away from its heading. Shared with the replay viewer,
+  * which draws robots without a Robot object.
+  */
+  static Pose SensorPose(const Pose &pose, double radius, double offset) {
+    double angle_ = pose.theta + offset;
+    double x_ = radius*cos(angle_) + pose.x;
+    double y_ = radius*sin(angle_) + pose.y;
+    return {x_, y_};
+  }
   /**
   * @brief Updating the left sensor position at each timestep.
   */
   Pose PoseLeftSensor() const {
-    double angle_ = (this)->get_heading() + (-40.0*M_PI/180.0);
-    double x_ = (this)->get_radius()*cos(angle_) + (this)->get_pose().x;
-    double y_ = (this)->get_radius()*sin(angle_) + (this)->get_pose().y;
-    return {x_, y_};
+    return SensorPose(get_pose(), get_radius(), -40.0*M_PI/180.0);
   }
   /**
   * @brief Updating the right sensor position at each timestep.
   */
   Pose PoseRightSensor() const {
-    double angle_ = (this)->get_heading() + (40.0*M_PI/180.0);
-    double x_ = (this)->get_radius()*cos(angle_) + (this)->get_pose().x;
-    double y_ = (this)->get_radius()*sin(angle_) + (this)->get_pose().y;
-    return {x_, y_};
+    return SensorPose(get_pose(), get_radius(), 40.0*M_PI/180.0);
   }
 
   /**
@@ -184,7 +243,7 @@ class Robot : public ArenaMobileEntity {
   * @brief Returns true if the robot is starving i.e. robot hasn't consumed food
   * for 2.5 mins.
   */
-  bool RobotStarving();
+  bool RobotStarving() const;
 
   /**
   * @brief Robot gets the entity from the arena and then based on its behavior
@@ -196,6 +255,23 @@ class Robot : public ArenaMobileEntity {
   */
   void RobotDecideMotion(EntityType object_type, ArenaEntity * object = NULL);
 
+  /**
+   * @brief RobotDecideMotion() for each of the `n` entities in turn, by the
+   * sensing kernel of the robot's sense class (see RobotSenseClass()), which
+   * has the class's choices made at compile time.
+   *
+   * @return The number of entities sensed: fewer than `n` if eating changed
+   * the class part way, in which case the caller goes on from there.
+   */
+  size_t SenseEntities(ArenaEntity *const *entities, size_t n);
+
+  /**
+   * @brief Take `left` and `right` as the light readings of this step, in
+   * place of sensing every light, and respond to them as sensing would
+   * have (see SenseDecimation).
+   */
+  void SenseLightReadings(double left, double right);
+
   /**
    * @brief Determine if the robot has consumed that food entity. If the robot
    * is within 5 pixels of the food, then it means it has consumed the food.
@@ -209,7 +285,10 @@ class Robot : public ArenaMobileEntity {
     *
     * @brief Setter for the behavior_light_flag_ of robot.
     */
-    void set_behavior_flag(int lbehavior) { behavior_light_flag_ = lbehavior; }
+    void set_behavior_flag(int lbehavior) {
+      behavior_light_flag_ = lbehavior;
+      Fire(lbehavior % 2 == 1 ? kRobotSetFear : kRobotSetExplore);
+    }
 
     /**
     * @brief Function returns the behavior light flag that is if the robot
@@ -232,30 +311,89 @@ class Robot : public ArenaMobileEntity {
     * If fonoff is 1, then food is on else food is off if fonoff is 0.
     */
     void set_food_on_off(int fonoff) {
-      food_on_off_ = fonoff;
+      Fire(fonoff != 0 ? kRobotSetFoodOn : kRobotSetFoodOff);
     }
+    int get_food_on_off() const { return (*state_ & kRobotFoodOn) ? 1 : 0; }
     /**
     * @brief Setter for ReallyHungry only needed for the unit tests.
     *
     * @param[in] reallyhungry Specifies very hungry or not
     */
     void set_really_hungry(bool reallyhungry) {
-      really_hungry_ = reallyhungry;
+      Fire(reallyhungry ? kRobotGotReallyHungry : kRobotNotReallyHungry);
   }
 
+  /**
+   * @brief The robot's behavior state (see RobotStateBit).
+   */
+  uint8_t get_state() const { return *state_; }
+
+  /**
+   * @brief Keep the behavior state in `slot` from now on, e.g. the Arena's
+   * array of robot states, or in the robot itself if nullptr.
+   */
+  void BindState(uint8_t *slot);
+
  private:
+  /**
+   * @brief Apply `event` to the behavior state (see RobotTransition()).
+   */
+  void Fire(RobotEvent event) { *state_ = RobotTransition(*state_, event); }
+
+  /**
+   * @brief SenseEntities() for robots that respond to lights with
+   * `kResponse` and are driven by `kDrive`.
+   */
+  template <RobotLightResponse kResponse, RobotDrive kDrive>
+  size_t SenseKernel(ArenaEntity *const *entities, size_t n);
+
+  /**
+   * @brief Move the sensors to where the robot's pose puts them.
+   */
+  void PlaceSensors();
+
+  /**
+   * @brief Sense light `ent` and respond to it with `response`.
+   */
+  void SenseLight(RobotLightResponse response, ArenaEntity *ent);
+
+  /**
+   * @brief Set the wheels from the light readings with `response`.
+   */
+  void RespondToLight(RobotLightResponse response);
+
+  /**
+   * @brief Sense food `ent` and chase it.
+   */
+  void ChaseFood(ArenaEntity *ent);
+
+  /**
+   * @brief Reset the hunger clock after eating.
+   */
+  void Eat();
+
+  /**
+   * @brief Push both wheels towards full speed, as a hungry or arcing robot
+   * does after sensing each entity.
+   */
+  void SpeedUp();
+
   // Manages pose and wheel velocities that change with time and collisions.
-  MotionHandlerRobot* motion_handler_;
+  MotionHandlerRobot motion_handler_;
+  // Sensor-motor connections for each reaction to a stimulus, created once
+  // rather than on every sensor reading.
+  MotionHandlerFear fear_handler_;
+  MotionHandlerExploratory explore_handler_;
+  MotionHandlerAggression aggression_handler_;
   // Calculates changes in pose foodd on elapsed time and wheel velocities.
   MotionBehaviorDifferential motion_behavior_;
   // Lives are decremented when the robot collides with anything.
   // When all the lives are gone, the game is lost.
   int lives_;
-  // Keeps track of the time that has elapsed since last meal.
-  int time_counter_;
-  // Keeps track of if robot has collided with light or not and this is used
-  // to implement mercy invincibility.
-  bool collision_tracker_;
+  // Keeps track of the simulated time that has elapsed since last meal, and
+  // the time the last step added to it.
+  double time_counter_;
+  double step_time_;
   // Manages the left and right light sensors.
   LightSensor right_light_sensor_;
   LightSensor left_light_sensor_;
@@ -265,16 +403,14 @@ class Robot : public ArenaMobileEntity {
   // Keeping track of behavior of robot towards light,
   // even mean exploratory behavior, odd means fearful behavior
   int behavior_light_flag_;
-  // Keeps track of if robot is hungry or not.
-  bool hunger_tracker_;
-  // Keeps track of the time passed between collision.
-  int collision_timer_;
+  // Simulated time spent arcing since the last collision.
+  double collision_timer_;
   // Sensitivity to light
   float sensitivity_to_light_;
-  // food on or off, 1 means on, 0 means off
-  int food_on_off_;
-  // ReallyHungry flag
-  bool really_hungry_;
+  // Arcing, hunger, light behavior and food on/off, as RobotStateBit bits.
+  // state_ points at own_state_ unless the robot is bound to an Arena.
+  uint8_t own_state_;
+  uint8_t *state_;
 };
 
 NAMESPACE_END(csci3081);
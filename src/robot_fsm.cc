@@ -0,0 +1,96 @@
+/**
+ * @file robot_fsm.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/robot_fsm.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Transition Rules
+ ******************************************************************************/
+// A rule applies to its event in every state that has all of `require` and
+// none of `forbid`, clearing then setting bits. Events in states no rule
+// matches change nothing.
+struct RobotRule {
+  RobotEvent event;
+  uint8_t require;
+  uint8_t forbid;
+  uint8_t clear;
+  uint8_t set;
+};
+
+static const RobotRule kRobotRules[] = {
+  // event, require, forbid, clear, set
+  {kRobotCollided, 0, 0, 0, kRobotArcing},
+  {kRobotArcDone, 0, 0, kRobotArcing, 0},
+  {kRobotHungerDue, 0, 0, 0, kRobotHungry},
+  {kRobotFoodCheck, 0, kRobotFoodOn, kRobotHungry, 0},
+  {kRobotAte, 0, 0, kRobotHungry, 0},
+  {kRobotGotReallyHungry, 0, 0, 0, kRobotReallyHungry},
+  {kRobotNotReallyHungry, 0, 0, kRobotReallyHungry, 0},
+  {kRobotSetFear, 0, 0, 0, kRobotFearsLight},
+  {kRobotSetExplore, 0, 0, kRobotFearsLight, 0},
+  {kRobotSetFoodOn, 0, 0, 0, kRobotFoodOn},
+  {kRobotSetFoodOff, 0, 0, kRobotFoodOn, 0},
+  {kRobotReset, 0, 0, kRobotArcing | kRobotHungry, 0},
+};
+
+/*******************************************************************************
+ * Lookup Tables
+ ******************************************************************************/
+struct RobotFsmTables {
+  RobotFsmTables() : next(), light(), sense() {
+    for (int e = 0; e < kRobotEventCount; ++e) {
+      for (int s = 0; s < kRobotStates; ++s) {
+        next[e][s] = static_cast<uint8_t>(s);
+      }
+    }
+    for (auto &rule : kRobotRules) {
+      for (int s = 0; s < kRobotStates; ++s) {
+        if ((s & rule.require) == rule.require && (s & rule.forbid) == 0) {
+          next[rule.event][s] =
+              static_cast<uint8_t>((s & ~rule.clear) | rule.set);
+        }
+      }
+    }
+    for (int s = 0; s < kRobotStates; ++s) {
+      light[s] = (s & kRobotReallyHungry) ? kLightIgnore :
+                 (s & kRobotFearsLight) ? kLightFear : kLightExplore;
+      RobotDrive drive = (s & kRobotHungry) ? kDriveHungry :
+                         (s & kRobotArcing) ? kDriveArcing : kDriveCruise;
+      sense[s] = static_cast<uint8_t>(light[s] * kRobotDrives + drive);
+    }
+  }
+
+  uint8_t next[kRobotEventCount][kRobotStates];
+  RobotLightResponse light[kRobotStates];
+  uint8_t sense[kRobotStates];
+};
+
+static const RobotFsmTables kRobotFsm;
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+uint8_t RobotTransition(uint8_t state, RobotEvent event) {
+  return kRobotFsm.next[event][state];
+}
+
+RobotLightResponse RobotRespondsToLight(uint8_t state) {
+  return kRobotFsm.light[state];
+}
+
+uint8_t RobotSenseClass(uint8_t state) {
+  return kRobotFsm.sense[state];
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,124 @@
+/**
+ * @file robot_fsm.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_ROBOT_FSM_H_
+#define SRC_ROBOT_FSM_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+/**
+ * @brief Bits of a robot's behavior state. Together they fit in one byte,
+ * so the Arena keeps every robot's state in one contiguous array.
+ */
+enum RobotStateBit : uint8_t {
+  kRobotArcing = 1 << 0,        // turning away after a collision
+  kRobotHungry = 1 << 1,        // 620 time units since the last meal
+  kRobotReallyHungry = 1 << 2,  // ignores lights
+  kRobotFearsLight = 1 << 3,    // otherwise explores lights
+  kRobotFoodOn = 1 << 4,        // may get hungry at all
+};
+
+// Number of distinct robot states.
+const int kRobotStates = 1 << 5;
+
+/**
+ * @brief Everything that changes a robot's behavior state.
+ */
+enum RobotEvent {
+  kRobotCollided = 0,    // hit a wall or another robot
+  kRobotArcDone,         // arced for 25 time units
+  kRobotHungerDue,       // 620 time units since the last meal
+  kRobotFoodCheck,       // every state update: no hunger without food
+  kRobotAte,
+  kRobotGotReallyHungry,
+  kRobotNotReallyHungry,
+  kRobotSetFear,
+  kRobotSetExplore,
+  kRobotSetFoodOn,
+  kRobotSetFoodOff,
+  kRobotReset,           // the GUI's new game
+  kRobotEventCount
+};
+
+/**
+ * @brief Which handler, if any, drives a robot's wheels when it senses a
+ * light.
+ */
+enum RobotLightResponse : uint8_t {
+  kLightIgnore = 0,
+  kLightFear,
+  kLightExplore,
+};
+
+/**
+ * @brief What, besides lights, drives a robot's wheels when it senses.
+ */
+enum RobotDrive : uint8_t {
+  kDriveCruise = 0,  // nothing: food is only eaten
+  kDriveArcing,      // pushed to full speed after every entity
+  kDriveHungry,      // chases food, and pushed to full speed
+};
+
+// Number of RobotDrive values.
+const int kRobotDrives = 3;
+
+// Number of sense classes: a light response and a drive (see
+// RobotSenseClass()).
+const int kRobotSenseClasses = 3 * kRobotDrives;
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief The state after `event` in `state`.
+ *
+ * Transitions come from a short rule table (see robot_fsm.cc), expanded
+ * once into a lookup table of every event in every state.
+ */
+uint8_t RobotTransition(uint8_t state, RobotEvent event);
+
+/**
+ * @brief How a robot in `state` responds to lights.
+ */
+RobotLightResponse RobotRespondsToLight(uint8_t state);
+
+/**
+ * @brief The sense class of a robot in `state`: robots of one class sense
+ * every entity the same way, as RobotRespondsToLight() * kRobotDrives +
+ * its RobotDrive.
+ */
+uint8_t RobotSenseClass(uint8_t state);
+
+/**
+ * @brief Whether a robot in `state` chases food it senses.
+ */
+inline bool RobotChasesFood(uint8_t state) {
+  return (state & kRobotHungry) != 0;
+}
+
+/**
+ * @brief Whether a robot in `state` is pushed to full speed after sensing.
+ */
+inline bool RobotSpeedsUp(uint8_t state) {
+  return (state & (kRobotHungry | kRobotArcing)) != 0;
+}
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_ROBOT_FSM_H_
@@ -0,0 +1,92 @@
+/**
+ * @file robot_partition.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <utility>
+
+#include "src/robot_partition.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+RobotPartition::RobotPartition()
+    : order_(), position_(), class_(), start_(kRobotSenseClasses + 1, 0) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+// A counting sort by class, which keeps robot order within each class.
+void RobotPartition::Reset(const std::vector<uint8_t> &states) {
+  size_t n = states.size();
+  class_.resize(n);
+  start_.assign(kRobotSenseClasses + 1, 0);
+  for (size_t i = 0; i < n; ++i) {
+    class_[i] = RobotSenseClass(states[i]);
+    ++start_[class_[i] + 1];
+  }
+  for (int c = 0; c < kRobotSenseClasses; ++c) {
+    start_[c + 1] += start_[c];
+  }
+  std::vector<size_t> next(start_.begin(), start_.end() - 1);
+  order_.resize(n);
+  position_.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    size_t pos = next[class_[i]]++;
+    order_[pos] = static_cast<uint32_t>(i);
+    position_[i] = static_cast<uint32_t>(pos);
+  }
+}
+
+size_t RobotPartition::Update(const std::vector<uint8_t> &states) {
+  if (states.size() != class_.size()) {
+    Reset(states);
+    return states.size();
+  }
+  size_t moved = 0;
+  for (size_t i = 0; i < states.size(); ++i) {
+    uint8_t cls = RobotSenseClass(states[i]);
+    if (cls != class_[i]) {
+      Move(static_cast<uint32_t>(i), cls);
+      ++moved;
+    }
+  }
+  return moved;
+}
+
+// The robot walks one class at a time towards `cls`, each step swapping it
+// with the robot at the near end of the next class and moving that class's
+// boundary past it.
+void RobotPartition::Move(uint32_t index, uint8_t cls) {
+  size_t pos = position_[index];
+  for (int c = class_[index]; c < cls; ++c) {
+    size_t last = start_[c + 1] - 1;
+    Swap(pos, last);
+    --start_[c + 1];
+    pos = last;
+  }
+  for (int c = class_[index]; c > cls; --c) {
+    size_t first = start_[c];
+    Swap(pos, first);
+    ++start_[c];
+    pos = first;
+  }
+  class_[index] = cls;
+}
+
+void RobotPartition::Swap(size_t a, size_t b) {
+  std::swap(order_[a], order_[b]);
+  position_[order_[a]] = static_cast<uint32_t>(a);
+  position_[order_[b]] = static_cast<uint32_t>(b);
+}
+
+NAMESPACE_END(csci3081);
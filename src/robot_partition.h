@@ -0,0 +1,91 @@
+/**
+ * @file robot_partition.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_ROBOT_PARTITION_H_
+#define SRC_ROBOT_PARTITION_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "src/common.h"
+#include "src/robot_fsm.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief The robots' indices, ordered so that the robots of each sense class
+ * (see RobotSenseClass()) form one contiguous range, so that a loop over the
+ * order runs each sensing kernel over all of its robots back to back.
+ *
+ * Update() keeps the order partitioned as states change, moving only the
+ * robots whose class changed, each by at most one swap per class boundary.
+ * Robots within a class are in no particular order.
+ */
+class RobotPartition {
+ public:
+  RobotPartition();
+
+  /**
+   * @brief Partition the robots with behavior states `states` afresh.
+   */
+  void Reset(const std::vector<uint8_t> &states);
+
+  /**
+   * @brief Move every robot whose class differs from when it was last
+   * partitioned into the range of its new class.
+   *
+   * @return The number of robots moved.
+   */
+  size_t Update(const std::vector<uint8_t> &states);
+
+  /**
+   * @brief Robot indices, class by class.
+   */
+  const std::vector<uint32_t> &order() const { return order_; }
+
+  /**
+   * @brief The range of order() holding the robots of class `cls`.
+   */
+  size_t begin(int cls) const { return start_[cls]; }
+  size_t end(int cls) const { return start_[cls + 1]; }
+
+  /**
+   * @brief The class robot `index` is filed under.
+   */
+  uint8_t class_of(uint32_t index) const { return class_[index]; }
+
+ private:
+  /**
+   * @brief Move robot `index` from the range of its class to that of `cls`.
+   */
+  void Move(uint32_t index, uint8_t cls);
+
+  /**
+   * @brief Swap the robots at order_ positions `a` and `b`.
+   */
+  void Swap(size_t a, size_t b);
+
+  std::vector<uint32_t> order_;
+  // Robot index -> position in order_, and the class it is filed under.
+  std::vector<uint32_t> position_;
+  std::vector<uint8_t> class_;
+  // Class c occupies order_[start_[c], start_[c + 1]).
+  std::vector<size_t> start_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_ROBOT_PARTITION_H_
@@ -0,0 +1,132 @@
+/**
+ * @file runner_main.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cinttypes>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/params.h"
+#include "src/scenario.h"
+#include "src/session_log.h"
+#include "src/termination.h"
+#include "src/trajectory_recorder.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+static int Usage(const char *argv0) {
+  std::cerr << "usage: " << argv0
+            << " (--session session_file | --scenario scenario_file)"
+            << " [--trajectory trajectory_file] [--snapshot snapshot_file]"
+            << std::endl;
+  return 1;
+}
+
+/**
+ * @brief Headless runner: re-executes a session logged by
+ * `arenaviewer --log-session`, or runs a scenario file until one of its
+ * termination conditions is met (see Termination), without any graphics,
+ * optionally recording its trajectory or saving its final state, and prints
+ * why it stopped and the final state's checksum so that two executions can
+ * be compared.
+ */
+int main(int argc, char **argv) {
+  std::string session_path;
+  std::string scenario_path;
+  std::string trajectory_path;
+  std::string snapshot_path;
+  for (int i = 1; i < argc; i += 2) {
+    std::string option = argv[i];
+    if (i + 1 >= argc) {
+      return Usage(argv[0]);
+    } else if (option == "--session") {
+      session_path = argv[i + 1];
+    } else if (option == "--scenario") {
+      scenario_path = argv[i + 1];
+    } else if (option == "--trajectory") {
+      trajectory_path = argv[i + 1];
+    } else if (option == "--snapshot") {
+      snapshot_path = argv[i + 1];
+    } else {
+      return Usage(argv[0]);
+    }
+  }
+  if (session_path.empty() == scenario_path.empty()) {
+    return Usage(argv[0]);
+  }
+
+  csci3081::SessionLog log;
+  csci3081::arena_params aparams;
+  std::string error;
+  if (!session_path.empty()) {
+    if (!log.Load(session_path)) {
+      std::cerr << "Cannot read session log " << session_path << std::endl;
+      return 1;
+    }
+    aparams.x_dim = static_cast<uint>(log.get_x_dim());
+    aparams.y_dim = static_cast<uint>(log.get_y_dim());
+  } else if (!csci3081::LoadScenario(scenario_path, &aparams, &error)) {
+    std::cerr << error << std::endl;
+    return 1;
+  } else if (aparams.max_steps == 0 && !(aparams.max_seconds > 0)) {
+    std::cerr << scenario_path << ": max_steps or max_seconds must be set"
+              << std::endl;
+    return 1;
+  }
+  csci3081::Arena arena(&aparams);
+
+  csci3081::TrajectoryRecorder recorder;
+  if (!trajectory_path.empty()) {
+    if (!recorder.Open(trajectory_path)) {
+      std::cerr << "Cannot write trajectory " << trajectory_path << std::endl;
+      return 1;
+    }
+    arena.set_trajectory_recorder(&recorder);
+  }
+  uint64_t seed = aparams.seed;
+  csci3081::StopReason stopped = csci3081::kStopNone;
+  if (!session_path.empty()) {
+    log.Replay(&arena);
+    seed = log.get_seed();
+  } else {
+    arena.Seed(seed);
+    csci3081::PopulateArena(aparams, &arena);
+    stopped = csci3081::Termination(aparams).Run(&arena);
+  }
+  if (recorder.is_open() && !recorder.Close()) {
+    std::cerr << "Error writing trajectory " << trajectory_path << std::endl;
+    return 1;
+  }
+  if (!snapshot_path.empty() && !arena.SaveSnapshot(snapshot_path)) {
+    std::cerr << "Cannot write snapshot " << snapshot_path << std::endl;
+    return 1;
+  }
+
+  std::printf("seed:     %" PRIu64 "\n", seed);
+  if (!session_path.empty()) {
+    std::printf("inputs:   %zu\n", log.get_entries().size());
+  }
+  std::printf("steps:    %" PRIu32 "\n", arena.get_step());
+  std::printf("status:   %s\n", arena.get_game_status() == LOST ? "lost" :
+              arena.get_game_status() == WON ? "won" : "playing");
+  if (!scenario_path.empty()) {
+    std::printf("stopped:  %s\n", csci3081::StopReasonName(stopped));
+  }
+  const csci3081::Broadphase *broadphase = arena.get_broadphase();
+  if (broadphase != nullptr && broadphase->get_refreshes() > 0) {
+    std::printf("rebuilds: %" PRIu64 " of %" PRIu64 " steps (%s)\n",
+                broadphase->get_builds(), broadphase->get_refreshes(),
+                csci3081::BroadphaseName(broadphase->get_kind()));
+  }
+  std::printf("checksum: %016" PRIx64 "\n", arena.StateChecksum());
+  return 0;
+}
@@ -0,0 +1,254 @@
+/**
+ * @file scenario.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "src/arena.h"
+#include "src/entity_type.h"
+#include "src/scenario.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+// Counts are passed to the Arena as int; keep well clear of overflow.
+static const uint64_t kMaxEntities = 10000000;
+// The arena must hold at least one 50x50 placement square plus margins.
+static const uint64_t kMinArenaDim = 100;
+static const uint64_t kMaxArenaDim = 10000000;
+static const uint64_t kMaxThreads = 1024;
+static const uint64_t kMaxRelaxPasses = 1000;
+static const uint64_t kMaxSenseInterval = 1000;
+
+/*******************************************************************************
+ * Static Functions
+ ******************************************************************************/
+static std::string Trim(const std::string &s) {
+  size_t begin = s.find_first_not_of(" \t\r");
+  if (begin == std::string::npos) {
+    return "";
+  }
+  size_t end = s.find_last_not_of(" \t\r");
+  return s.substr(begin, end - begin + 1);
+}
+
+// Unsigned integer in [lo, hi]; no sign, no trailing characters.
+static bool ParseUnsigned(const std::string &text, uint64_t lo, uint64_t hi,
+                          uint64_t *value) {
+  if (text.empty() || text[0] < '0' || text[0] > '9') {
+    return false;
+  }
+  char *end = nullptr;
+  errno = 0;
+  unsigned long long v = std::strtoull(text.c_str(), &end, 10);  // NOLINT
+  if (errno != 0 || *end != '\0' || v < lo || v > hi) {
+    return false;
+  }
+  *value = v;
+  return true;
+}
+
+static bool ParseFloat(const std::string &text, float *value) {
+  char *end = nullptr;
+  errno = 0;
+  float v = std::strtof(text.c_str(), &end);
+  if (text.empty() || errno != 0 || *end != '\0' || !(v > 0)) {
+    return false;
+  }
+  *value = v;
+  return true;
+}
+
+static bool ParseOnOff(const std::string &text, int *value) {
+  if (text == "on" || text == "1" || text == "true") {
+    *value = 1;
+  } else if (text == "off" || text == "0" || text == "false") {
+    *value = 0;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static bool ParseStarvationStop(const std::string &text, int *value) {
+  if (text == "none") {
+    *value = kStarvationIgnore;
+  } else if (text == "first") {
+    *value = kStarvationFirst;
+  } else if (text == "all") {
+    *value = kStarvationAll;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Apply one `section.key = value`; sets `error` (without location) on
+// failure.
+static bool SetKey(const std::string &key, const std::string &value,
+                   arena_params *params, std::string *error) {
+  uint64_t n = 0;
+  bool ok = true;
+  if (key == "arena.width" || key == "arena.height") {
+    ok = ParseUnsigned(value, kMinArenaDim, kMaxArenaDim, &n);
+    (key == "arena.width" ? params->x_dim : params->y_dim) =
+        static_cast<uint>(n);
+  } else if (key == "arena.seed") {
+    ok = ParseUnsigned(value, 0, UINT64_MAX, &n);
+    params->seed = n;
+  } else if (key == "arena.neighbor_skin") {
+    float v = 0;
+    ok = value == "off" || ParseFloat(value, &v);
+    params->neighbor_skin = v;
+  } else if (key == "arena.broadphase") {
+    ok = ParseBroadphase(value, &params->broadphase);
+  } else if (key == "arena.relax_passes") {
+    ok = ParseUnsigned(value, 0, kMaxRelaxPasses, &n);
+    params->relax_passes = static_cast<int>(n);
+  } else if (key == "arena.dt") {
+    float v = 0;
+    ok = ParseFloat(value, &v);
+    params->dt = v;
+  } else if (key == "arena.adaptive_dt") {
+    ok = ParseOnOff(value, &params->adaptive_dt);
+  } else if (key == "arena.dt_min") {
+    float v = 0;
+    ok = ParseFloat(value, &v);
+    params->dt_min = v;
+  } else if (key == "arena.ccd") {
+    ok = ParseOnOff(value, &params->ccd);
+  } else if (key == "arena.kinetic") {
+    ok = ParseOnOff(value, &params->kinetic);
+  } else if (key == "entities.robots") {
+    ok = ParseUnsigned(value, 0, kMaxEntities, &n);
+    params->n_robots = n;
+  } else if (key == "entities.lights") {
+    ok = ParseUnsigned(value, 0, kMaxEntities, &n);
+    params->n_lights = n;
+  } else if (key == "entities.food") {
+    ok = ParseUnsigned(value, 0, kMaxEntities, &n);
+    params->n_food = n;
+  } else if (key == "behavior.fear") {
+    ok = ParseUnsigned(value, 0, kMaxEntities, &n);
+    params->fear_count = n;
+  } else if (key == "behavior.light_sensitivity") {
+    ok = ParseFloat(value, &params->light_sensitivity);
+  } else if (key == "behavior.food") {
+    ok = ParseOnOff(value, &params->food_on);
+  } else if (key == "behavior.sensor_range") {
+    float v = 0;
+    ok = value == "off" || ParseFloat(value, &v);
+    params->sensor_range = v;
+  } else if (key == "behavior.sense_interval") {
+    ok = ParseUnsigned(value, 1, kMaxSenseInterval, &n);
+    params->sense_interval = static_cast<uint32_t>(n);
+  } else if (key == "run.threads") {
+    ok = ParseUnsigned(value, 1, kMaxThreads, &n);
+    params->n_threads = n;
+  } else if (key == "run.max_steps") {
+    ok = ParseUnsigned(value, 0, UINT32_MAX, &n);
+    params->max_steps = static_cast<uint32_t>(n);
+  } else if (key == "run.stop_on_starvation") {
+    ok = ParseStarvationStop(value, &params->stop_on_starvation);
+  } else if (key == "run.steady_epsilon" || key == "run.max_seconds") {
+    float v = 0;
+    ok = ParseFloat(value, &v);
+    (key == "run.max_seconds" ? params->max_seconds :
+     params->steady_epsilon) = v;
+  } else if (key == "run.steady_window") {
+    ok = ParseUnsigned(value, 1, UINT32_MAX, &n);
+    params->steady_window = static_cast<uint32_t>(n);
+  } else if (key == "viewer.frame_budget") {
+    float v = 0;
+    ok = value == "off" || ParseFloat(value, &v);
+    params->frame_budget_ms = v;
+  } else {
+    *error = "unknown key '" + key + "'";
+    return false;
+  }
+  if (!ok) {
+    *error = "bad value '" + value + "' for '" + key + "'";
+  }
+  return ok;
+}
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+bool LoadScenario(const std::string &path, arena_params *params,
+                  std::string *error) {
+  std::ifstream in(path);
+  if (!in) {
+    *error = path + ": cannot open scenario";
+    return false;
+  }
+  return ParseScenario(in, path, params, error);
+}
+
+bool ParseScenario(std::istream &in, const std::string &name,
+                   arena_params *params, std::string *error) {
+  arena_params parsed = *params;
+  std::string section;
+  std::string line;
+  for (int number = 1; std::getline(in, line); ++number) {
+    std::ostringstream where;
+    where << name << ":" << number << ": ";
+    line = Trim(line.substr(0, line.find_first_of("#;")));
+    if (line.empty()) {
+      continue;
+    }
+    if (line.front() == '[') {
+      if (line.back() != ']') {
+        *error = where.str() + "malformed section header";
+        return false;
+      }
+      section = Trim(line.substr(1, line.size() - 2));
+      continue;
+    }
+    size_t eq = line.find('=');
+    if (eq == std::string::npos) {
+      *error = where.str() + "expected key = value";
+      return false;
+    }
+    std::string key = section + "." + Trim(line.substr(0, eq));
+    if (!SetKey(key, Trim(line.substr(eq + 1)), &parsed, error)) {
+      *error = where.str() + *error;
+      return false;
+    }
+  }
+  if (parsed.fear_count > parsed.n_robots) {
+    *error = name + ": fear is larger than the number of robots";
+    return false;
+  }
+  *params = parsed;
+  return true;
+}
+
+void PopulateArena(const arena_params &params, Arena *arena) {
+  arena->AddRobot(kRobot, static_cast<int>(params.n_robots));
+  arena->set_robot_count(static_cast<int>(params.n_robots));
+  arena->AddLight(kLight, static_cast<int>(params.n_lights));
+  arena->set_light_count(static_cast<int>(params.n_lights));
+  if (params.food_on == 1) {
+    arena->AddFood(kFood, static_cast<int>(params.n_food));
+  }
+  arena->set_food_count(static_cast<int>(params.n_food));
+  arena->set_behavior_sensitivity_robot(static_cast<int>(params.fear_count),
+                                        params.light_sensitivity,
+                                        params.food_on);
+}
+
+NAMESPACE_END(csci3081);
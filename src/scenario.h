@@ -0,0 +1,78 @@
+/**
+ * @file scenario.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SCENARIO_H_
+#define SRC_SCENARIO_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <istream>
+#include <string>
+
+#include "src/arena_params.h"
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+class Arena;
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Read a scenario file into `params`.
+ *
+ * Scenarios are INI-style text: `[section]` headers, `key = value` lines and
+ * `#` or `;` comments. Keys not given keep their current value in `params`.
+ *
+ *     [arena]     width, height, seed, broadphase (all_pairs,
+ *                 neighbor_list, sweep_and_prune or quadtree; see
+ *                 Broadphase),
+ *                 neighbor_skin (its skin distance, or off),
+ *                 relax_passes (0, or passes of the OverlapSolver),
+ *                 dt (the time a step moves entities by), adaptive_dt
+ *                 (on/off; dt is then the longest step) and dt_min,
+ *                 ccd (on/off; see SweptCollision), kinetic (on/off;
+ *                 see KineticSchedule)
+ *     [entities]  robots, lights, food
+ *     [behavior]  fear (number of robots that fear light),
+ *                 light_sensitivity, food (on/off), sensor_range (a
+ *                 distance, or off), sense_interval (steps between full
+ *                 sensings; see SenseDecimation)
+ *     [run]       threads, max_steps, stop_on_starvation (none, first or
+ *                 all), steady_epsilon and steady_window, max_seconds
+ *                 (see Termination)
+ *     [viewer]    frame_budget (milliseconds per frame, or off; see
+ *                 FrameGovernor)
+ *
+ * @param[out] error On failure, "path:line: what went wrong".
+ *
+ * @return false if the file cannot be read or has an unknown key, a
+ * malformed value or a value out of range.
+ */
+bool LoadScenario(const std::string &path, arena_params *params,
+                  std::string *error);
+
+/**
+ * @brief LoadScenario() on an already open stream; `name` is only used in
+ * error messages.
+ */
+bool ParseScenario(std::istream &in, const std::string &name,
+                   arena_params *params, std::string *error);
+
+/**
+ * @brief Add the scenario's entities to `arena` and set the robots'
+ * behavior, in the same order as the viewer's Play button does.
+ */
+void PopulateArena(const arena_params &params, Arena *arena);
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SCENARIO_H_
@@ -0,0 +1,88 @@
+/**
+ * @file sense_decimation.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "src/sense_decimation.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+// The sensors' ceiling (see LightSensor::CalculateSensorReading()).
+static const double kMaxReading = 1000;
+
+/*******************************************************************************
+ * Static Functions
+ ******************************************************************************/
+// The factor a reading changed by per step, going from `before` to `after`
+// over `steps`; 1 if it is not changing by a factor, e.g. from or to 0 or
+// at the ceiling.
+static double StepFactor(double before, double after, uint32_t steps) {
+  if (!(before > 0) || !(after > 0) || !(after < kMaxReading)) {
+    return 1;
+  }
+  return std::pow(after / before, 1.0 / steps);
+}
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+SenseDecimation::SenseDecimation()
+    : sensed_left_(), sensed_right_(), left_(), right_(), left_factor_(),
+      right_factor_(), since_(), class_(), known_(), recorded_(0),
+      extrapolated_(0) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void SenseDecimation::Reset(size_t n_robots) {
+  sensed_left_.assign(n_robots, 0);
+  sensed_right_.assign(n_robots, 0);
+  left_.assign(n_robots, 0);
+  right_.assign(n_robots, 0);
+  left_factor_.assign(n_robots, 1);
+  right_factor_.assign(n_robots, 1);
+  since_.assign(n_robots, 0);
+  class_.assign(n_robots, 0);
+  known_.assign(n_robots, 0);
+}
+
+void SenseDecimation::Record(uint32_t i, uint8_t cls, double left,
+                             double right) {
+  // Only two full sensings in the same class tell how the readings change.
+  bool steady = known_[i] && class_[i] == cls;
+  uint32_t steps = since_[i] + 1;
+  left_factor_[i] = steady ? StepFactor(sensed_left_[i], left, steps) : 1;
+  right_factor_[i] = steady ? StepFactor(sensed_right_[i], right, steps) : 1;
+  sensed_left_[i] = left;
+  sensed_right_[i] = right;
+  left_[i] = left;
+  right_[i] = right;
+  since_[i] = 0;
+  class_[i] = cls;
+  known_[i] = 1;
+  ++recorded_;
+}
+
+void SenseDecimation::Extrapolate(uint32_t i, double *left, double *right) {
+  left_[i] = std::min(left_[i] * left_factor_[i], kMaxReading);
+  right_[i] = std::min(right_[i] * right_factor_[i], kMaxReading);
+  ++since_[i];
+  ++extrapolated_;
+  *left = left_[i];
+  *right = right_[i];
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,95 @@
+/**
+ * @file sense_decimation.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SENSE_DECIMATION_H_
+#define SRC_SENSE_DECIMATION_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Each robot's light readings as of its last full sensing, and how
+ * they were changing, so that the steps in between can carry them on
+ * instead of sensing every light again.
+ *
+ * A reading is a sum of 1200 / base^d over the lights, so while a robot
+ * moves steadily past the nearest light its log changes about linearly. The
+ * readings are therefore carried on by the factor each changed by per step
+ * between the robot's last two full sensings, and held at the sensors' 1000
+ * ceiling. A robot must sense fully again once `interval` steps have passed
+ * since it last did, or once its sense class has changed.
+ */
+class SenseDecimation {
+ public:
+  SenseDecimation();
+
+  /**
+   * @brief Forget every robot's readings, and keep room for `n_robots`;
+   * every robot is due to sense at its next step.
+   */
+  void Reset(size_t n_robots);
+
+  size_t size() const { return since_.size(); }
+
+  /**
+   * @brief Whether robot `i`, now of sense class `cls`, must sense fully
+   * this step to sense at least every `interval` steps.
+   */
+  bool Due(uint32_t i, uint8_t cls, uint32_t interval) const {
+    return !known_[i] || class_[i] != cls || since_[i] + 1 >= interval;
+  }
+
+  /**
+   * @brief Robot `i`, of sense class `cls`, has just sensed fully and read
+   * `left` and `right`.
+   */
+  void Record(uint32_t i, uint8_t cls, double left, double right);
+
+  /**
+   * @brief Carry robot `i`'s readings on by one step, into `left` and
+   * `right`.
+   */
+  void Extrapolate(uint32_t i, double *left, double *right);
+
+  /**
+   * @brief Number of full sensings recorded, and of steps carried on.
+   */
+  uint64_t get_recorded() const { return recorded_; }
+  uint64_t get_extrapolated() const { return extrapolated_; }
+
+ private:
+  // The readings at the last full sensing, and as carried on since.
+  std::vector<double> sensed_left_;
+  std::vector<double> sensed_right_;
+  std::vector<double> left_;
+  std::vector<double> right_;
+  std::vector<double> left_factor_;
+  std::vector<double> right_factor_;
+  // Steps since the last full sensing, and the class it was made in.
+  std::vector<uint32_t> since_;
+  std::vector<uint8_t> class_;
+  std::vector<uint8_t> known_;
+  uint64_t recorded_;
+  uint64_t extrapolated_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SENSE_DECIMATION_H_
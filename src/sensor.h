@@ -58,7 +58,7 @@ class Sensor {
   /**
   * @brief Getter for sensor reading
   */
-  double get_sensor_reading() { return sensor_reading_; }
+  double get_sensor_reading() const { return sensor_reading_; }
   /**
   * @brief Setter for sensor reading.
   */
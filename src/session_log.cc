@@ -0,0 +1,160 @@
+/**
+ * @file session_log.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/session_log.h"
+#include "src/arena.h"
+#include "src/binary_io.h"
+#include "src/communication.h"
+#include "src/entity_type.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Log Format
+ ******************************************************************************/
+// "RSES" u32:version u64:seed f64:x_dim f64:y_dim u32:entry_count, then per
+// entry u32:step u32:time_ms u8:kind i32:a i32:b f32:c, all little-endian.
+static const char kSessionMagic[4] = {'R', 'S', 'E', 'S'};
+static const uint32_t kSessionVersion = 1;
+static const size_t kSessionEntrySize = 4 + 4 + 1 + 4 + 4 + 4;
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+SessionLog::SessionLog()
+    : seed_(0),
+      x_dim_(0),
+      y_dim_(0),
+      entries_(),
+      start_(std::chrono::steady_clock::now()) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void SessionLog::Start(uint64_t seed, double x_dim, double y_dim) {
+  seed_ = seed;
+  x_dim_ = x_dim;
+  y_dim_ = y_dim;
+  entries_.clear();
+  start_ = std::chrono::steady_clock::now();
+}
+
+void SessionLog::Append(uint32_t step, SessionInput kind, int a, int b,
+                        float c) {
+  SessionEntry entry;
+  entry.step = step;
+  entry.time_ms = static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start_).count());
+  entry.kind = kind;
+  entry.a = a;
+  entry.b = b;
+  entry.c = c;
+  entries_.push_back(entry);
+}
+
+bool SessionLog::Save(const std::string &path) const {
+  BinaryWriter out;
+  out.PutBytes(kSessionMagic, sizeof(kSessionMagic));
+  out.PutU32(kSessionVersion);
+  out.PutU64(seed_);
+  out.PutF64(x_dim_);
+  out.PutF64(y_dim_);
+  out.PutU32(static_cast<uint32_t>(entries_.size()));
+  for (auto &entry : entries_) {
+    out.PutU32(entry.step);
+    out.PutU32(entry.time_ms);
+    out.PutU8(static_cast<uint8_t>(entry.kind));
+    out.PutI32(entry.a);
+    out.PutI32(entry.b);
+    out.PutF32(entry.c);
+  }
+  return out.WriteFile(path);
+}
+
+bool SessionLog::Load(const std::string &path) {
+  entries_.clear();
+  std::vector<uint8_t> bytes;
+  if (!ReadFileBytes(path, &bytes)) {
+    return false;
+  }
+  BinaryReader in(bytes.data(), bytes.size());
+  if (!in.Expect(kSessionMagic, sizeof(kSessionMagic)) ||
+      in.GetU32() != kSessionVersion) {
+    return false;
+  }
+  uint64_t seed = in.GetU64();
+  double x_dim = in.GetF64();
+  double y_dim = in.GetF64();
+  uint32_t n = in.GetU32();
+  if (!in.ok() || n > in.remaining() / kSessionEntrySize) {
+    return false;
+  }
+  std::vector<SessionEntry> entries(n);
+  uint32_t last_step = 0;
+  for (auto &entry : entries) {
+    entry.step = in.GetU32();
+    entry.time_ms = in.GetU32();
+    entry.kind = in.GetU8();
+    entry.a = in.GetI32();
+    entry.b = in.GetI32();
+    entry.c = in.GetF32();
+    // Inputs must be in step order and of a known kind.
+    if (entry.step < last_step || entry.kind > kInputSenseInterval) {
+      return false;
+    }
+    last_step = entry.step;
+  }
+  if (!in.ok()) {
+    return false;
+  }
+  seed_ = seed;
+  x_dim_ = x_dim;
+  y_dim_ = y_dim;
+  entries_.swap(entries);
+  return true;
+}
+
+void SessionLog::Replay(Arena *arena) const {
+  arena->Seed(seed_);
+  for (auto &entry : entries_) {
+    while (arena->get_step() < entry.step) {
+      arena->AdvanceTime(1);
+    }
+    switch (entry.kind) {
+      case kInputAddRobot: arena->AddRobot(kRobot, entry.a);
+        break;
+      case kInputAddLight: arena->AddLight(kLight, entry.a);
+        break;
+      case kInputAddFood: arena->AddFood(kFood, entry.a);
+        break;
+      case kInputRobotCount: arena->set_robot_count(entry.a);
+        break;
+      case kInputLightCount: arena->set_light_count(entry.a);
+        break;
+      case kInputFoodCount: arena->set_food_count(entry.a);
+        break;
+      case kInputBehavior:
+        arena->set_behavior_sensitivity_robot(entry.a, entry.c, entry.b);
+        break;
+      case kInputCommand:
+        arena->AcceptCommand(static_cast<Communication>(entry.a));
+        break;
+      case kInputSenseInterval:
+        arena->set_sense_interval(static_cast<uint32_t>(entry.a));
+        break;
+      default: break;
+    }
+  }
+}
+
+NAMESPACE_END(csci3081);
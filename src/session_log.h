@@ -0,0 +1,130 @@
+/**
+ * @file session_log.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SESSION_LOG_H_
+#define SRC_SESSION_LOG_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+/**
+ * @brief The inputs that change an Arena, one per public Arena call.
+ */
+enum SessionInput {
+  kInputAddRobot = 0,  // a = quantity
+  kInputAddLight,      // a = quantity
+  kInputAddFood,       // a = quantity
+  kInputRobotCount,    // a = count
+  kInputLightCount,    // a = count
+  kInputFoodCount,     // a = count
+  kInputBehavior,      // a = fear count, b = food on/off, c = sensitivity
+  kInputCommand,       // a = Communication
+  kInputEnd,           // last entry: the step the session ended at
+  kInputSenseInterval  // a = steps between full sensings
+};
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief One input, applied after `step` timesteps had completed.
+ */
+struct SessionEntry {
+  uint32_t step{0};
+  // Wall-clock milliseconds since the session started; informational only.
+  uint32_t time_ms{0};
+  int32_t kind{0};
+  int32_t a{0};
+  int32_t b{0};
+  float c{0};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+class Arena;
+
+/**
+ * @brief A compact record of a whole session: the random seed and every
+ * input given to the Arena, tagged with the step at which it arrived.
+ *
+ * Since the Arena advances exactly one fixed timestep per AdvanceTime() call
+ * and draws all of its randomness from its own seeded stream, the seed and
+ * the inputs are enough to re-execute the session exactly (see Replay()),
+ * at a few bytes per button press instead of a full trajectory.
+ *
+ * Attach a log with Arena::set_session_log() right after Arena::Seed().
+ */
+class SessionLog {
+ public:
+  SessionLog();
+
+  /**
+   * @brief Clear the log and start a session with the given seed and arena
+   * size.
+   */
+  void Start(uint64_t seed, double x_dim, double y_dim);
+
+  /**
+   * @brief Record an input arriving after `step` timesteps.
+   */
+  void Append(uint32_t step, SessionInput kind, int a = 0, int b = 0,
+              float c = 0);
+
+  /**
+   * @brief Mark the end of the session.
+   */
+  void Finish(uint32_t step) { Append(step, kInputEnd); }
+
+  /**
+   * @brief Write the log to `path`. @return false if it could not be written.
+   */
+  bool Save(const std::string &path) const;
+
+  /**
+   * @brief Read a log written by Save(). @return false, leaving the log
+   * empty, if the file is missing or malformed.
+   */
+  bool Load(const std::string &path);
+
+  /**
+   * @brief Re-execute the session on `arena`, which must be freshly
+   * constructed with get_x_dim() x get_y_dim(). Steps the arena up to each
+   * input's step, applies the input, and finishes at the final step.
+   */
+  void Replay(Arena *arena) const;
+
+  uint64_t get_seed() const { return seed_; }
+  double get_x_dim() const { return x_dim_; }
+  double get_y_dim() const { return y_dim_; }
+  const std::vector<SessionEntry> &get_entries() const { return entries_; }
+
+ private:
+  uint64_t seed_;
+  double x_dim_;
+  double y_dim_;
+  std::vector<SessionEntry> entries_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SESSION_LOG_H_
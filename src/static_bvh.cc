@@ -0,0 +1,153 @@
+/**
+ * @file static_bvh.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+
+#include "src/static_bvh.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+const uint32_t StaticBvh::kLeafSize;
+
+StaticBvh::StaticBvh()
+    : ids_(), items_(), nodes_(), stack_(), builds_(0), refits_(0) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void StaticBvh::Build(const std::vector<uint32_t> &ids, const double *x,
+                      const double *y, const double *radius) {
+  ++builds_;
+  ids_ = ids;
+  items_.clear();
+  for (uint32_t id : ids) {
+    items_.push_back({id, x[id], y[id], radius[id]});
+  }
+  nodes_.clear();
+  if (!items_.empty()) {
+    BuildNode(0, static_cast<uint32_t>(items_.size()));
+  }
+}
+
+bool StaticBvh::Refit(const double *x, const double *y,
+                      const double *radius) {
+  bool changed = false;
+  for (auto &item : items_) {
+    // Neither greater nor less is the same, without comparing for equality.
+    changed = changed || x[item.id] < item.x || item.x < x[item.id] ||
+              y[item.id] < item.y || item.y < y[item.id] ||
+              radius[item.id] < item.radius || item.radius < radius[item.id];
+    item.x = x[item.id];
+    item.y = y[item.id];
+    item.radius = radius[item.id];
+  }
+  if (!changed) {
+    return false;
+  }
+  ++refits_;
+  for (size_t n = nodes_.size(); n-- > 0;) {
+    Fit(static_cast<uint32_t>(n));
+  }
+  return true;
+}
+
+void StaticBvh::Query(double x, double y, double radius,
+                      std::vector<uint32_t> *found) const {
+  if (nodes_.empty()) {
+    return;
+  }
+  stack_.assign(1, 0);
+  while (!stack_.empty()) {
+    uint32_t n = stack_.back();
+    const Node &node = nodes_[n];
+    stack_.pop_back();
+    // The distance from (x, y) to the box, 0 inside it.
+    double dx = std::max(std::max(node.min_x - x, x - node.max_x), 0.0);
+    double dy = std::max(std::max(node.min_y - y, y - node.max_y), 0.0);
+    if (dx * dx + dy * dy > radius * radius) {
+      continue;
+    }
+    if (node.count == 0) {
+      stack_.push_back(n + 1);
+      stack_.push_back(node.right);
+      continue;
+    }
+    for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+      const Item &item = items_[k];
+      double ix = item.x - x;
+      double iy = item.y - y;
+      double within = radius + item.radius;
+      if (ix * ix + iy * iy <= within * within) {
+        found->push_back(item.id);
+      }
+    }
+  }
+}
+
+uint32_t StaticBvh::BuildNode(uint32_t first, uint32_t count) {
+  uint32_t n = static_cast<uint32_t>(nodes_.size());
+  nodes_.push_back({0, 0, 0, 0, first, count, 0});
+  if (count > kLeafSize) {
+    double min_x = items_[first].x, max_x = min_x;
+    double min_y = items_[first].y, max_y = min_y;
+    for (uint32_t k = first + 1; k < first + count; ++k) {
+      min_x = std::min(min_x, items_[k].x);
+      max_x = std::max(max_x, items_[k].x);
+      min_y = std::min(min_y, items_[k].y);
+      max_y = std::max(max_y, items_[k].y);
+    }
+    bool along_x = max_x - min_x >= max_y - min_y;
+    auto begin = items_.begin() + first;
+    std::nth_element(begin, begin + count / 2, begin + count,
+                     [along_x](const Item &a, const Item &b) {
+      double ka = along_x ? a.x : a.y, kb = along_x ? b.x : b.y;
+      return ka < kb || (!(kb < ka) && a.id < b.id);
+    });
+    BuildNode(first, count / 2);
+    // Building appends to nodes_, so node n is only looked up afterwards.
+    uint32_t right = BuildNode(first + count / 2, count - count / 2);
+    nodes_[n].count = 0;
+    nodes_[n].right = right;
+  }
+  Fit(n);
+  return n;
+}
+
+void StaticBvh::Fit(uint32_t n) {
+  Node &node = nodes_[n];
+  if (node.count == 0) {
+    const Node &left = nodes_[n + 1];
+    const Node &right = nodes_[node.right];
+    node.min_x = std::min(left.min_x, right.min_x);
+    node.min_y = std::min(left.min_y, right.min_y);
+    node.max_x = std::max(left.max_x, right.max_x);
+    node.max_y = std::max(left.max_y, right.max_y);
+    return;
+  }
+  const Item &head = items_[node.first];
+  node.min_x = head.x - head.radius;
+  node.min_y = head.y - head.radius;
+  node.max_x = head.x + head.radius;
+  node.max_y = head.y + head.radius;
+  for (uint32_t k = node.first + 1; k < node.first + node.count; ++k) {
+    const Item &item = items_[k];
+    node.min_x = std::min(node.min_x, item.x - item.radius);
+    node.min_y = std::min(node.min_y, item.y - item.radius);
+    node.max_x = std::max(node.max_x, item.x + item.radius);
+    node.max_y = std::max(node.max_y, item.y + item.radius);
+  }
+}
+
+NAMESPACE_END(csci3081);
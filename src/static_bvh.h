@@ -0,0 +1,121 @@
+/**
+ * @file static_bvh.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_STATIC_BVH_H_
+#define SRC_STATIC_BVH_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A bounding-volume hierarchy of circles that seldom move, with
+ * radius queries.
+ *
+ * The hierarchy is a binary tree of axis-aligned boxes, split at the median
+ * of the longer axis down to a few circles per leaf. It is built once for a
+ * set of circles; when some of them move, Refit() grows or shrinks the
+ * boxes in place rather than building it again, which keeps queries correct
+ * if, after much movement, slower.
+ */
+class StaticBvh {
+ public:
+  StaticBvh();
+
+  /**
+   * @brief Build the hierarchy over circles `ids`, where circle `id` is at
+   * (`x[id]`, `y[id]`) with `radius[id]`.
+   */
+  void Build(const std::vector<uint32_t> &ids, const double *x,
+             const double *y, const double *radius);
+
+  /**
+   * @brief Take the circles' poses and radii from the same arrays as
+   * Build(), fitting the boxes to them.
+   *
+   * @return Whether any circle had changed; if none had, nothing is done.
+   */
+  bool Refit(const double *x, const double *y, const double *radius);
+
+  /**
+   * @brief Append to `found` the ids of the circles within `radius` of
+   * (`x`, `y`), i.e. whose edges are no further away, in no particular
+   * order.
+   */
+  void Query(double x, double y, double radius,
+             std::vector<uint32_t> *found) const;
+
+  /**
+   * @brief The ids given to the last Build(), in the same order.
+   */
+  const std::vector<uint32_t> &get_ids() const { return ids_; }
+
+  size_t size() const { return ids_.size(); }
+  size_t node_count() const { return nodes_.size(); }
+
+  /**
+   * @brief Number of Build() calls, and of Refit() calls that changed
+   * something.
+   */
+  uint64_t get_builds() const { return builds_; }
+  uint64_t get_refits() const { return refits_; }
+
+ private:
+  struct Node {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+    uint32_t first;  // a leaf's items are items_[first, first + count)
+    uint32_t count;  // 0 for an inner node
+    uint32_t right;  // an inner node's children are this + 1 and right
+  };
+  struct Item {
+    uint32_t id;
+    double x;
+    double y;
+    double radius;
+  };
+
+  static const uint32_t kLeafSize = 4;
+
+  /**
+   * @brief Append the subtree over items_[first, first + count); returns
+   * its root.
+   */
+  uint32_t BuildNode(uint32_t first, uint32_t count);
+
+  /**
+   * @brief Set node `n`'s box from its items or its children.
+   */
+  void Fit(uint32_t n);
+
+  std::vector<uint32_t> ids_;
+  // In leaf order.
+  std::vector<Item> items_;
+  // Depth first, so that children come after their parents.
+  std::vector<Node> nodes_;
+  mutable std::vector<uint32_t> stack_;
+  uint64_t builds_;
+  uint64_t refits_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_STATIC_BVH_H_
@@ -0,0 +1,371 @@
+/**
+ * @file sweep.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "src/arena.h"
+#include "src/binary_io.h"
+#include "src/result_cache.h"
+#include "src/scenario.h"
+#include "src/sweep.h"
+#include "src/sweep_sink.h"
+#include "src/termination.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+static const uint64_t kMaxEntities = 10000000;
+// Job indices are written as 32-bit values; far beyond any real sweep.
+static const uint64_t kMaxJobs = 10000000;
+
+/*******************************************************************************
+ * Static Functions
+ ******************************************************************************/
+static std::string Trim(const std::string &s) {
+  size_t begin = s.find_first_not_of(" \t\r");
+  if (begin == std::string::npos) {
+    return "";
+  }
+  size_t end = s.find_last_not_of(" \t\r");
+  return s.substr(begin, end - begin + 1);
+}
+
+static std::vector<std::string> Split(const std::string &s) {
+  std::vector<std::string> items;
+  std::istringstream in(s);
+  std::string item;
+  while (std::getline(in, item, ',')) {
+    items.push_back(Trim(item));
+  }
+  return items;
+}
+
+static bool ParseUnsigned(const std::string &text, uint64_t *value) {
+  if (text.empty() || text[0] < '0' || text[0] > '9') {
+    return false;
+  }
+  char *end = nullptr;
+  errno = 0;
+  unsigned long long v = std::strtoull(text.c_str(), &end, 10);  // NOLINT
+  if (errno != 0 || *end != '\0') {
+    return false;
+  }
+  *value = v;
+  return true;
+}
+
+// "a, b, lo-hi, ..." with every value in [lo, hi].
+static bool ParseIntList(const std::string &text, uint64_t lo, uint64_t hi,
+                         std::vector<uint64_t> *values) {
+  values->clear();
+  for (auto &item : Split(text)) {
+    size_t dash = item.find('-', 1);
+    uint64_t first = 0;
+    uint64_t last = 0;
+    if (dash == std::string::npos) {
+      if (!ParseUnsigned(item, &first)) {
+        return false;
+      }
+      last = first;
+    } else if (!ParseUnsigned(Trim(item.substr(0, dash)), &first) ||
+               !ParseUnsigned(Trim(item.substr(dash + 1)), &last) ||
+               last < first || last - first >= kMaxJobs) {
+      return false;
+    }
+    if (first < lo || last > hi) {
+      return false;
+    }
+    for (uint64_t v = first; ; ++v) {
+      values->push_back(v);
+      if (v == last) {
+        break;
+      }
+    }
+  }
+  return !values->empty();
+}
+
+static bool ParseFloatList(const std::string &text,
+                           std::vector<float> *values) {
+  values->clear();
+  for (auto &item : Split(text)) {
+    char *end = nullptr;
+    errno = 0;
+    float v = std::strtof(item.c_str(), &end);
+    if (item.empty() || errno != 0 || *end != '\0' || !(v > 0)) {
+      return false;
+    }
+    values->push_back(v);
+  }
+  return !values->empty();
+}
+
+static bool ParseOnOffList(const std::string &text,
+                           std::vector<uint64_t> *values) {
+  values->clear();
+  for (auto &item : Split(text)) {
+    if (item == "on" || item == "1" || item == "true") {
+      values->push_back(1);
+    } else if (item == "off" || item == "0" || item == "false") {
+      values->push_back(0);
+    } else {
+      return false;
+    }
+  }
+  return !values->empty();
+}
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+Sweep::Sweep() : base_(), jobs_(), fingerprint_(0) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+bool Sweep::Load(const std::string &path, std::string *error) {
+  std::ifstream in(path);
+  if (!in) {
+    *error = path + ": cannot open sweep";
+    return false;
+  }
+  return Parse(in, path, error);
+}
+
+bool Sweep::Parse(std::istream &in, const std::string &name,
+                  std::string *error) {
+  // The [sweep] section is read here; everything else is a scenario. Its
+  // lines are blanked rather than dropped so that the scenario parser
+  // reports the right line numbers.
+  std::vector<std::pair<int, std::string>> grid_lines;
+  std::ostringstream scenario;
+  std::string section;
+  std::string line;
+  for (int number = 1; std::getline(in, line); ++number) {
+    std::string content = Trim(line.substr(0, line.find_first_of("#;")));
+    if (!content.empty() && content.front() == '[' &&
+        content.back() == ']') {
+      section = Trim(content.substr(1, content.size() - 2));
+    }
+    if (section == "sweep") {
+      if (!content.empty() && content.front() != '[') {
+        grid_lines.emplace_back(number, content);
+      }
+      line.clear();
+    }
+    scenario << line << "\n";
+  }
+  arena_params base;
+  std::istringstream scenario_in(scenario.str());
+  if (!ParseScenario(scenario_in, name, &base, error)) {
+    return false;
+  }
+  if (base.max_steps == 0) {
+    *error = name + ": [run] max_steps must be set";
+    return false;
+  }
+  // A sweep measures the time to first starvation unless told otherwise.
+  if (base.stop_on_starvation == kStarvationIgnore) {
+    base.stop_on_starvation = kStarvationFirst;
+  }
+
+  std::vector<uint64_t> robots = {base.n_robots};
+  std::vector<uint64_t> lights = {base.n_lights};
+  std::vector<uint64_t> food = {base.n_food};
+  std::vector<uint64_t> fear = {
+      base.n_robots > 0 ? base.fear_count * 100 / base.n_robots : 0};
+  std::vector<float> sensitivity = {base.light_sensitivity};
+  std::vector<uint64_t> food_on = {static_cast<uint64_t>(base.food_on)};
+  std::vector<uint64_t> seeds = {base.seed};
+  for (auto &grid_line : grid_lines) {
+    std::ostringstream where;
+    where << name << ":" << grid_line.first << ": ";
+    size_t eq = grid_line.second.find('=');
+    if (eq == std::string::npos) {
+      *error = where.str() + "expected key = value";
+      return false;
+    }
+    std::string key = Trim(grid_line.second.substr(0, eq));
+    std::string value = Trim(grid_line.second.substr(eq + 1));
+    bool ok = true;
+    if (key == "robots") {
+      ok = ParseIntList(value, 0, kMaxEntities, &robots);
+    } else if (key == "lights") {
+      ok = ParseIntList(value, 0, kMaxEntities, &lights);
+    } else if (key == "food") {
+      ok = ParseIntList(value, 0, kMaxEntities, &food);
+    } else if (key == "fear") {
+      ok = ParseIntList(value, 0, 100, &fear);
+    } else if (key == "light_sensitivity") {
+      ok = ParseFloatList(value, &sensitivity);
+    } else if (key == "food_on") {
+      ok = ParseOnOffList(value, &food_on);
+    } else if (key == "seeds") {
+      ok = ParseIntList(value, 0, UINT64_MAX, &seeds);
+    } else {
+      *error = where.str() + "unknown key 'sweep." + key + "'";
+      return false;
+    }
+    if (!ok) {
+      *error = where.str() + "bad value '" + value + "' for 'sweep." + key +
+               "'";
+      return false;
+    }
+  }
+  uint64_t n = 1;
+  for (size_t size : {robots.size(), lights.size(), food.size(), fear.size(),
+                      sensitivity.size(), food_on.size(), seeds.size()}) {
+    n *= size;
+    if (n > kMaxJobs) {
+      *error = name + ": more than 10000000 jobs";
+      return false;
+    }
+  }
+
+  // Nested in the order the CSV columns are written, seeds fastest.
+  std::vector<SweepJob> jobs;
+  // Floating-point values as their bits, so that any change shows.
+  std::ostringstream canon;
+  for (auto r : robots) {
+    for (auto l : lights) {
+      for (auto f : food) {
+        for (auto p : fear) {
+          for (auto s : sensitivity) {
+            for (auto o : food_on) {
+              for (auto seed : seeds) {
+                SweepJob job;
+                job.index = static_cast<uint32_t>(jobs.size());
+                job.seed = seed;
+                job.n_robots = r;
+                job.n_lights = l;
+                job.n_food = f;
+                job.fear_percent = static_cast<int>(p);
+                job.light_sensitivity = s;
+                job.food_on = static_cast<int>(o);
+                // Robots sense every entity and every mobile entity is
+                // tested for collision against every entity.
+                uint64_t entities = r + l + (o == 1 ? f : 0);
+                job.cost = (2 * r + l) * entities;
+                jobs.push_back(job);
+                canon << seed << " " << r << " " << l << " " << f
+                      << " " << p << " " << BitsOf(s) << " " << o << "\n";
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  canon << base.x_dim << " " << base.y_dim << " " << base.max_steps << " "
+        << base.stop_on_starvation << " " << BitsOf(base.steady_epsilon)
+        << " " << base.steady_window << " " << BitsOf(base.max_seconds)
+        << " " << BitsOf(base.sensor_range) << " " << base.sense_interval
+        << " " << base.relax_passes << " " << BitsOf(base.dt) << " "
+        << base.ccd << " " << base.adaptive_dt << " " << BitsOf(base.dt_min)
+        << "\n";
+  base_ = base;
+  jobs_.swap(jobs);
+  std::string text = canon.str();
+  fingerprint_ = Fnv1a(text.data(), text.size());
+  return true;
+}
+
+arena_params Sweep::JobParams(const SweepJob &job) const {
+  arena_params params = base_;
+  params.n_robots = job.n_robots;
+  params.n_lights = job.n_lights;
+  params.n_food = job.n_food;
+  // As the GUI's fear slider does.
+  params.fear_count = job.n_robots * job.fear_percent / 100;
+  params.light_sensitivity = job.light_sensitivity;
+  params.food_on = job.food_on;
+  params.seed = job.seed;
+  return params;
+}
+
+SweepResult Sweep::RunJob(const SweepJob &job) const {
+  auto start = std::chrono::steady_clock::now();
+  arena_params params = JobParams(job);
+  Arena arena(&params);
+  arena.Seed(job.seed);
+  PopulateArena(params, &arena);
+  SweepResult result;
+  result.job = job.index;
+  Termination termination(params);
+  termination.Start(arena);
+  while ((result.stopped = termination.Check(arena)) == kStopNone) {
+    arena.AdvanceSteps(termination.StepsBeforeCheck(arena));
+    if (result.starved_step < 0 && arena.get_game_status() == LOST) {
+      result.starved_step = arena.get_step();
+    }
+  }
+  result.steps = arena.get_step();
+  result.checksum = arena.StateChecksum();
+  result.seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+size_t Sweep::Run(SweepSink *sink, size_t n_threads,
+                  ResultCache *cache) const {
+  std::vector<const SweepJob *> pending;
+  for (auto &job : jobs_) {
+    if (!sink->is_done(job.index)) {
+      pending.push_back(&job);
+    }
+  }
+  std::stable_sort(pending.begin(), pending.end(),
+                   [](const SweepJob *a, const SweepJob *b) {
+                     return a->cost > b->cost;
+                   });
+
+  // Each worker takes the next most expensive job until none are left.
+  std::atomic<size_t> next(0);
+  auto worker = [&]() {
+    for (size_t i = next++; i < pending.size(); i = next++) {
+      const SweepJob &job = *pending[i];
+      SweepResult result;
+      result.job = job.index;
+      if (cache == nullptr || !cache->Lookup(JobParams(job), &result)) {
+        result = RunJob(job);
+        // A run cut short by the clock would not come out the same again.
+        if (cache != nullptr && result.stopped != kStopTimeBudget) {
+          cache->Store(JobParams(job), result);
+        }
+      } else {
+        result.cached = true;
+      }
+      sink->Write(job, result);
+    }
+  };
+  size_t n = std::max<size_t>(1, std::min(n_threads, pending.size()));
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < n; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return pending.size();
+}
+
+NAMESPACE_END(csci3081);
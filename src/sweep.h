@@ -0,0 +1,159 @@
+/**
+ * @file sweep.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SWEEP_H_
+#define SRC_SWEEP_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "src/arena_params.h"
+#include "src/common.h"
+#include "src/termination.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+class ResultCache;
+class SweepSink;
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief One point of the parameter grid with one seed.
+ */
+struct SweepJob {
+  // Position in grid order; identifies the job in the output file.
+  uint32_t index{0};
+  uint64_t seed{0};
+  size_t n_robots{0};
+  size_t n_lights{0};
+  size_t n_food{0};
+  // Percentage of the robots that fear light, as on the GUI slider.
+  int fear_percent{0};
+  float light_sensitivity{1.0f};
+  int food_on{1};
+  // Relative amount of work per step, for longest-first scheduling.
+  uint64_t cost{0};
+};
+
+/**
+ * @brief What a job measured.
+ */
+struct SweepResult {
+  uint32_t job{0};
+  // Steps run: up to the first starvation or the step budget.
+  uint32_t steps{0};
+  // Step at which a robot first starved, or -1 if none did.
+  int64_t starved_step{-1};
+  // Which termination condition ended the run.
+  StopReason stopped{kStopNone};
+  uint64_t checksum{0};
+  // Simulation time, when the job was actually run.
+  double seconds{0};
+  // Whether the result came from a ResultCache instead of a run.
+  bool cached{false};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A Cartesian grid of arena configurations times a list of seeds,
+ * run in parallel to measure each configuration's time to first starvation.
+ *
+ * A sweep file is a scenario file (see LoadScenario()), which gives the
+ * fixed parameters and the step budget, plus a `[sweep]` section of
+ * comma-separated lists; integer lists may use `lo-hi` ranges:
+ *
+ *     [sweep]
+ *     robots = 5, 10, 20
+ *     lights = 0-4
+ *     food = 4
+ *     fear = 0, 50, 100          ; percent of the robots
+ *     light_sensitivity = 1.0, 1.05, 1.1
+ *     food_on = on
+ *     seeds = 1-10
+ *
+ * Keys left out take the scenario's value. Jobs stop at the first
+ * starvation unless the scenario sets `stop_on_starvation`.
+ */
+class Sweep {
+ public:
+  Sweep();
+
+  /**
+   * @brief Read a sweep file and expand its grid into jobs.
+   *
+   * @param[out] error On failure, "path:line: what went wrong".
+   */
+  bool Load(const std::string &path, std::string *error);
+
+  /**
+   * @brief Load() on an already open stream; `name` is only used in error
+   * messages.
+   */
+  bool Parse(std::istream &in, const std::string &name, std::string *error);
+
+  /**
+   * @brief The scenario every job starts from.
+   */
+  const arena_params &get_base() const { return base_; }
+
+  /**
+   * @brief All jobs, in grid order (seeds varying fastest).
+   */
+  const std::vector<SweepJob> &get_jobs() const { return jobs_; }
+
+  /**
+   * @brief Hash of the base scenario and the grid, so that an output file
+   * is only ever resumed by the sweep that started it.
+   */
+  uint64_t get_fingerprint() const { return fingerprint_; }
+
+  /**
+   * @brief The complete parameters of one job: the base scenario with the
+   * job's grid values and seed.
+   */
+  arena_params JobParams(const SweepJob &job) const;
+
+  /**
+   * @brief Run one job on a fresh Arena until one of the scenario's
+   * termination conditions is met (see Termination).
+   */
+  SweepResult RunJob(const SweepJob &job) const;
+
+  /**
+   * @brief Run every job the sink has no result for on `n_threads` worker
+   * threads, most expensive first so that a long job is not left running
+   * alone at the end, writing each result to `sink` as it finishes.
+   *
+   * If `cache` is given, jobs found in it are not simulated and the results
+   * of the others are added to it.
+   *
+   * @return The number of jobs completed, from the cache or not.
+   */
+  size_t Run(SweepSink *sink, size_t n_threads,
+             ResultCache *cache = nullptr) const;
+
+ private:
+  arena_params base_;
+  std::vector<SweepJob> jobs_;
+  uint64_t fingerprint_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SWEEP_H_
@@ -0,0 +1,74 @@
+/**
+ * @file sweep_and_prune.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "src/sweep_and_prune.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+SweepAndPrune::SweepAndPrune(double skin)
+    : Broadphase(skin), order_(), low_(), pairs_(), swaps_(0) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+bool SweepAndPrune::Update(const std::vector<ArenaEntity *> &entities,
+                           const std::vector<ArenaMobileEntity *> &mobile,
+                           bool reset) {
+  Record(entities, mobile);
+  size_t n = index_.size();
+  low_.resize(x_.size());
+  for (uint32_t i : index_) {
+    low_[i] = x_[i] - radius_[i] - skin_ / 2;
+  }
+  if (reset) {
+    order_ = index_;
+    std::sort(order_.begin(), order_.end(), [this](uint32_t a, uint32_t b) {
+      return low_[a] < low_[b] || (!(low_[b] < low_[a]) && a < b);
+    });
+  } else {
+    for (size_t k = 1; k < n; ++k) {
+      uint32_t moving = order_[k];
+      size_t j = k;
+      for (; j > 0 && low_[order_[j - 1]] > low_[moving]; --j) {
+        order_[j] = order_[j - 1];
+      }
+      swaps_ += k - j;
+      order_[j] = moving;
+    }
+  }
+
+  // Each entity meets the entities after it in the order until their left
+  // ends pass its right end.
+  pairs_.clear();
+  for (size_t k = 0; k < n; ++k) {
+    uint32_t a = order_[k];
+    double high = x_[a] + radius_[a] + skin_ / 2;
+    for (size_t k2 = k + 1; k2 < n && low_[order_[k2]] <= high; ++k2) {
+      uint32_t b = order_[k2];
+      if (std::fabs(y_[a] - y_[b]) > radius_[a] + radius_[b] + skin_) {
+        continue;
+      }
+      pairs_.push_back({mobile_of_[a], b});
+      pairs_.push_back({mobile_of_[b], a});
+    }
+  }
+  SetCandidates(&pairs_);
+  return true;
+}
+
+NAMESPACE_END(csci3081);
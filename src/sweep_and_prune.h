@@ -0,0 +1,66 @@
+/**
+ * @file sweep_and_prune.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SWEEP_AND_PRUNE_H_
+#define SRC_SWEEP_AND_PRUNE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "src/broadphase.h"
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Sweep and prune along x: the mobile entities are kept sorted by the
+ * left end of their x extent (padded by skin/2), and the candidates are the
+ * pairs whose padded extents overlap in both x and y.
+ *
+ * Unlike a grid, this needs no cell size, so it copes with radii that vary
+ * widely. The order persists from step to step and is repaired by
+ * insertion sort, which is close to linear because entities move little
+ * between steps. The candidates are found anew every step.
+ */
+class SweepAndPrune : public Broadphase {
+ public:
+  explicit SweepAndPrune(double skin);
+
+  int get_kind() const override { return kBroadphaseSweepAndPrune; }
+
+  /**
+   * @brief Number of insertion sort moves so far; a measure of how much the
+   * x order churns.
+   */
+  uint64_t get_swaps() const { return swaps_; }
+
+ protected:
+  bool Update(const std::vector<ArenaEntity *> &entities,
+              const std::vector<ArenaMobileEntity *> &mobile,
+              bool reset) override;
+
+ private:
+  // Mobile entities' entity indices by low_, and each one's padded left end
+  // in x.
+  std::vector<uint32_t> order_;
+  std::vector<double> low_;
+  std::vector<std::pair<uint32_t, uint32_t>> pairs_;
+  uint64_t swaps_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SWEEP_AND_PRUNE_H_
@@ -0,0 +1,106 @@
+/**
+ * @file sweep_main.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "src/result_cache.h"
+#include "src/sweep.h"
+#include "src/sweep_sink.h"
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+static int Usage(const char *argv0) {
+  std::cerr << "usage: " << argv0 << " --sweep sweep_file --out results.csv"
+            << " [--threads n] [--cache dir]" << std::endl;
+  return 1;
+}
+
+/**
+ * @brief Parameter sweep: runs every configuration of a sweep file (see
+ * Sweep) to its first starvation or step budget, in parallel, and streams
+ * one CSV line per job to the output file. Running it again on the same
+ * output file only runs the jobs that are missing from it, and with a
+ * `--cache` directory, jobs that any earlier sweep already ran are not
+ * simulated again.
+ */
+int main(int argc, char **argv) {
+  std::string sweep_path;
+  std::string out_path;
+  std::string cache_dir;
+  size_t n_threads = 0;
+  for (int i = 1; i < argc; i += 2) {
+    std::string option = argv[i];
+    if (i + 1 >= argc) {
+      return Usage(argv[0]);
+    } else if (option == "--sweep") {
+      sweep_path = argv[i + 1];
+    } else if (option == "--out") {
+      out_path = argv[i + 1];
+    } else if (option == "--cache") {
+      cache_dir = argv[i + 1];
+    } else if (option == "--threads") {
+      n_threads = std::strtoul(argv[i + 1], nullptr, 10);
+      if (n_threads == 0) {
+        return Usage(argv[0]);
+      }
+    } else {
+      return Usage(argv[0]);
+    }
+  }
+  if (sweep_path.empty() || out_path.empty()) {
+    return Usage(argv[0]);
+  }
+
+  csci3081::Sweep sweep;
+  std::string error;
+  if (!sweep.Load(sweep_path, &error)) {
+    std::cerr << error << std::endl;
+    return 1;
+  }
+  csci3081::SweepSink sink;
+  if (!sink.Open(out_path, sweep, &error)) {
+    std::cerr << error << std::endl;
+    return 1;
+  }
+  csci3081::ResultCache cache;
+  if (!cache_dir.empty() && !cache.Open(cache_dir)) {
+    std::cerr << "Cannot use result cache " << cache_dir << std::endl;
+    return 1;
+  }
+  if (n_threads == 0) {
+    n_threads = sweep.get_base().n_threads;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  size_t run = sweep.Run(&sink, n_threads,
+                         cache_dir.empty() ? nullptr : &cache);
+  double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  if (!sink.Close()) {
+    std::cerr << "Error writing results " << out_path << std::endl;
+    return 1;
+  }
+
+  std::printf("jobs:     %zu\n", sweep.get_jobs().size());
+  std::printf("resumed:  %zu\n", sink.get_resumed_count());
+  std::printf("run:      %zu on %zu threads\n", run, n_threads);
+  if (!cache_dir.empty()) {
+    std::printf("cache:    %zu of %zu hit (%.1f%%)\n", cache.get_hits(),
+                cache.get_lookups(),
+                cache.get_lookups() > 0
+                    ? 100.0 * cache.get_hits() / cache.get_lookups() : 0.0);
+  }
+  std::printf("seconds:  %.3f\n", seconds);
+  return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file sweep_sink.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <unistd.h>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+#include "src/sweep_sink.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * File Format
+ ******************************************************************************/
+// A comment line identifying the sweep, the column names, then one line per
+// finished job.
+static const char kSweepColumns[] =
+    "job,seed,robots,lights,food,fear_percent,light_sensitivity,food_on,"
+    "steps,starved_step,stopped,checksum,seconds,cached";
+
+static std::string SweepTag(const Sweep &sweep) {
+  std::ostringstream tag;
+  tag << "# arenasweep fingerprint=" << std::hex << std::setw(16)
+      << std::setfill('0') << sweep.get_fingerprint() << std::dec
+      << " jobs=" << sweep.get_jobs().size();
+  return tag.str();
+}
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+SweepSink::SweepSink()
+    : out_(), mutex_(), done_(), resumed_(0), failed_(false) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+bool SweepSink::Open(const std::string &path, const Sweep &sweep,
+                     std::string *error) {
+  done_.assign(sweep.get_jobs().size(), false);
+  resumed_ = 0;
+  failed_ = false;
+  std::string header = SweepTag(sweep) + "\n" + kSweepColumns + "\n";
+
+  std::string contents;
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    contents = buffer.str();
+  }
+  // A file cut off within the header holds no results yet.
+  if (contents.size() <= header.size() &&
+      header.compare(0, contents.size(), contents) == 0) {
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    out_ << header << std::flush;
+  } else {
+    if (contents.compare(0, header.size(), header) != 0) {
+      *error = path + ": holds the results of a different sweep";
+      return false;
+    }
+    // Keep the complete lines; a job killed mid-write is run again.
+    size_t keep = contents.rfind('\n') + 1;
+    std::istringstream lines(contents.substr(header.size(),
+                                             keep - header.size()));
+    std::string line;
+    for (int number = 3; std::getline(lines, line); ++number) {
+      char *end = nullptr;
+      unsigned long index = std::strtoul(line.c_str(), &end, 10);  // NOLINT
+      if (end == line.c_str() || *end != ',' || index >= done_.size()) {
+        std::ostringstream where;
+        where << path << ":" << number << ": not a result line";
+        *error = where.str();
+        return false;
+      }
+      if (!done_[index]) {
+        done_[index] = true;
+        ++resumed_;
+      }
+    }
+    if (keep < contents.size() && truncate(path.c_str(), keep) != 0) {
+      *error = path + ": cannot drop the partly written last line";
+      return false;
+    }
+    out_.open(path, std::ios::binary | std::ios::app);
+  }
+  if (!out_) {
+    *error = path + ": cannot write results";
+    return false;
+  }
+  return true;
+}
+
+void SweepSink::Write(const SweepJob &job, const SweepResult &result) {
+  std::ostringstream line;
+  line << job.index << "," << job.seed << "," << job.n_robots << ","
+       << job.n_lights << "," << job.n_food << "," << job.fear_percent << ","
+       << job.light_sensitivity << "," << job.food_on << "," << result.steps
+       << "," << result.starved_step << ","
+       << StopReasonName(result.stopped) << "," << std::hex << std::setw(16)
+       << std::setfill('0') << result.checksum << std::dec << ","
+       << std::fixed << std::setprecision(6) << result.seconds << ","
+       << (result.cached ? 1 : 0) << "\n";
+  std::lock_guard<std::mutex> lock(mutex_);
+  out_ << line.str() << std::flush;
+  failed_ = failed_ || !out_;
+  if (job.index < done_.size()) {
+    done_[job.index] = true;
+  }
+}
+
+bool SweepSink::Close() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (out_.is_open()) {
+    out_.close();
+  }
+  return !failed_ && !out_.fail();
+}
+
+NAMESPACE_END(csci3081);
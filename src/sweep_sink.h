@@ -0,0 +1,90 @@
+/**
+ * @file sweep_sink.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SWEEP_SINK_H_
+#define SRC_SWEEP_SINK_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "src/common.h"
+#include "src/sweep.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief The CSV file a Sweep streams its results to, one line per job in
+ * the order they finish.
+ *
+ * Every line is flushed as soon as it is written, so a sweep that is
+ * killed loses at most the jobs that were running. Opening the same file
+ * again for the same sweep keeps its results, so that only the missing jobs
+ * are run.
+ */
+class SweepSink {
+ public:
+  SweepSink();
+
+  SweepSink(const SweepSink &other) = delete;
+  SweepSink &operator=(const SweepSink &other) = delete;
+
+  /**
+   * @brief Open `path` for the results of `sweep`.
+   *
+   * A missing or empty file is started with a header. A file written by the
+   * same sweep is resumed: its complete lines count as done and a partly
+   * written last line is dropped.
+   *
+   * @return false if the file cannot be written or holds another sweep's
+   * results.
+   */
+  bool Open(const std::string &path, const Sweep &sweep, std::string *error);
+
+  /**
+   * @brief Append a job's result. Safe to call from several threads.
+   */
+  void Write(const SweepJob &job, const SweepResult &result);
+
+  /**
+   * @brief Whether the result of job `index` is already in the file.
+   */
+  bool is_done(uint32_t index) const {
+    return index < done_.size() && done_[index];
+  }
+
+  /**
+   * @brief Number of jobs found in the file when it was opened.
+   */
+  size_t get_resumed_count() const { return resumed_; }
+
+  /**
+   * @brief Close the file. @return false if any write failed.
+   */
+  bool Close();
+
+ private:
+  std::ofstream out_;
+  std::mutex mutex_;
+  std::vector<bool> done_;
+  size_t resumed_;
+  bool failed_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SWEEP_SINK_H_
@@ -0,0 +1,186 @@
+/**
+ * @file swept_collision.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "src/arena_entity.h"
+#include "src/arena_mobile_entity.h"
+#include "src/broadphase.h"
+#include "src/swept_collision.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+// Entities are stopped this far inside their first contact, so that the
+// collision pass, which counts touching as colliding, still finds it.
+static const double kContactSlop = 1e-6;
+// Bound on the sweeps per step; each only shortens motions, so few are
+// needed outside of dense crowds.
+static const int kMaxRounds = 8;
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+bool SweptCircleHit(double px, double py, double dx, double dy, double radius,
+                    double *t) {
+  // Solve |p + t d| = radius for its smaller root.
+  double c = px * px + py * py - radius * radius;
+  double a = dx * dx + dy * dy;
+  double b = px * dx + py * dy;
+  if (!(c > 0) || !(a > 0) || !(b < 0)) {
+    return false;
+  }
+  double discriminant = b * b - a * c;
+  if (discriminant < 0) {
+    return false;
+  }
+  double hit = (-b - std::sqrt(discriminant)) / a;
+  if (hit > 1) {
+    return false;
+  }
+  *t = hit;
+  return true;
+}
+
+// When a center moving from c0 to c1 first leaves [low, high], as a
+// fraction of the motion, lowered into `t`.
+static void WallHit(double c0, double c1, double low, double high,
+                    double *t) {
+  if (c0 > low && c1 <= low) {
+    *t = std::min(*t, (c0 - low + kContactSlop) / (c0 - c1));
+  } else if (c0 < high && c1 >= high) {
+    *t = std::min(*t, (high - c0 + kContactSlop) / (c1 - c0));
+  }
+}
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+SweptCollision::SweptCollision()
+    : x0_(), y0_(), mobile_index_(), t_(), moved_(), rewinds_(0) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void SweptCollision::Begin(const std::vector<ArenaMobileEntity *> &mobile) {
+  x0_.resize(mobile.size());
+  y0_.resize(mobile.size());
+  for (size_t m = 0; m < mobile.size(); ++m) {
+    x0_[m] = mobile[m]->get_pose().x;
+    y0_[m] = mobile[m]->get_pose().y;
+  }
+}
+
+size_t SweptCollision::Rewind(const std::vector<ArenaEntity *> &entities,
+                              const std::vector<ArenaMobileEntity *> &mobile,
+                              double x_dim, double y_dim,
+                              Broadphase *broadphase) {
+  mobile_index_.assign(entities.size(), -1);
+  size_t next = 0;
+  for (size_t m = 0; m < mobile.size(); ++m) {
+    while (entities[next] != mobile[m]) {
+      ++next;
+    }
+    mobile_index_[next] = static_cast<int32_t>(m);
+  }
+  // Moved back, every entity stays on its motion, so stays within the
+  // longest motion of where it is now.
+  double reach = 0;
+  for (size_t m = 0; m < mobile.size(); ++m) {
+    reach = std::max(reach, std::hypot(mobile[m]->get_pose().x - x0_[m],
+                                       mobile[m]->get_pose().y - y0_[m]));
+  }
+  const Broadphase *pairs =
+      broadphase && broadphase->Reach(entities, mobile, reach) ? broadphase
+                                                               : nullptr;
+  // An entity stopped short may now stand in the path of another that was
+  // swept against its whole motion, so the motions, shortened, are swept
+  // again until none is shortened further.
+  moved_.assign(mobile.size(), 0);
+  for (int round = 0; round < kMaxRounds; ++round) {
+    t_.assign(mobile.size(), 1);
+    for (size_t m = 0; m < mobile.size(); ++m) {
+      FirstContact(entities, mobile, m, x_dim, y_dim, pairs);
+    }
+    bool shortened = false;
+    for (size_t m = 0; m < mobile.size(); ++m) {
+      double x1 = mobile[m]->get_pose().x, y1 = mobile[m]->get_pose().y;
+      double back = (1 - t_[m]) * std::hypot(x1 - x0_[m], y1 - y0_[m]);
+      if (back > kContactSlop) {
+        mobile[m]->set_position(x0_[m] + t_[m] * (x1 - x0_[m]),
+                                y0_[m] + t_[m] * (y1 - y0_[m]));
+        moved_[m] = 1;
+        shortened = true;
+      }
+    }
+    if (!shortened) {
+      break;
+    }
+  }
+  size_t moved = static_cast<size_t>(
+      std::count(moved_.begin(), moved_.end(), 1));
+  rewinds_ += moved;
+  return moved;
+}
+
+void SweptCollision::FirstContact(
+    const std::vector<ArenaEntity *> &entities,
+    const std::vector<ArenaMobileEntity *> &mobile, size_t m, double x_dim,
+    double y_dim, const Broadphase *pairs) {
+  const ArenaMobileEntity *ent = mobile[m];
+  double x1 = ent->get_pose().x, y1 = ent->get_pose().y;
+  double dx = x1 - x0_[m], dy = y1 - y0_[m];
+  double r = ent->get_radius();
+  WallHit(x0_[m], x1, r, x_dim - r, &t_[m]);
+  WallHit(y0_[m], y1, r, y_dim - r, &t_[m]);
+  auto sweep = [&](uint32_t j) {
+    const ArenaEntity *other = entities[j];
+    // The other's start and motion; the origin of the relative motion.
+    double ox = other->get_pose().x, oy = other->get_pose().y;
+    double odx = 0, ody = 0;
+    if (mobile_index_[j] >= 0) {
+      size_t k = static_cast<size_t>(mobile_index_[j]);
+      odx = ox - x0_[k];
+      ody = oy - y0_[k];
+      ox = x0_[k];
+      oy = y0_[k];
+    }
+    double within = r + other->get_radius();
+    double rx = dx - odx, ry = dy - ody;
+    double px = x0_[m] - ox, py = y0_[m] - oy;
+    // No hit unless the relative motion reaches within range.
+    if (std::fabs(px) - std::fabs(rx) > within ||
+        std::fabs(py) - std::fabs(ry) > within) {
+      return;
+    }
+    double hit = 1;
+    if (SweptCircleHit(px, py, rx, ry, within - kContactSlop, &hit)) {
+      t_[m] = std::min(t_[m], hit);
+    }
+  };
+  if (pairs) {
+    for (auto it = pairs->begin(m); it != pairs->end(m); ++it) {
+      sweep(*it);
+    }
+    return;
+  }
+  for (uint32_t j = 0; j < entities.size(); ++j) {
+    if (entities[j] != ent) {
+      sweep(j);
+    }
+  }
+}
+
+NAMESPACE_END(csci3081);
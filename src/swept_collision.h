@@ -0,0 +1,111 @@
+/**
+ * @file swept_collision.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_SWEPT_COLLISION_H_
+#define SRC_SWEPT_COLLISION_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+class ArenaEntity;
+class ArenaMobileEntity;
+class Broadphase;
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Stops mobile entities at the first contact along each step's
+ * motion, so that a step longer than an entity is wide cannot carry it
+ * through another entity or deep into a wall.
+ *
+ * The collision pass only tests where a step leaves the entities. Here each
+ * mobile entity's motion over the step is taken as a straight segment, and
+ * its time of impact found by sweeping its circle along that segment:
+ * against every other mobile entity's (by their relative motion), every
+ * other entity's, and the walls. With a broadphase, only the pairs it finds
+ * within reach of the step's longest motion are swept. An entity with an
+ * impact is moved back to just inside its first contact, where the
+ * collision pass then finds and handles it as usual. An entity stopped
+ * short of where another entity expected to meet it only makes the other's
+ * motion more cautious, never less.
+ */
+class SweptCollision {
+ public:
+  SweptCollision();
+
+  /**
+   * @brief Remember where the mobile entities start the step.
+   */
+  void Begin(const std::vector<ArenaMobileEntity *> &mobile);
+
+  /**
+   * @brief Move each mobile entity that met another entity or a wall since
+   * Begin() back along its motion to its first contact. `mobile` must be
+   * the same mobile subset of `entities`, in order, as given to Begin().
+   * The pairs are taken from `broadphase` where it can find them all (see
+   * Broadphase::Reach()), and otherwise every pair is swept.
+   *
+   * @return Number of mobile entities moved back.
+   */
+  size_t Rewind(const std::vector<ArenaEntity *> &entities,
+                const std::vector<ArenaMobileEntity *> &mobile,
+                double x_dim, double y_dim,
+                Broadphase *broadphase = nullptr);
+
+  /**
+   * @brief Number of mobile entities moved back over all Rewind() calls.
+   */
+  uint64_t get_rewinds() const { return rewinds_; }
+
+ private:
+  /**
+   * @brief Lower t_[m] to mobile entity `m`'s first contact along its
+   * motion, from Begin() to its pose now, among `pairs`' candidates for it,
+   * or every entity if `pairs` is null.
+   */
+  void FirstContact(const std::vector<ArenaEntity *> &entities,
+                    const std::vector<ArenaMobileEntity *> &mobile, size_t m,
+                    double x_dim, double y_dim, const Broadphase *pairs);
+
+  // The mobile entities' poses at Begin().
+  std::vector<double> x0_;
+  std::vector<double> y0_;
+  // The mobile entity each entity is, or -1.
+  std::vector<int32_t> mobile_index_;
+  // Each mobile entity's first contact, as a fraction of its motion.
+  std::vector<double> t_;
+  // Whether each mobile entity has been moved back this step.
+  std::vector<uint8_t> moved_;
+  uint64_t rewinds_;
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief When a circle at (`px`, `py`) moving by (`dx`, `dy`) first comes
+ * within `radius` of the origin, as a fraction of the motion, into `t`.
+ *
+ * @return false if it does not within the motion, or starts within it.
+ */
+bool SweptCircleHit(double px, double py, double dx, double dy, double radius,
+                    double *t);
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SWEPT_COLLISION_H_
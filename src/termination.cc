@@ -0,0 +1,186 @@
+/**
+ * @file termination.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+
+#include "src/arena.h"
+#include "src/termination.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+const char *StopReasonName(StopReason reason) {
+  switch (reason) {
+    case kStopNone: return "none";
+    case kStopStepBudget: return "step_budget";
+    case kStopTimeBudget: return "time_budget";
+    case kStopFirstStarved: return "first_starved";
+    case kStopAllStarved: return "all_starved";
+    case kStopCannotStarve: return "cannot_starve";
+    case kStopSteadyState: return "steady_state";
+    default: return "unknown";
+  }
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void StepBudgetCondition::Start(const Arena &arena) {
+  end_ = static_cast<uint64_t>(arena.get_step()) + steps_;
+}
+
+StopReason StepBudgetCondition::Check(const Arena &arena) {
+  return arena.get_step() >= end_ ? kStopStepBudget : kStopNone;
+}
+
+uint32_t StepBudgetCondition::StepsBeforeCheck(const Arena &arena) const {
+  uint64_t step = arena.get_step();
+  return static_cast<uint32_t>(
+      end_ > step ? std::min<uint64_t>(end_ - step, UINT32_MAX) : 1);
+}
+
+void TimeBudgetCondition::Start(const Arena &) {
+  start_ = std::chrono::steady_clock::now();
+}
+
+StopReason TimeBudgetCondition::Check(const Arena &) {
+  double elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start_).count();
+  return elapsed >= seconds_ ? kStopTimeBudget : kStopNone;
+}
+
+// Few enough that even full steps do not overrun the budget by much.
+uint32_t TimeBudgetCondition::StepsBeforeCheck(const Arena &) const {
+  return 64;
+}
+
+void StarvationCondition::Start(const Arena &arena) {
+  can_starve_ = arena.CountRobots(kRobotFoodOn, kRobotFoodOn) > 0;
+}
+
+StopReason StarvationCondition::Check(const Arena &arena) {
+  if (!can_starve_) {
+    return kStopCannotStarve;
+  }
+  // The Arena marks the game lost as soon as any robot starves, so the
+  // robots only need a look from then on.
+  if (arena.get_game_status() != LOST) {
+    return kStopNone;
+  } else if (!all_) {
+    return kStopFirstStarved;
+  }
+  for (auto robot : arena.robot()) {
+    if (!robot->RobotStarving()) {
+      return kStopNone;
+    }
+  }
+  return kStopAllStarved;
+}
+
+// The game is only lost in a step that checks the robots' hunger, which is
+// never part of a quiet run (see Arena::AdvanceSteps()).
+uint32_t StarvationCondition::StepsBeforeCheck(const Arena &) const {
+  return UINT32_MAX;
+}
+
+void SteadyStateCondition::Start(const Arena &arena) {
+  Capture(arena);
+}
+
+StopReason SteadyStateCondition::Check(const Arena &arena) {
+  if (arena.get_step() < next_check_) {
+    return kStopNone;
+  }
+  std::vector<ArenaEntity *> entities = arena.get_entities();
+  bool moved = entities.size() != poses_.size();
+  for (size_t i = 0; i < entities.size() && !moved; ++i) {
+    double dx = entities[i]->get_pose().x - poses_[i].x;
+    double dy = entities[i]->get_pose().y - poses_[i].y;
+    moved = dx * dx + dy * dy > epsilon_ * epsilon_;
+  }
+  if (!moved) {
+    return kStopSteadyState;
+  }
+  Capture(arena);
+  return kStopNone;
+}
+
+uint32_t SteadyStateCondition::StepsBeforeCheck(const Arena &arena) const {
+  uint64_t step = arena.get_step();
+  return static_cast<uint32_t>(
+      next_check_ > step ? std::min<uint64_t>(next_check_ - step, UINT32_MAX)
+                         : 1);
+}
+
+void SteadyStateCondition::Capture(const Arena &arena) {
+  poses_.clear();
+  for (auto ent : arena.get_entities()) {
+    poses_.push_back(ent->get_pose());
+  }
+  next_check_ = static_cast<uint64_t>(arena.get_step()) + window_;
+}
+
+// Outcomes before budgets, so that a run which starves on its last step
+// says so.
+Termination::Termination(const arena_params &params) : conditions_() {
+  if (params.stop_on_starvation != kStarvationIgnore) {
+    Add(new StarvationCondition(
+        params.stop_on_starvation == kStarvationAll));
+  }
+  if (params.steady_epsilon > 0 && params.steady_window > 0) {
+    Add(new SteadyStateCondition(params.steady_epsilon,
+                                 params.steady_window));
+  }
+  if (params.max_steps > 0) {
+    Add(new StepBudgetCondition(params.max_steps));
+  }
+  if (params.max_seconds > 0) {
+    Add(new TimeBudgetCondition(params.max_seconds));
+  }
+}
+
+void Termination::Start(const Arena &arena) {
+  for (auto &condition : conditions_) {
+    condition->Start(arena);
+  }
+}
+
+StopReason Termination::Check(const Arena &arena) {
+  for (auto &condition : conditions_) {
+    StopReason reason = condition->Check(arena);
+    if (reason != kStopNone) {
+      return reason;
+    }
+  }
+  return kStopNone;
+}
+
+uint32_t Termination::StepsBeforeCheck(const Arena &arena) const {
+  uint32_t steps = UINT32_MAX;
+  for (auto &condition : conditions_) {
+    steps = std::min(steps, condition->StepsBeforeCheck(arena));
+  }
+  return steps;
+}
+
+StopReason Termination::Run(Arena *arena) {
+  Start(*arena);
+  StopReason reason;
+  while ((reason = Check(*arena)) == kStopNone) {
+    arena->AdvanceSteps(StepsBeforeCheck(*arena));
+  }
+  return reason;
+}
+
+NAMESPACE_END(csci3081);
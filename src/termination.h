@@ -0,0 +1,201 @@
+/**
+ * @file termination.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_TERMINATION_H_
+#define SRC_TERMINATION_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "src/arena_params.h"
+#include "src/common.h"
+#include "src/pose.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+class Arena;
+
+/*******************************************************************************
+ * Enums
+ ******************************************************************************/
+/**
+ * @brief Why a headless run stopped.
+ */
+enum StopReason {
+  kStopNone = 0,       // still running
+  kStopStepBudget,     // ran its max_steps
+  kStopTimeBudget,     // ran out of wall-clock time
+  kStopFirstStarved,   // a robot starved
+  kStopAllStarved,     // every robot is starving
+  kStopCannotStarve,   // waiting for starvation, but food is off
+  kStopSteadyState,    // nothing moves any more
+};
+
+/**
+ * @brief The name of `reason` as written by the runner and the sweep, e.g.
+ * "first_starved".
+ */
+const char *StopReasonName(StopReason reason);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief One reason for a headless run to stop, checked between steps.
+ *
+ * Start() is called once before the first check; Check() is called before
+ * every step and must be cheap next to the step itself. A run may take
+ * several steps between checks, as StepsBeforeCheck() allows.
+ */
+class TerminationCondition {
+ public:
+  TerminationCondition() {}
+  virtual ~TerminationCondition() = default;
+
+  virtual void Start(const Arena &arena) = 0;
+  virtual StopReason Check(const Arena &arena) = 0;
+
+  /**
+   * @brief How many steps, at least 1, may run before the next Check()
+   * without the condition being met unseen.
+   */
+  virtual uint32_t StepsBeforeCheck(const Arena &) const { return 1; }
+};
+
+/**
+ * @brief Stops after a number of steps from Start().
+ */
+class StepBudgetCondition : public TerminationCondition {
+ public:
+  explicit StepBudgetCondition(uint32_t steps) : steps_(steps), end_(0) {}
+
+  void Start(const Arena &arena) override;
+  StopReason Check(const Arena &arena) override;
+  uint32_t StepsBeforeCheck(const Arena &arena) const override;
+
+ private:
+  uint32_t steps_;
+  uint64_t end_;
+};
+
+/**
+ * @brief Stops once `seconds` of wall-clock time have passed since Start().
+ * A run stopped by it is not reproducible.
+ */
+class TimeBudgetCondition : public TerminationCondition {
+ public:
+  explicit TimeBudgetCondition(double seconds)
+      : seconds_(seconds), start_() {}
+
+  void Start(const Arena &arena) override;
+  StopReason Check(const Arena &arena) override;
+  uint32_t StepsBeforeCheck(const Arena &arena) const override;
+
+ private:
+  double seconds_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Stops when a robot starves, or when every robot is starving.
+ *
+ * A robot only gets hungry while food is on, so if no robot has food on
+ * the outcome is already decided and the run stops before its first step.
+ */
+class StarvationCondition : public TerminationCondition {
+ public:
+  explicit StarvationCondition(bool all) : all_(all), can_starve_(true) {}
+
+  void Start(const Arena &arena) override;
+  StopReason Check(const Arena &arena) override;
+  uint32_t StepsBeforeCheck(const Arena &arena) const override;
+
+ private:
+  bool all_;
+  bool can_starve_;
+};
+
+/**
+ * @brief Stops when no entity has moved more than `epsilon` over the last
+ * `window` steps. Positions are only compared once per window.
+ */
+class SteadyStateCondition : public TerminationCondition {
+ public:
+  SteadyStateCondition(double epsilon, uint32_t window)
+      : epsilon_(epsilon), window_(window), next_check_(0), poses_() {}
+
+  void Start(const Arena &arena) override;
+  StopReason Check(const Arena &arena) override;
+  uint32_t StepsBeforeCheck(const Arena &arena) const override;
+
+ private:
+  void Capture(const Arena &arena);
+
+  double epsilon_;
+  uint32_t window_;
+  uint64_t next_check_;
+  std::vector<Pose> poses_;
+};
+
+/**
+ * @brief The set of conditions a headless run stops on; the first one met
+ * gives the reason.
+ */
+class Termination {
+ public:
+  Termination() : conditions_() {}
+
+  /**
+   * @brief The conditions set in `params`: max_steps, max_seconds,
+   * stop_on_starvation and the steady state window.
+   */
+  explicit Termination(const arena_params &params);
+
+  /**
+   * @brief Add a condition; the Termination owns it.
+   */
+  void Add(TerminationCondition *condition) {
+    conditions_.emplace_back(condition);
+  }
+
+  bool empty() const { return conditions_.empty(); }
+
+  void Start(const Arena &arena);
+
+  /**
+   * @brief The reason the run should stop before its next step, or
+   * kStopNone to go on.
+   */
+  StopReason Check(const Arena &arena);
+
+  /**
+   * @brief How many steps may run before the next Check(): the fewest any
+   * condition allows.
+   */
+  uint32_t StepsBeforeCheck(const Arena &arena) const;
+
+  /**
+   * @brief Start(), then advance `arena` (see Arena::AdvanceSteps()) until
+   * a condition is met. At least one condition must be able to stop the
+   * run.
+   */
+  StopReason Run(Arena *arena);
+
+ private:
+  std::vector<std::unique_ptr<TerminationCondition>> conditions_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_TERMINATION_H_
@@ -0,0 +1,102 @@
+/**
+ * @file timer_wheel.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+
+#include "src/timer_wheel.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+TimerWheel::TimerWheel()
+    : slots_(kLevels * kSlots), overflow_(), cascading_(), now_(0),
+      size_(0) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void TimerWheel::Clear(uint64_t now) {
+  for (auto &slot : slots_) {
+    slot.clear();
+  }
+  overflow_.clear();
+  now_ = now;
+  size_ = 0;
+}
+
+void TimerWheel::Schedule(uint64_t due, uint32_t id) {
+  Insert({due > now_ ? due : now_ + 1, id});
+  ++size_;
+}
+
+void TimerWheel::Advance(std::vector<uint32_t> *fired) {
+  ++now_;
+  // Higher levels first, so that their timers can cascade all the way down
+  // to the slot fired below.
+  if ((now_ & ((uint64_t{1} << (kLevelBits * kLevels)) - 1)) == 0) {
+    Cascade(&overflow_);
+  }
+  for (int level = kLevels - 1; level > 0; --level) {
+    int shift = kLevelBits * level;
+    if ((now_ & ((uint64_t{1} << shift) - 1)) == 0) {
+      Cascade(&slots_[level * kSlots + ((now_ >> shift) & (kSlots - 1))]);
+    }
+  }
+  std::vector<Timer> &due = slots_[now_ & (kSlots - 1)];
+  for (auto &timer : due) {
+    fired->push_back(timer.id);
+  }
+  size_ -= due.size();
+  due.clear();
+}
+
+uint64_t TimerWheel::NextDue() const {
+  uint64_t next = UINT64_MAX;
+  for (auto &slot : slots_) {
+    for (auto &timer : slot) {
+      next = std::min(next, timer.due);
+    }
+  }
+  for (auto &timer : overflow_) {
+    next = std::min(next, timer.due);
+  }
+  return next;
+}
+
+// A timer goes on the lowest level whose slots still tell its step apart
+// from the current one.
+void TimerWheel::Insert(const Timer &timer) {
+  uint64_t diff = timer.due ^ now_;
+  int level = 0;
+  while (level < kLevels && (diff >> (kLevelBits * (level + 1))) != 0) {
+    ++level;
+  }
+  if (level == kLevels) {
+    overflow_.push_back(timer);
+  } else {
+    int shift = kLevelBits * level;
+    slots_[level * kSlots + ((timer.due >> shift) & (kSlots - 1))]
+        .push_back(timer);
+  }
+}
+
+void TimerWheel::Cascade(std::vector<Timer> *slot) {
+  cascading_.swap(*slot);
+  for (auto &timer : cascading_) {
+    Insert(timer);
+  }
+  cascading_.clear();
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,98 @@
+/**
+ * @file timer_wheel.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_TIMER_WHEEL_H_
+#define SRC_TIMER_WHEEL_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A hierarchical timer wheel: timers identified by a 32-bit id that
+ * fire at a given step, with constant-time scheduling and constant
+ * amortized work per step however many timers are pending.
+ *
+ * Each of the four levels has 64 slots; level L holds the timers due within
+ * 64^(L+1) steps, and its slots are moved down a level as the clock reaches
+ * them. Timers further out than 64^4 steps wait in an overflow list.
+ *
+ * Timers cannot be cancelled; the owner ignores, or reschedules, a timer
+ * that is no longer wanted when it fires.
+ */
+class TimerWheel {
+ public:
+  TimerWheel();
+
+  /**
+   * @brief Drop every timer and set the clock to `now`.
+   */
+  void Clear(uint64_t now);
+
+  /**
+   * @brief Fire `id` at step `due`; a `due` not after the current step
+   * fires on the next Advance().
+   */
+  void Schedule(uint64_t due, uint32_t id);
+
+  /**
+   * @brief Move the clock on one step and append the ids of the timers
+   * due at the new step to `fired`. The order depends only on the calls
+   * made so far, so it is the same in every run.
+   */
+  void Advance(std::vector<uint32_t> *fired);
+
+  /**
+   * @brief The earliest step any timer is due at, or UINT64_MAX if none
+   * is pending. Looks at every timer, so it is for planning ahead, not
+   * for every step.
+   */
+  uint64_t NextDue() const;
+
+  uint64_t get_now() const { return now_; }
+  size_t size() const { return size_; }
+
+ private:
+  struct Timer {
+    uint64_t due;
+    uint32_t id;
+  };
+
+  static const int kLevelBits = 6;
+  static const int kSlots = 1 << kLevelBits;
+  static const int kLevels = 4;
+
+  void Insert(const Timer &timer);
+
+  /**
+   * @brief Re-insert every timer of `slot`, which the clock has reached.
+   */
+  void Cascade(std::vector<Timer> *slot);
+
+  // kLevels * kSlots slots, level by level.
+  std::vector<std::vector<Timer>> slots_;
+  std::vector<Timer> overflow_;
+  std::vector<Timer> cascading_;
+  uint64_t now_;
+  size_t size_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_TIMER_WHEEL_H_
@@ -0,0 +1,137 @@
+/**
+ * @file trajectory_format.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_TRAJECTORY_FORMAT_H_
+#define SRC_TRAJECTORY_FORMAT_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constants
+ ******************************************************************************/
+/*
+ * Layout of a trajectory file (all values little-endian):
+ *
+ *   header   "RTRJ" u32:version u32:column_count
+ *            column_count x { u8:type u8:name_length name }
+ *   chunk*   "CHNK" u32:first_step u32:step_count u32:row_count
+ *            (step_count + 1) x u32 row offsets of each step in the chunk
+ *            column_count x column data (row_count values each)
+ *   footer   "TIDX" u64:chunk_count
+ *            chunk_count x { u32:first_step u32:step_count u32:row_count
+ *                            u32:reserved u64:file_offset_of_chunk }
+ *   trailer  u64:file_offset_of_footer "RTRJ"
+ *
+ * Every step holds one row per entity, in Arena entity order, and the steps of
+ * a chunk are consecutive. The trailer has a fixed size so a reader can find
+ * the footer index from the end of the file and seek straight to the chunk
+ * holding any step. Readers match columns by name, so columns may be added
+ * without breaking older files.
+ */
+static const char kTrajectoryMagic[4] = {'R', 'T', 'R', 'J'};
+static const char kTrajectoryChunkMagic[4] = {'C', 'H', 'N', 'K'};
+static const char kTrajectoryIndexMagic[4] = {'T', 'I', 'D', 'X'};
+static const uint32_t kTrajectoryVersion = 1;
+static const size_t kTrajectoryChunkHeaderSize = 16;
+static const size_t kTrajectoryIndexEntrySize = 24;
+static const size_t kTrajectoryTrailerSize = 12;
+
+/**
+ * @brief Storage type of a trajectory column.
+ */
+enum TrajectoryColumnType {
+  kColumnU8 = 0,
+  kColumnU32,
+  kColumnI32,
+  kColumnF32,
+  kColumnF64
+};
+
+/**
+ * @brief The columns of a trajectory file, in file order.
+ */
+enum TrajectoryColumn {
+  kColStep = 0,
+  kColId,
+  kColType,
+  kColFlags,
+  kColX,
+  kColY,
+  kColTheta,
+  kColRadius,
+  kColColorR,
+  kColColorG,
+  kColColorB,
+  kColVelLeft,
+  kColVelRight,
+  kColLeftLight,
+  kColRightLight,
+  kColLeftFood,
+  kColRightFood,
+  kColTimeCounter,
+  kColBehavior,
+  kTrajectoryColumnCount
+};
+
+/**
+ * @brief Name and storage type of one column.
+ */
+struct TrajectoryColumnInfo {
+  const char *name;
+  TrajectoryColumnType type;
+};
+
+static const TrajectoryColumnInfo
+    kTrajectoryColumns[kTrajectoryColumnCount] = {
+  {"step", kColumnU32},
+  {"id", kColumnI32},
+  {"type", kColumnU8},
+  {"flags", kColumnU8},
+  {"x", kColumnF64},
+  {"y", kColumnF64},
+  {"theta", kColumnF64},
+  {"radius", kColumnF32},
+  {"color_r", kColumnU8},
+  {"color_g", kColumnU8},
+  {"color_b", kColumnU8},
+  {"vel_left", kColumnF64},
+  {"vel_right", kColumnF64},
+  {"left_light", kColumnF64},
+  {"right_light", kColumnF64},
+  {"left_food", kColumnF64},
+  {"right_food", kColumnF64},
+  {"time_counter", kColumnI32},  // in whole units of time
+  {"behavior", kColumnU8},
+};
+
+/**
+ * @brief Size in bytes of one value of the given column type.
+ */
+inline size_t TrajectoryColumnSize(TrajectoryColumnType type) {
+  switch (type) {
+    case kColumnU8: return 1;
+    case kColumnU32:
+    case kColumnI32:
+    case kColumnF32: return 4;
+    case kColumnF64: return 8;
+    default: return 0;
+  }
+}
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_TRAJECTORY_FORMAT_H_
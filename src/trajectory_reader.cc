@@ -0,0 +1,196 @@
+/**
+ * @file trajectory_reader.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+
+#include "src/trajectory_reader.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+TrajectoryReader::TrajectoryReader()
+    : file_column_(),
+      file_column_sizes_(),
+      file_row_prefix_(),
+      chunks_(),
+      data_(nullptr),
+      size_(0),
+      first_step_(0),
+      last_step_(0),
+      step_count_(0) {}
+
+TrajectoryReader::~TrajectoryReader() { Close(); }
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+bool TrajectoryReader::Open(const std::string &path) {
+  Close();
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+    close(fd);
+    return false;
+  }
+  size_t size = static_cast<size_t>(info.st_size);
+  void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+  data_ = static_cast<const uint8_t *>(map);
+  size_ = size;
+
+  // Column table.
+  BinaryReader in(data_, size_);
+  if (!in.Expect(kTrajectoryMagic, sizeof(kTrajectoryMagic)) ||
+      in.GetU32() != kTrajectoryVersion) {
+    Close();
+    return false;
+  }
+  uint32_t columns = in.GetU32();
+  size_t row_bytes = 0;
+  std::fill(file_column_, file_column_ + kTrajectoryColumnCount, -1);
+  for (uint32_t j = 0; j < columns && in.ok(); ++j) {
+    TrajectoryColumnType type = static_cast<TrajectoryColumnType>(in.GetU8());
+    std::string name(in.GetU8(), '\0');
+    in.GetBytes(&name[0], name.size());
+    if (TrajectoryColumnSize(type) == 0) {
+      Close();
+      return false;
+    }
+    file_row_prefix_.push_back(row_bytes);
+    file_column_sizes_.push_back(TrajectoryColumnSize(type));
+    row_bytes += TrajectoryColumnSize(type);
+    for (int c = 0; c < kTrajectoryColumnCount; ++c) {
+      if (name == kTrajectoryColumns[c].name &&
+          type == kTrajectoryColumns[c].type) {
+        file_column_[c] = static_cast<int>(j);
+      }
+    }
+  }
+
+  // Footer index, found through the fixed-size trailer.
+  if (!in.ok() || size_ < in.position() + kTrajectoryTrailerSize) {
+    Close();
+    return false;
+  }
+  in.Seek(size_ - kTrajectoryTrailerSize);
+  uint64_t footer = in.GetU64();
+  if (!in.Expect(kTrajectoryMagic, sizeof(kTrajectoryMagic)) ||
+      footer > size_ - kTrajectoryTrailerSize) {
+    Close();
+    return false;
+  }
+  in.Seek(footer);
+  uint64_t n = 0;
+  if (in.Expect(kTrajectoryIndexMagic, sizeof(kTrajectoryIndexMagic))) {
+    n = in.GetU64();
+  }
+  if (!in.ok() || n > in.remaining() / kTrajectoryIndexEntrySize) {
+    Close();
+    return false;
+  }
+  for (uint64_t i = 0; i < n; ++i) {
+    ChunkRef chunk;
+    chunk.first_step = in.GetU32();
+    chunk.step_count = in.GetU32();
+    chunk.row_count = in.GetU32();
+    in.GetU32();
+    chunk.offset = in.GetU64();
+    // The chunk's header, row offsets and columns must all lie before the
+    // footer.
+    uint64_t bytes = kTrajectoryChunkHeaderSize +
+                     (uint64_t{chunk.step_count} + 1) * 4;
+    bytes += uint64_t{chunk.row_count} * row_bytes;
+    if (chunk.step_count == 0 || chunk.offset > footer ||
+        bytes > footer - chunk.offset ||
+        (!chunks_.empty() &&
+         chunk.first_step < chunks_.back().first_step +
+                            chunks_.back().step_count)) {
+      Close();
+      return false;
+    }
+    chunks_.push_back(chunk);
+    step_count_ += chunk.step_count;
+  }
+  if (!chunks_.empty()) {
+    first_step_ = chunks_.front().first_step;
+    last_step_ = chunks_.back().first_step + chunks_.back().step_count - 1;
+  }
+  return true;
+}
+
+void TrajectoryReader::Close() {
+  if (data_ != nullptr) {
+    munmap(const_cast<uint8_t *>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  file_column_sizes_.clear();
+  file_row_prefix_.clear();
+  chunks_.clear();
+  first_step_ = 0;
+  last_step_ = 0;
+  step_count_ = 0;
+}
+
+bool TrajectoryReader::ReadStep(uint32_t step, TrajectoryFrame *frame) const {
+  // Last chunk starting at or before `step`.
+  auto it = std::upper_bound(
+      chunks_.begin(), chunks_.end(), step,
+      [](uint32_t s, const ChunkRef &c) { return s < c.first_step; });
+  if (it == chunks_.begin()) {
+    return false;
+  }
+  const ChunkRef &chunk = *(it - 1);
+  uint32_t i = step - chunk.first_step;
+  if (i >= chunk.step_count) {
+    return false;
+  }
+  const uint8_t *base = data_ + chunk.offset;
+  if (std::memcmp(base, kTrajectoryChunkMagic,
+                  sizeof(kTrajectoryChunkMagic)) != 0) {
+    return false;
+  }
+  const uint8_t *offsets = base + kTrajectoryChunkHeaderSize;
+  uint32_t row_begin = LoadLE<uint32_t>(offsets + i * 4);
+  uint32_t row_end = LoadLE<uint32_t>(offsets + (i + 1) * 4);
+  if (row_begin > row_end || row_end > chunk.row_count) {
+    return false;
+  }
+
+  // Columns follow the row offsets back to back, in file order.
+  const uint8_t *columns = offsets + (chunk.step_count + 1) * 4;
+  frame->step = step;
+  frame->rows = row_end - row_begin;
+  for (int c = 0; c < kTrajectoryColumnCount; ++c) {
+    int j = file_column_[c];
+    frame->columns[c] =
+        j < 0 ? nullptr
+              : columns + chunk.row_count * file_row_prefix_[j] +
+                    row_begin * file_column_sizes_[j];
+  }
+  return true;
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,137 @@
+/**
+ * @file trajectory_reader.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_TRAJECTORY_READER_H_
+#define SRC_TRAJECTORY_READER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/binary_io.h"
+#include "src/common.h"
+#include "src/trajectory_format.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief The rows of one recorded step, pointing straight into the mapped
+ * file. Valid until the TrajectoryReader is closed.
+ */
+struct TrajectoryFrame {
+  uint32_t step{0};
+  uint32_t rows{0};
+  // Start of this step's values in each column; nullptr if the file does
+  // not have the column.
+  const uint8_t *columns[kTrajectoryColumnCount] = {};
+
+  /**
+   * @brief Value of `column` in `row`, or zero if the column is missing.
+   * `T` must match the column's type in kTrajectoryColumns.
+   */
+  template <typename T>
+  T Get(TrajectoryColumn column, uint32_t row) const {
+    assert(sizeof(T) == TrajectoryColumnSize(kTrajectoryColumns[column].type));
+    if (columns[column] == nullptr) {
+      return T();
+    }
+    return LoadLE<T>(columns[column] + row * sizeof(T));
+  }
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Random access to a trajectory file written by TrajectoryRecorder.
+ *
+ * The file is memory-mapped rather than read, so opening a long recording is
+ * immediate and only the pages of the steps actually looked at are loaded.
+ * Finding a step is a binary search of the footer index followed by a lookup
+ * in the chunk's row offsets, so seeking costs the same anywhere in the file
+ * and in either direction.
+ */
+class TrajectoryReader {
+ public:
+  TrajectoryReader();
+
+  /**
+   * @brief Unmaps the file.
+   */
+  ~TrajectoryReader();
+
+  TrajectoryReader(const TrajectoryReader &other) = delete;
+  TrajectoryReader &operator=(const TrajectoryReader &other) = delete;
+
+  /**
+   * @brief Map `path` and load its column table and chunk index.
+   *
+   * @return false if the file is missing, truncated (e.g. the recorder was
+   * never closed) or not a trajectory file.
+   */
+  bool Open(const std::string &path);
+
+  void Close();
+
+  bool is_open() const { return data_ != nullptr; }
+
+  /**
+   * @brief First and last recorded step. Only meaningful if get_step_count()
+   * is not zero.
+   */
+  uint32_t get_first_step() const { return first_step_; }
+  uint32_t get_last_step() const { return last_step_; }
+
+  /**
+   * @brief Number of steps in the file.
+   */
+  uint64_t get_step_count() const { return step_count_; }
+
+  size_t get_chunk_count() const { return chunks_.size(); }
+
+  /**
+   * @brief Locate the rows recorded for `step`.
+   *
+   * @return false if the step is not in the file.
+   */
+  bool ReadStep(uint32_t step, TrajectoryFrame *frame) const;
+
+ private:
+  struct ChunkRef {
+    uint32_t first_step;
+    uint32_t step_count;
+    uint32_t row_count;
+    uint64_t offset;
+  };
+
+  // Where each known column is in the file's column order, or -1.
+  int file_column_[kTrajectoryColumnCount];
+  // Sizes of the file's columns, in file order.
+  std::vector<size_t> file_column_sizes_;
+  // Bytes per row of the file's columns before each one, in file order.
+  std::vector<size_t> file_row_prefix_;
+  std::vector<ChunkRef> chunks_;
+  const uint8_t *data_;
+  size_t size_;
+  uint32_t first_step_;
+  uint32_t last_step_;
+  uint64_t step_count_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_TRAJECTORY_READER_H_
@@ -0,0 +1,282 @@
+/**
+ * @file trajectory_recorder.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cstring>
+
+#include "src/trajectory_recorder.h"
+#include "src/arena_entity.h"
+#include "src/binary_io.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Static Helpers
+ ******************************************************************************/
+template <typename T>
+static void PutRow(std::vector<uint8_t> *column, uint32_t row, T v) {
+  StoreLE(v, &(*column)[row * sizeof(T)]);
+}
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+TrajectoryRecorder::TrajectoryRecorder()
+    : open_(false),
+      failed_(false),
+      steps_per_chunk_(256),
+      chunks_queued_(0),
+      extra_buffers_(0),
+      active_(nullptr),
+      mutex_(),
+      cond_(),
+      full_(),
+      free_(),
+      stopping_(false),
+      writer_(),
+      out_(),
+      offset_(0),
+      index_(),
+      chunks_() {}
+
+TrajectoryRecorder::~TrajectoryRecorder() {
+  Close();
+  for (auto chunk : chunks_) {
+    delete chunk;
+  }
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+bool TrajectoryRecorder::Open(const std::string &path, int steps_per_chunk) {
+  if (open_ || steps_per_chunk < 1) {
+    return false;
+  }
+  out_.open(path, std::ios::binary | std::ios::trunc);
+  if (!out_) {
+    return false;
+  }
+  BinaryWriter header;
+  header.PutBytes(kTrajectoryMagic, sizeof(kTrajectoryMagic));
+  header.PutU32(kTrajectoryVersion);
+  header.PutU32(kTrajectoryColumnCount);
+  for (auto &info : kTrajectoryColumns) {
+    header.PutU8(static_cast<uint8_t>(info.type));
+    header.PutU8(static_cast<uint8_t>(std::strlen(info.name)));
+    header.PutBytes(info.name, std::strlen(info.name));
+  }
+  out_.write(reinterpret_cast<const char *>(header.bytes().data()),
+             static_cast<std::streamsize>(header.size()));
+
+  open_ = true;
+  failed_ = !out_;
+  steps_per_chunk_ = steps_per_chunk;
+  chunks_queued_ = 0;
+  extra_buffers_ = 0;
+  offset_ = header.size();
+  index_.clear();
+  // Two buffers: one being filled, one being written.
+  while (chunks_.size() < 2) {
+    chunks_.push_back(new Chunk);
+  }
+  free_ = chunks_;
+  full_.clear();
+  stopping_ = false;
+  writer_ = std::thread(&TrajectoryRecorder::WriterLoop, this);
+  return true;
+}
+
+void TrajectoryRecorder::Record(uint32_t step,
+                                const std::vector<ArenaEntity *> &entities) {
+  if (!open_) {
+    return;
+  }
+  // A chunk only ever holds consecutive steps.
+  if (active_ != nullptr && step != active_->first_step + active_->step_count) {
+    SubmitChunk();
+  }
+  if (active_ == nullptr) {
+    active_ = AcquireChunk();
+    active_->first_step = step;
+    active_->step_count = 0;
+    active_->row_count = 0;
+    active_->row_offsets.assign(1, 0);
+  }
+  Chunk *chunk = active_;
+  GrowChunk(chunk, chunk->row_count + static_cast<uint32_t>(entities.size()));
+
+  EntityState st;
+  for (auto ent : entities) {
+    ent->SaveState(&st);
+    uint32_t row = chunk->row_count++;
+    std::vector<uint8_t> *col = chunk->columns;
+    PutRow<uint32_t>(&col[kColStep], row, step);
+    PutRow<int32_t>(&col[kColId], row, st.id);
+    PutRow<uint8_t>(&col[kColType], row, static_cast<uint8_t>(st.type));
+    PutRow<uint8_t>(&col[kColFlags], row, static_cast<uint8_t>(st.flags));
+    PutRow<double>(&col[kColX], row, st.x);
+    PutRow<double>(&col[kColY], row, st.y);
+    PutRow<double>(&col[kColTheta], row, st.theta);
+    PutRow<float>(&col[kColRadius], row, static_cast<float>(st.radius));
+    PutRow<uint8_t>(&col[kColColorR], row, st.color_r);
+    PutRow<uint8_t>(&col[kColColorG], row, st.color_g);
+    PutRow<uint8_t>(&col[kColColorB], row, st.color_b);
+    PutRow<double>(&col[kColVelLeft], row, st.vel_left);
+    PutRow<double>(&col[kColVelRight], row, st.vel_right);
+    PutRow<double>(&col[kColLeftLight], row, st.left_light_reading);
+    PutRow<double>(&col[kColRightLight], row, st.right_light_reading);
+    PutRow<double>(&col[kColLeftFood], row, st.left_food_reading);
+    PutRow<double>(&col[kColRightFood], row, st.right_food_reading);
+    PutRow<int32_t>(&col[kColTimeCounter], row,
+                    static_cast<int32_t>(st.time_counter));
+    PutRow<uint8_t>(&col[kColBehavior], row,
+                    static_cast<uint8_t>(st.behavior_flag));
+  }
+  ++chunk->step_count;
+  chunk->row_offsets.push_back(chunk->row_count);
+  if (chunk->step_count == static_cast<uint32_t>(steps_per_chunk_)) {
+    SubmitChunk();
+  }
+}
+
+bool TrajectoryRecorder::Close() {
+  if (!open_) {
+    return !failed_;
+  }
+  SubmitChunk();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cond_.notify_one();
+  writer_.join();
+
+  BinaryWriter footer;
+  footer.PutBytes(kTrajectoryIndexMagic, sizeof(kTrajectoryIndexMagic));
+  footer.PutU64(index_.size());
+  for (auto &entry : index_) {
+    footer.PutU32(entry.first_step);
+    footer.PutU32(entry.step_count);
+    footer.PutU32(entry.row_count);
+    footer.PutU32(0);
+    footer.PutU64(entry.offset);
+  }
+  footer.PutU64(offset_);
+  footer.PutBytes(kTrajectoryMagic, sizeof(kTrajectoryMagic));
+  out_.write(reinterpret_cast<const char *>(footer.bytes().data()),
+             static_cast<std::streamsize>(footer.size()));
+  out_.close();
+  failed_ = failed_ || !out_;
+  open_ = false;
+  return !failed_;
+}
+
+TrajectoryRecorder::Chunk *TrajectoryRecorder::AcquireChunk() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_.empty()) {
+      Chunk *chunk = free_.back();
+      free_.pop_back();
+      return chunk;
+    }
+  }
+  // The writer still holds every buffer; never wait for it.
+  Chunk *chunk = new Chunk;
+  chunks_.push_back(chunk);
+  ++extra_buffers_;
+  return chunk;
+}
+
+void TrajectoryRecorder::GrowChunk(Chunk *chunk, uint32_t rows) {
+  size_t capacity = chunk->columns[kColStep].size() /
+                    TrajectoryColumnSize(kTrajectoryColumns[kColStep].type);
+  if (rows <= capacity) {
+    return;
+  }
+  // Size for a whole chunk of steps at the current entity count, so a
+  // recycled buffer never grows again during a run.
+  size_t per_step = rows - chunk->row_count;
+  capacity = std::max<size_t>(rows, per_step * steps_per_chunk_);
+  for (int c = 0; c < kTrajectoryColumnCount; ++c) {
+    chunk->columns[c].resize(capacity *
+                             TrajectoryColumnSize(kTrajectoryColumns[c].type));
+  }
+  chunk->row_offsets.reserve(steps_per_chunk_ + 1);
+}
+
+void TrajectoryRecorder::SubmitChunk() {
+  if (active_ == nullptr) {
+    return;
+  }
+  if (active_->step_count == 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(active_);
+  } else {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      full_.push_back(active_);
+    }
+    cond_.notify_one();
+    ++chunks_queued_;
+  }
+  active_ = nullptr;
+}
+
+void TrajectoryRecorder::WriterLoop() {
+  for (;;) {
+    Chunk *chunk;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [this] { return stopping_ || !full_.empty(); });
+      if (full_.empty()) {
+        return;
+      }
+      chunk = full_.front();
+      full_.pop_front();
+    }
+    WriteChunk(*chunk);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      free_.push_back(chunk);
+    }
+  }
+}
+
+void TrajectoryRecorder::WriteChunk(const Chunk &chunk) {
+  BinaryWriter header;
+  header.PutBytes(kTrajectoryChunkMagic, sizeof(kTrajectoryChunkMagic));
+  header.PutU32(chunk.first_step);
+  header.PutU32(chunk.step_count);
+  header.PutU32(chunk.row_count);
+  for (auto row : chunk.row_offsets) {
+    header.PutU32(row);
+  }
+  index_.push_back({chunk.first_step, chunk.step_count, chunk.row_count,
+                    offset_});
+  out_.write(reinterpret_cast<const char *>(header.bytes().data()),
+             static_cast<std::streamsize>(header.size()));
+  offset_ += header.size();
+  // The columns are already little-endian; write the used part of each.
+  for (int c = 0; c < kTrajectoryColumnCount; ++c) {
+    size_t bytes = chunk.row_count *
+                   TrajectoryColumnSize(kTrajectoryColumns[c].type);
+    out_.write(reinterpret_cast<const char *>(chunk.columns[c].data()),
+               static_cast<std::streamsize>(bytes));
+    offset_ += bytes;
+  }
+  if (!out_) {
+    failed_ = true;
+  }
+}
+
+NAMESPACE_END(csci3081);
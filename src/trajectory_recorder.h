@@ -0,0 +1,165 @@
+/**
+ * @file trajectory_recorder.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_TRAJECTORY_RECORDER_H_
+#define SRC_TRAJECTORY_RECORDER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/common.h"
+#include "src/trajectory_format.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+class ArenaEntity;
+
+/**
+ * @brief Records every entity's state at every step into a columnar
+ * trajectory file (see trajectory_format.h).
+ *
+ * The simulation thread calls Record() once per step. Rows are encoded
+ * straight into the column arrays of the current in-memory chunk; when the
+ * chunk holds `steps_per_chunk` steps it is handed to a background thread,
+ * which writes it while the simulation fills the other buffer. The
+ * simulation thread only ever takes the lock to swap buffer pointers, never
+ * while a chunk is being written. Should the disk fall behind so that no
+ * buffer is free, another one is allocated rather than waiting (see
+ * get_extra_buffers()).
+ *
+ * Typical use:
+ *
+ *     TrajectoryRecorder recorder;
+ *     recorder.Open("run.traj");
+ *     arena->set_trajectory_recorder(&recorder);
+ *     ... step the arena ...
+ *     recorder.Close();
+ */
+class TrajectoryRecorder {
+ public:
+  TrajectoryRecorder();
+
+  /**
+   * @brief Calls Close().
+   */
+  ~TrajectoryRecorder();
+
+  TrajectoryRecorder(const TrajectoryRecorder &other) = delete;
+  TrajectoryRecorder &operator=(const TrajectoryRecorder &other) = delete;
+
+  /**
+   * @brief Create the file, write its header and start the writer thread.
+   *
+   * @param[in] path The file to create or overwrite.
+   * @param[in] steps_per_chunk Steps per column chunk; also the granularity
+   * at which a reader can seek.
+   *
+   * @return false if the file could not be created or a recording is
+   * already open.
+   */
+  bool Open(const std::string &path, int steps_per_chunk = 256);
+
+  /**
+   * @brief Append one row per entity for the given step.
+   *
+   * Steps are expected to increase by one per call; a jump starts a new
+   * chunk.
+   */
+  void Record(uint32_t step, const std::vector<ArenaEntity *> &entities);
+
+  /**
+   * @brief Flush the partial chunk, wait for the writer thread and finish
+   * the file with its footer index. Safe to call more than once.
+   *
+   * @return false if any write failed.
+   */
+  bool Close();
+
+  bool is_open() const { return open_; }
+
+  /**
+   * @brief Number of chunks handed to the writer thread so far.
+   */
+  int get_chunks_queued() const { return chunks_queued_; }
+
+  /**
+   * @brief Number of buffers allocated beyond the initial two because the
+   * writer thread had not finished with either of them.
+   */
+  int get_extra_buffers() const { return extra_buffers_; }
+
+ private:
+  /**
+   * @brief One chunk of rows, stored as little-endian column arrays.
+   */
+  struct Chunk {
+    uint32_t first_step{0};
+    uint32_t step_count{0};
+    uint32_t row_count{0};
+    std::vector<uint32_t> row_offsets{};
+    std::vector<uint8_t> columns[kTrajectoryColumnCount];
+  };
+
+  /**
+   * @brief Index entry written to the footer for each chunk.
+   */
+  struct IndexEntry {
+    uint32_t first_step;
+    uint32_t step_count;
+    uint32_t row_count;
+    uint64_t offset;
+  };
+
+  Chunk *AcquireChunk();
+  void GrowChunk(Chunk *chunk, uint32_t rows);
+  void SubmitChunk();
+  void WriterLoop();
+  void WriteChunk(const Chunk &chunk);
+
+  bool open_;
+  bool failed_;
+  int steps_per_chunk_;
+  int chunks_queued_;
+  int extra_buffers_;
+
+  // Touched by the simulation thread only.
+  Chunk *active_;
+
+  // Shared with the writer thread, guarded by mutex_.
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<Chunk *> full_;
+  std::vector<Chunk *> free_;
+  bool stopping_;
+
+  // Touched by the writer thread only (and by Open()/Close() around it).
+  std::thread writer_;
+  std::ofstream out_;
+  uint64_t offset_;
+  std::vector<IndexEntry> index_;
+
+  // Every buffer ever allocated, for cleanup.
+  std::vector<Chunk *> chunks_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_TRAJECTORY_RECORDER_H_
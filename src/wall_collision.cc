@@ -0,0 +1,68 @@
+/**
+ * @file wall_collision.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/arena_mobile_entity.h"
+#include "src/entity_type.h"
+#include "src/params.h"
+#include "src/wall_collision.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+WallCollision::WallCollision() : x_(), y_(), radius_(), masks_() {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+size_t WallCollision::Apply(const std::vector<ArenaMobileEntity *> &mobile,
+                            double x_dim, double y_dim) {
+  size_t n = mobile.size();
+  x_.resize(n);
+  y_.resize(n);
+  radius_.resize(n);
+  masks_.resize(n);
+  for (size_t m = 0; m < n; ++m) {
+    x_[m] = mobile[m]->get_pose().x;
+    y_[m] = mobile[m]->get_pose().y;
+    radius_[m] = mobile[m]->get_radius();
+  }
+  // Touching is tested where the edge meets the wall, and the entity moved
+  // WALL_BACKOFF further in. An entity wider than the arena goes to the
+  // right and bottom walls, as the first tested.
+  const uint8_t right = WallBit(kRightWall), left = WallBit(kLeftWall);
+  const uint8_t top = WallBit(kTopWall), bottom = WallBit(kBottomWall);
+  for (size_t m = 0; m < n; ++m) {
+    double x = x_[m], y = y_[m], r = radius_[m];
+    bool at_right = x + r >= x_dim, at_left = x - r <= 0;
+    bool at_bottom = y + r >= y_dim, at_top = y - r <= 0;
+    x = at_left ? r + WALL_BACKOFF : x;
+    x_[m] = at_right ? x_dim - (r + WALL_BACKOFF) : x;
+    y = at_top ? r + WALL_BACKOFF : y;
+    y_[m] = at_bottom ? y_dim - (r + WALL_BACKOFF) : y;
+    masks_[m] = static_cast<uint8_t>((at_right ? right : 0) |
+                                     (at_left ? left : 0) |
+                                     (at_top ? top : 0) |
+                                     (at_bottom ? bottom : 0));
+  }
+  size_t touched = 0;
+  for (size_t m = 0; m < n; ++m) {
+    if (masks_[m] != 0) {
+      mobile[m]->set_position(x_[m], y_[m]);
+      ++touched;
+    }
+  }
+  return touched;
+}
+
+NAMESPACE_END(csci3081);
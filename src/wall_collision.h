@@ -0,0 +1,68 @@
+/**
+ * @file wall_collision.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+#ifndef SRC_WALL_COLLISION_H_
+#define SRC_WALL_COLLISION_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+class ArenaMobileEntity;
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Moves every mobile entity that touches a wall back off it, in one
+ * pass, and records which walls each touched.
+ *
+ * The entities' positions and radii are copied into flat arrays, and x and
+ * y are each tested against both of their walls and moved on their own,
+ * with selects rather than branches, so the loop vectorizes and an entity
+ * in a corner is moved off both walls in the same step. An entity touching
+ * a wall is moved WALL_BACKOFF clear of it, as it always has been, and the
+ * walls it touched are kept as a mask of WallBit()s for it to react to.
+ */
+class WallCollision {
+ public:
+  WallCollision();
+
+  /**
+   * @brief Move each of `mobile` that touches a wall of an `x_dim` by
+   * `y_dim` arena back off it.
+   *
+   * @return Number of entities that touched a wall.
+   */
+  size_t Apply(const std::vector<ArenaMobileEntity *> &mobile, double x_dim,
+               double y_dim);
+
+  /**
+   * @brief The walls each mobile entity touched at the last Apply(), as
+   * WallBit()s, in the order given; 0 for none.
+   */
+  const std::vector<uint8_t> &get_masks() const { return masks_; }
+
+ private:
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> radius_;
+  std::vector<uint8_t> masks_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_WALL_COLLISION_H_
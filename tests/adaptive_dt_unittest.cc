@@ -0,0 +1,115 @@
+/**
+ * @file adaptive_dt_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/broadphase.h"
+#include "src/robot.h"
+#include "src/robot_fsm.h"
+#include "tests/arena_test_util.h"
+#ifdef ADAPTIVE_DT_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class AdaptiveDtTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    aparams.seed = 11;
+    aparams.x_dim = 4000;
+    aparams.y_dim = 3000;
+    aparams.n_robots = 4;
+    aparams.n_lights = 0;
+    aparams.n_food = 0;
+    aparams.food_on = 1;
+    aparams.dt = 4;
+    aparams.adaptive_dt = 1;
+    aparams.dt_min = 0.5;
+    aparams.neighbor_skin = 160;
+  }
+
+  // Run 200 steps; returns the shortest and longest steps taken.
+  void StepRange(double *shortest, double *longest) {
+    std::unique_ptr<csci3081::Arena> arena = MakeSeededArena(aparams);
+    *shortest = aparams.dt;
+    *longest = 0;
+    for (uint32_t s = 0; s < 200; ++s) {
+      arena->AdvanceTime(1);
+      *shortest = std::min(*shortest, arena->get_step_dt());
+      *longest = std::max(*longest, arena->get_step_dt());
+    }
+  }
+
+  csci3081::arena_params aparams;
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// A few robots in a large arena mostly take the longest step; packed into a
+// small one they keep to short steps.
+TEST_F(AdaptiveDtTest, FollowsCrowding) {
+  double shortest = 0, longest = 0;
+  StepRange(&shortest, &longest);
+  EXPECT_DOUBLE_EQ(longest, 4.0);
+  aparams.x_dim = 400;
+  aparams.y_dim = 400;
+  aparams.n_robots = 30;
+  StepRange(&shortest, &longest);
+  EXPECT_DOUBLE_EQ(shortest, 0.5);
+  EXPECT_LT(longest, 4.0);
+}
+
+// The steps are picked from the state alone, so the run is the same
+// whichever broadphase finds the clearance, or none.
+TEST_F(AdaptiveDtTest, DoesNotDependOnTheBroadphase) {
+  aparams.x_dim = 800;
+  aparams.y_dim = 600;
+  aparams.n_robots = 20;
+  aparams.n_food = 4;
+  uint64_t fixed = RunChecksum(aparams, 300);
+  aparams.broadphase = csci3081::kBroadphaseAllPairs;
+  EXPECT_EQ(RunChecksum(aparams, 300), fixed);
+  aparams.broadphase = csci3081::kBroadphaseQuadtree;
+  aparams.neighbor_skin = 40;
+  EXPECT_EQ(RunChecksum(aparams, 300), fixed);
+}
+
+// Hunger is counted in simulated time: with steps 2.5 long, robots get
+// hungry after 620 / 2.5 = 248 steps.
+TEST_F(AdaptiveDtTest, HungerRunsOnSimulatedTime) {
+  aparams.adaptive_dt = 0;
+  aparams.dt = 2.5;
+  std::unique_ptr<csci3081::Arena> arena = MakeSeededArena(aparams);
+  RunChecksum(arena.get(), 247);
+  EXPECT_EQ(arena->CountRobots(csci3081::kRobotHungry, 0), 4u);
+  arena->AdvanceTime(1);
+  EXPECT_EQ(arena->CountRobots(csci3081::kRobotHungry,
+                               csci3081::kRobotHungry), 4u);
+}
+
+// So is the arc after a collision: with steps 2.5 long, a robot arcs for
+// 25 / 2.5 = 10 steps.
+TEST_F(AdaptiveDtTest, ArcRunsOnSimulatedTime) {
+  csci3081::Robot robot(0);
+  robot.HandleCollision(csci3081::kTopWall);
+  for (int s = 0; s < 9; ++s) {
+    robot.TimestepUpdate(2.5);
+    EXPECT_TRUE(robot.get_state() & csci3081::kRobotArcing) << "step " << s;
+  }
+  robot.TimestepUpdate(2.5);
+  EXPECT_FALSE(robot.get_state() & csci3081::kRobotArcing);
+}
+
+#endif /* ADAPTIVE_DT_TESTS */
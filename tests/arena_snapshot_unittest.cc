@@ -0,0 +1,138 @@
+/**
+ * @file arena_snapshot_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/entity_type.h"
+#include "src/pose.h"
+#ifdef SNAPSHOT_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class ArenaSnapshotTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    arena = new csci3081::Arena(&aparams);
+    arena->AddRobot(csci3081::kRobot, 5);
+    arena->AddLight(csci3081::kLight, 2);
+    arena->AddFood(csci3081::kFood, 2);
+    arena->set_behavior_sensitivity_robot(2, 1.05, 1);
+    for (int i = 0; i < 50; ++i) {
+      arena->AdvanceTime(1);
+    }
+  }
+  virtual void TearDown() {
+    delete arena;
+    std::remove(path);
+  }
+
+  // Step the arena and return every entity's pose at the end.
+  std::vector<csci3081::Pose> Run(int steps) {
+    for (int i = 0; i < steps; ++i) {
+      arena->AdvanceTime(1);
+    }
+    std::vector<csci3081::Pose> poses;
+    for (auto ent : arena->get_entities()) {
+      poses.push_back(ent->get_pose());
+    }
+    return poses;
+  }
+
+  csci3081::arena_params aparams;
+  csci3081::Arena * arena;
+  const char * path = "arena_snapshot_unittest.bin";
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Restoring a snapshot and re-running must reproduce the original run.
+TEST_F(ArenaSnapshotTest, RoundTripReproducesRun) {
+  ASSERT_TRUE(arena->SaveSnapshot(path));
+  std::vector<csci3081::Pose> expected = Run(100);
+  ASSERT_TRUE(arena->LoadSnapshot(path));
+  std::vector<csci3081::Pose> actual = Run(100);
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_DOUBLE_EQ(expected[i].x, actual[i].x) << "entity " << i;
+    EXPECT_DOUBLE_EQ(expected[i].y, actual[i].y) << "entity " << i;
+    EXPECT_DOUBLE_EQ(expected[i].theta, actual[i].theta) << "entity " << i;
+  }
+}
+
+// A fresh arena with no entities must rebuild them from the file.
+TEST_F(ArenaSnapshotTest, LoadIntoEmptyArena) {
+  ASSERT_TRUE(arena->SaveSnapshot(path));
+  csci3081::Arena other(&aparams);
+  ASSERT_TRUE(other.LoadSnapshot(path));
+  ASSERT_EQ(other.get_entities().size(), arena->get_entities().size());
+  EXPECT_EQ(other.robot().size(), 5u);
+  for (size_t i = 0; i < other.get_entities().size(); ++i) {
+    EXPECT_EQ(other.get_entities()[i]->get_type(),
+              arena->get_entities()[i]->get_type());
+    EXPECT_DOUBLE_EQ(other.get_entities()[i]->get_radius(),
+                     arena->get_entities()[i]->get_radius());
+  }
+}
+
+// Missing or corrupt files must be rejected without touching the arena.
+TEST_F(ArenaSnapshotTest, RejectsBadFile) {
+  EXPECT_FALSE(arena->LoadSnapshot("no_such_snapshot.bin"));
+  FILE *f = std::fopen(path, "wb");
+  std::fputs("RSNP", f);
+  std::fclose(f);
+  EXPECT_FALSE(arena->LoadSnapshot(path));
+  EXPECT_EQ(arena->get_entities().size(), 9u);
+}
+
+// A record of an unknown entity type must be rejected, not created.
+TEST_F(ArenaSnapshotTest, RejectsBadEntityType) {
+  ASSERT_TRUE(arena->SaveSnapshot(path));
+  uint64_t checksum = arena->StateChecksum();
+  FILE *f = std::fopen(path, "r+b");
+  // The first record's type, right after the 84-byte header.
+  std::fseek(f, 84, SEEK_SET);
+  std::fputc(0x7f, f);
+  std::fclose(f);
+  EXPECT_FALSE(arena->LoadSnapshot(path));
+  EXPECT_EQ(arena->StateChecksum(), checksum);
+}
+
+// A clone must run exactly as the original; branches can then diverge, and
+// re-forking into an existing branch must reset it.
+TEST_F(ArenaSnapshotTest, CloneBranchesFromWarmState) {
+  csci3081::Arena *branch = arena->Clone();
+  EXPECT_EQ(branch->StateChecksum(), arena->StateChecksum());
+  EXPECT_EQ(branch->get_step(), 50u);
+  for (int i = 0; i < 100; ++i) {
+    arena->AdvanceTime(1);
+    branch->AdvanceTime(1);
+  }
+  EXPECT_EQ(branch->StateChecksum(), arena->StateChecksum());
+
+  csci3081::Arena *warm = arena->Clone();
+  branch->set_behavior_sensitivity_robot(5, 1.1, 1);
+  for (int i = 0; i < 100; ++i) {
+    branch->AdvanceTime(1);
+  }
+  EXPECT_NE(branch->StateChecksum(), arena->StateChecksum());
+  std::vector<csci3081::ArenaEntity *> entities = branch->get_entities();
+  branch->CopyFrom(*warm);
+  EXPECT_EQ(branch->get_entities(), entities);
+  EXPECT_EQ(branch->StateChecksum(), arena->StateChecksum());
+  delete warm;
+  delete branch;
+}
+
+#endif /* SNAPSHOT_TESTS */
@@ -0,0 +1,51 @@
+/**
+ * @file arena_test_util.h
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ *
+ * The run that the Arena's tests compare settings by: an arena seeded from
+ * aparams.seed and populated as a scenario is, stepped a number of steps,
+ * and summed up by its StateChecksum(). Each test then states only the
+ * settings it varies.
+ */
+
+#ifndef TESTS_ARENA_TEST_UTIL_H_
+#define TESTS_ARENA_TEST_UTIL_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <memory>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/scenario.h"
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+// A fresh arena for `aparams`, seeded from aparams.seed and populated.
+// `aparams` must outlive it.
+inline std::unique_ptr<csci3081::Arena> MakeSeededArena(
+    const csci3081::arena_params &aparams) {
+  std::unique_ptr<csci3081::Arena> arena(new csci3081::Arena(&aparams));
+  arena->Seed(aparams.seed);
+  csci3081::PopulateArena(aparams, arena.get());
+  return arena;
+}
+
+// Run `arena` on to step `steps`; returns its checksum there.
+inline uint64_t RunChecksum(csci3081::Arena *arena, uint32_t steps) {
+  while (arena->get_step() < steps) {
+    arena->AdvanceSteps(steps - arena->get_step());
+  }
+  return arena->StateChecksum();
+}
+
+// The checksum of a fresh arena for `aparams` after `steps` steps.
+inline uint64_t RunChecksum(const csci3081::arena_params &aparams,
+                            uint32_t steps) {
+  return RunChecksum(MakeSeededArena(aparams).get(), steps);
+}
+
+#endif  // TESTS_ARENA_TEST_UTIL_H_
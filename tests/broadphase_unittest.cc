@@ -0,0 +1,102 @@
+/**
+ * @file broadphase_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/broadphase.h"
+#include "tests/arena_test_util.h"
+#ifdef BROADPHASE_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class BroadphaseTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    aparams.seed = 9;
+    aparams.n_robots = 30;
+    aparams.n_lights = 4;
+    aparams.n_food = 4;
+    aparams.fear_count = 12;
+  }
+
+  // Run 1500 steps with `broadphase` and `skin`; returns the checksum.
+  uint64_t Run(int broadphase, double skin, uint64_t *builds) {
+    aparams.broadphase = broadphase;
+    aparams.neighbor_skin = skin;
+    std::unique_ptr<csci3081::Arena> arena = MakeSeededArena(aparams);
+    uint64_t checksum = RunChecksum(arena.get(), 1500);
+    const csci3081::Broadphase *used = arena->get_broadphase();
+    *builds = used != nullptr ? used->get_builds() : 0;
+    return checksum;
+  }
+
+  csci3081::arena_params aparams;
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// The broadphases only skip pairs that cannot collide, so every broadphase
+// and skin gives the same run as testing all pairs.
+TEST_F(BroadphaseTest, DoesNotChangeTheRun) {
+  uint64_t builds = 0;
+  uint64_t all_pairs = Run(csci3081::kBroadphaseAllPairs, 40, &builds);
+  EXPECT_EQ(Run(csci3081::kBroadphaseNeighborList, 0, &builds), all_pairs);
+  EXPECT_EQ(builds, 0u);
+  EXPECT_EQ(Run(csci3081::kBroadphaseSweepAndPrune, 2, &builds), all_pairs);
+  EXPECT_EQ(builds, 1500u);
+  EXPECT_EQ(Run(csci3081::kBroadphaseSweepAndPrune, 40, &builds), all_pairs);
+  EXPECT_EQ(Run(csci3081::kBroadphaseQuadtree, 6, &builds), all_pairs);
+  EXPECT_EQ(Run(csci3081::kBroadphaseQuadtree, 40, &builds), all_pairs);
+}
+
+// With the overlap solver, the broadphases also find the near pairs it
+// uses as contacts.
+TEST_F(BroadphaseTest, DoesNotChangeTheRelaxedRun) {
+  uint64_t builds = 0;
+  aparams.relax_passes = 8;
+  uint64_t all_pairs = Run(csci3081::kBroadphaseAllPairs, 40, &builds);
+  EXPECT_EQ(Run(csci3081::kBroadphaseNeighborList, 40, &builds), all_pairs);
+  EXPECT_EQ(Run(csci3081::kBroadphaseSweepAndPrune, 40, &builds), all_pairs);
+  EXPECT_EQ(Run(csci3081::kBroadphaseQuadtree, 40, &builds), all_pairs);
+  aparams.relax_passes = 0;
+  EXPECT_NE(Run(csci3081::kBroadphaseAllPairs, 40, &builds), all_pairs);
+}
+
+// Food never moves, so its hierarchy is built once and never refit, however
+// often the mobile entities' candidates are found.
+TEST_F(BroadphaseTest, BuildsStaticsOnce) {
+  for (int kind : {csci3081::kBroadphaseNeighborList,
+                   csci3081::kBroadphaseSweepAndPrune,
+                   csci3081::kBroadphaseQuadtree}) {
+    aparams.broadphase = kind;
+    std::unique_ptr<csci3081::Arena> arena = MakeSeededArena(aparams);
+    RunChecksum(arena.get(), 300);
+    const csci3081::StaticBvh &statics = arena->get_broadphase()->get_statics();
+    EXPECT_EQ(statics.size(), 4u);
+    EXPECT_EQ(statics.get_builds(), 1u);
+    EXPECT_EQ(statics.get_refits(), 0u);
+  }
+}
+
+// A wider skin makes neighbor lists that last longer.
+TEST_F(BroadphaseTest, NeighborListsRebuildLessWithWiderSkin) {
+  uint64_t narrow = 0, wide = 0;
+  EXPECT_EQ(Run(csci3081::kBroadphaseNeighborList, 6, &narrow),
+            Run(csci3081::kBroadphaseNeighborList, 40, &wide));
+  EXPECT_GT(narrow, wide);
+  EXPECT_LT(wide, 1500u);
+}
+
+#endif /* BROADPHASE_TESTS */
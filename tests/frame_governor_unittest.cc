@@ -0,0 +1,76 @@
+/**
+ * @file frame_governor_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include "src/frame_governor.h"
+#ifdef FRAME_GOVERNOR_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Frames over budget give up quality a level at a time, down to the
+// lowest; frames well under budget win it back, more slowly.
+TEST(FrameGovernorTest, HoldsTheBudget) {
+  csci3081::FrameGovernor governor(16);
+  EXPECT_EQ(governor.get_level(), 0);
+  EXPECT_TRUE(governor.draw_labels());
+  EXPECT_TRUE(governor.draw_sensors());
+  EXPECT_EQ(governor.sense_interval(), 1u);
+  int frames = 0;
+  while (governor.get_level() == 0 && frames < 1000) {
+    governor.Update(1, 20, 10);
+    ++frames;
+  }
+  EXPECT_EQ(governor.get_level(), 1);
+  EXPECT_FALSE(governor.draw_labels());
+  for (int i = 0; i < 1000; ++i) {
+    governor.Update(1, 20, 10);
+  }
+  EXPECT_EQ(governor.get_level(), csci3081::FrameGovernor::get_max_level());
+  EXPECT_FALSE(governor.draw_sensors());
+  EXPECT_GT(governor.sense_interval(), 1u);
+  EXPECT_EQ(governor.max_substeps(), 1u);
+
+  // Frames just under budget hold the level.
+  for (int i = 0; i < 1000; ++i) {
+    governor.Update(1, 10, 5);
+  }
+  EXPECT_EQ(governor.get_level(), csci3081::FrameGovernor::get_max_level());
+  int recovered = 0;
+  while (governor.get_level() > 0 && recovered < 10000) {
+    governor.Update(1, 4, 2);
+    ++recovered;
+  }
+  EXPECT_EQ(governor.get_level(), 0);
+  EXPECT_GT(recovered, frames);
+}
+
+// Frames that run no step do not hide the frames over budget between them.
+TEST(FrameGovernorTest, IgnoresFramesWithoutSteps) {
+  csci3081::FrameGovernor governor(16);
+  for (int i = 0; i < 100; ++i) {
+    governor.Update(0, 0, 2);
+    governor.Update(1, 30, 2);
+  }
+  EXPECT_DOUBLE_EQ(governor.get_frame_ms(), 32);
+  EXPECT_GT(governor.get_level(), 0);
+}
+
+// With no budget the governor keeps full quality.
+TEST(FrameGovernorTest, NoBudgetKeepsFullQuality) {
+  csci3081::FrameGovernor governor(0);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_FALSE(governor.Update(1, 100, 100));
+  }
+  EXPECT_EQ(governor.get_level(), 0);
+  EXPECT_DOUBLE_EQ(governor.get_frame_ms(), 200);
+}
+
+#endif /* FRAME_GOVERNOR_TESTS */
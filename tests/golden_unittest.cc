@@ -0,0 +1,216 @@
+/**
+ * @file golden_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ *
+ * Golden-trajectory determinism harness. Each scenario is run from a fixed
+ * seed through Arena::AdvanceTime() and, at every step, every entity's pose
+ * and every robot's hunger/collision state is compared against the file
+ * checked in under tests/golden/. Any change to simulation behavior -- e.g.
+ * a new collision kernel or broadphase -- shows up as the first step and
+ * entity that diverged.
+ *
+ * Modes, chosen through the environment:
+ *   (default)            exact match: poses must be bit-for-bit identical.
+ *   GOLDEN_TOLERANCE=x   poses may differ by up to x; states must still match.
+ *   GOLDEN_UPDATE=1      regenerate the golden files instead of comparing.
+ *
+ * `make golden` and `make golden-update` in tests/ run just these tests.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/binary_io.h"
+#include "src/entity_state.h"
+#include "src/entity_type.h"
+#ifdef GOLDEN_TESTS
+
+#ifndef GOLDEN_DIR
+#define GOLDEN_DIR "golden"
+#endif
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+// Everything about a scenario that determines its run.
+struct GoldenScenario {
+  const char *name;
+  uint64_t seed;
+  int robots;
+  int lights;
+  int food;
+  int fear;
+  float sensitivity;
+  int food_on;
+  int steps;
+  int relax_passes;
+};
+
+// One row of a golden file: what is compared for each entity at each step.
+struct GoldenRow {
+  double x;
+  double y;
+  double theta;
+  uint32_t flags;
+  int32_t time_counter;
+  int32_t collision_timer;
+};
+
+// "RGLD" u32:version u32:steps u32:entities, then steps x entities rows of
+// f64:x f64:y f64:theta u8:flags i32:time_counter i32:collision_timer.
+static const char kGoldenMagic[4] = {'R', 'G', 'L', 'D'};
+static const uint32_t kGoldenVersion = 1;
+
+class GoldenTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    const char *update = std::getenv("GOLDEN_UPDATE");
+    update_ = update != nullptr && std::string(update) == "1";
+    const char *tolerance = std::getenv("GOLDEN_TOLERANCE");
+    tolerance_ = tolerance != nullptr ? std::atof(tolerance) : 0.0;
+  }
+
+  // Bit-for-bit in exact mode, so that even a change in the last ulp (or
+  // of the sign of zero) is caught.
+  bool Same(double golden, double actual) const {
+    if (tolerance_ > 0) {
+      return std::fabs(golden - actual) <= tolerance_;
+    }
+    return std::memcmp(&golden, &actual, sizeof(double)) == 0;
+  }
+
+  static void Capture(const csci3081::Arena &arena,
+                      std::vector<GoldenRow> *rows) {
+    csci3081::EntityState st;
+    for (auto ent : arena.get_entities()) {
+      st = csci3081::EntityState();
+      ent->SaveState(&st);
+      rows->push_back({st.x, st.y, st.theta, st.flags,
+                       static_cast<int32_t>(st.time_counter),
+                       static_cast<int32_t>(st.collision_timer)});
+    }
+  }
+
+  void Run(const GoldenScenario &sc) {
+    csci3081::arena_params aparams;
+    aparams.relax_passes = sc.relax_passes;
+    csci3081::Arena arena(&aparams);
+    arena.Seed(sc.seed);
+    arena.AddRobot(csci3081::kRobot, sc.robots);
+    arena.AddLight(csci3081::kLight, sc.lights);
+    arena.AddFood(csci3081::kFood, sc.food);
+    arena.set_behavior_sensitivity_robot(sc.fear, sc.sensitivity, sc.food_on);
+    const uint32_t entities = arena.get_entities().size();
+    std::string path = std::string(GOLDEN_DIR) + "/" + sc.name + ".gld";
+
+    if (update_) {
+      std::vector<GoldenRow> rows;
+      for (int step = 0; step < sc.steps; ++step) {
+        arena.AdvanceTime(1);
+        Capture(arena, &rows);
+      }
+      csci3081::BinaryWriter out;
+      out.PutBytes(kGoldenMagic, sizeof(kGoldenMagic));
+      out.PutU32(kGoldenVersion);
+      out.PutU32(sc.steps);
+      out.PutU32(entities);
+      for (auto &row : rows) {
+        out.PutF64(row.x);
+        out.PutF64(row.y);
+        out.PutF64(row.theta);
+        out.PutU8(static_cast<uint8_t>(row.flags));
+        out.PutI32(row.time_counter);
+        out.PutI32(row.collision_timer);
+      }
+      ASSERT_TRUE(out.WriteFile(path)) << "cannot write " << path;
+      return;
+    }
+
+    std::vector<uint8_t> bytes;
+    ASSERT_TRUE(csci3081::ReadFileBytes(path, &bytes))
+        << "missing golden file " << path << " (run make golden-update)";
+    csci3081::BinaryReader in(bytes.data(), bytes.size());
+    ASSERT_TRUE(in.Expect(kGoldenMagic, sizeof(kGoldenMagic)) &&
+                in.GetU32() == kGoldenVersion) << path;
+    ASSERT_EQ(in.GetU32(), static_cast<uint32_t>(sc.steps)) << path;
+    ASSERT_EQ(in.GetU32(), entities) << path;
+
+    std::vector<GoldenRow> rows;
+    for (int step = 1; step <= sc.steps; ++step) {
+      arena.AdvanceTime(1);
+      rows.clear();
+      Capture(arena, &rows);
+      for (uint32_t e = 0; e < entities; ++e) {
+        GoldenRow golden;
+        golden.x = in.GetF64();
+        golden.y = in.GetF64();
+        golden.theta = in.GetF64();
+        golden.flags = in.GetU8();
+        golden.time_counter = in.GetI32();
+        golden.collision_timer = in.GetI32();
+        ASSERT_TRUE(in.ok()) << path << " is truncated";
+        const GoldenRow &actual = rows[e];
+        if (!Same(golden.x, actual.x) || !Same(golden.y, actual.y) ||
+            !Same(golden.theta, actual.theta) ||
+            golden.flags != actual.flags ||
+            golden.time_counter != actual.time_counter ||
+            golden.collision_timer != actual.collision_timer) {
+          std::ostringstream msg;
+          msg.precision(17);
+          msg << sc.name << ": first divergence at step " << step
+              << ", entity " << e << " ("
+              << arena.get_entities()[e]->get_name() << ")\n"
+              << "  golden: pose (" << golden.x << ", " << golden.y << ", "
+              << golden.theta << ") flags " << golden.flags
+              << " time_counter " << golden.time_counter
+              << " collision_timer " << golden.collision_timer << "\n"
+              << "  actual: pose (" << actual.x << ", " << actual.y << ", "
+              << actual.theta << ") flags " << actual.flags
+              << " time_counter " << actual.time_counter
+              << " collision_timer " << actual.collision_timer;
+          FAIL() << msg.str();
+        }
+      }
+    }
+  }
+
+  bool update_{false};
+  double tolerance_{0};
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// The default GUI scenario, long enough for robots to get hungry (step 620).
+TEST_F(GoldenTest, Basic) {
+  Run({"basic", 1, 5, 2, 2, 2, 1.05f, 1, 700, 0});
+}
+
+// Many more entities than the GUI allows, so collisions dominate.
+TEST_F(GoldenTest, Crowded) {
+  Run({"crowded", 7, 16, 5, 5, 8, 1.1f, 1, 250, 0});
+}
+
+// Food off: only light behaviors, all robots exploratory.
+TEST_F(GoldenTest, NoFood) {
+  Run({"no_food", 3, 6, 4, 0, 0, 1.0f, 0, 300, 0});
+}
+
+// The crowded scenario with the overlap solver separating contacts.
+TEST_F(GoldenTest, CrowdedRelaxed) {
+  Run({"crowded_relaxed", 7, 16, 5, 5, 8, 1.1f, 1, 250, 8});
+}
+
+#endif /* GOLDEN_TESTS */
@@ -0,0 +1,116 @@
+/**
+ * @file kinetic_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/kinetic_schedule.h"
+#include "tests/arena_test_util.h"
+#ifdef KINETIC_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class KineticTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    aparams.seed = 5;
+    aparams.x_dim = 4000;
+    aparams.y_dim = 3000;
+    aparams.n_robots = 10;
+    aparams.n_lights = 2;
+    aparams.n_food = 0;
+    aparams.food_on = 0;
+    aparams.fear_count = 4;
+    aparams.sensor_range = 100;
+  }
+
+  // Run 3000 steps, kinetic or not; returns the checksum.
+  uint64_t Run(int kinetic, uint64_t *coasted) {
+    aparams.kinetic = kinetic;
+    std::unique_ptr<csci3081::Arena> arena = MakeSeededArena(aparams);
+    uint64_t checksum = RunChecksum(arena.get(), 3000);
+    *coasted = arena->get_coasted_steps();
+    return checksum;
+  }
+
+  csci3081::arena_params aparams;
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Quiet steps run at once end where single steps would, and in a sparse
+// arena most steps are quiet.
+TEST_F(KineticTest, DoesNotChangeTheRun) {
+  uint64_t coasted = 0;
+  uint64_t fixed = Run(0, &coasted);
+  EXPECT_EQ(coasted, 0u);
+  EXPECT_EQ(Run(1, &coasted), fixed);
+  EXPECT_GT(coasted, 1500u);
+}
+
+// Hungry robots, and without a sensor range robots that respond to light,
+// go on sensing through quiet steps; with the overlap solver, longer steps
+// and ccd the run is still the same.
+TEST_F(KineticTest, DoesNotChangeOtherRuns) {
+  uint64_t coasted = 0;
+  aparams.n_food = 5;
+  aparams.food_on = 1;
+  aparams.sensor_range = 0;
+  EXPECT_EQ(Run(1, &coasted), Run(0, &coasted));
+  aparams.n_food = 0;
+  aparams.food_on = 0;
+  aparams.sensor_range = 100;
+  aparams.relax_passes = 4;
+  aparams.dt = 3;
+  aparams.ccd = 1;
+  uint64_t fixed = Run(0, &coasted);
+  EXPECT_EQ(Run(1, &coasted), fixed);
+  EXPECT_GT(coasted, 0u);
+}
+
+// Bodies moving straight are predicted to meet at the step they first come
+// within reach, and nothing is predicted for bodies moving apart.
+TEST_F(KineticTest, PredictsStraightMeetings) {
+  std::vector<csci3081::KineticBody> bodies(2);
+  bodies[0].x = 100;
+  bodies[0].y = 500;
+  bodies[0].radius = 10;
+  bodies[0].kind = csci3081::kKineticLight;
+  bodies[0].step_x = 2;
+  bodies[0].step_reach = 2;
+  bodies[1] = bodies[0];
+  bodies[1].x = 300;
+  bodies[1].step_x = -2;
+  for (auto &body : bodies) {
+    for (double &reach : body.reach) {
+      reach = body.radius;
+    }
+  }
+  csci3081::KineticSchedule schedule;
+  // 180 apart, closing by 4 a step: within 20 after 45 steps.
+  EXPECT_EQ(schedule.Update(bodies, 7, 1000, 1000), 52u);
+  EXPECT_EQ(schedule.Update(bodies, 7, 1000, 1000), 52u);
+  // Moving apart, they only meet the walls: body 0 reaches x = 10 after
+  // 55 steps, then body 1 x = 990 after 195.
+  bodies[0].x = 120;
+  bodies[0].step_x = -2;
+  bodies[1].step_x = 2;
+  EXPECT_EQ(schedule.Update(bodies, 7, 1000, 1000), 62u);
+  bodies[0].x = 500;
+  bodies[1].x = 600;
+  EXPECT_EQ(schedule.Update(bodies, 7, 1000, 1000), 202u);
+}
+
+#endif /* KINETIC_TESTS */
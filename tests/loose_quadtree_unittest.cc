@@ -0,0 +1,101 @@
+/**
+ * @file loose_quadtree_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/loose_quadtree.h"
+#include "src/scenario.h"
+#ifdef LOOSE_QUADTREE_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Queries agree with a brute-force search as circles move, crowd into a
+// corner, leave the tree's square and are removed.
+TEST(LooseQuadtreeTest, QueriesMatchBruteForce) {
+  struct Circle { double x, y, r; bool in; };
+  std::mt19937 rng(21);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  csci3081::LooseQuadtree tree(4);
+  tree.Reset(0, 0, 1000);
+  std::vector<Circle> circles(600);
+  for (uint32_t id = 0; id < circles.size(); ++id) {
+    // 90% crowd one corner; a few lie outside the square.
+    double span = id % 10 == 0 ? 1200 : 150;
+    circles[id] = {unit(rng) * span, unit(rng) * span, 5 + unit(rng) * 45,
+                   true};
+    tree.Update(id, circles[id].x, circles[id].y, circles[id].r);
+  }
+  EXPECT_GT(tree.node_count(), 1u);
+
+  for (int round = 0; round < 20; ++round) {
+    for (uint32_t id = 0; id < circles.size(); ++id) {
+      Circle &c = circles[id];
+      if (id % 17 == static_cast<uint32_t>(round)) {
+        c.in = !c.in;
+        if (!c.in) {
+          tree.Remove(id);
+          continue;
+        }
+      }
+      if (c.in) {
+        c.x += unit(rng) * 40 - 20;
+        c.y += unit(rng) * 40 - 20;
+        tree.Update(id, c.x, c.y, c.r);
+      }
+    }
+    double qx = unit(rng) * 1000, qy = unit(rng) * 1000;
+    double qr = unit(rng) * 200;
+    std::vector<uint32_t> found;
+    tree.Query(qx, qy, qr, &found);
+    std::sort(found.begin(), found.end());
+    std::vector<uint32_t> expected;
+    size_t in = 0;
+    for (uint32_t id = 0; id < circles.size(); ++id) {
+      const Circle &c = circles[id];
+      double dx = c.x - qx, dy = c.y - qy, d = qr + c.r;
+      in += c.in;
+      if (c.in && dx * dx + dy * dy <= d * d) {
+        expected.push_back(id);
+      }
+    }
+    EXPECT_EQ(found, expected);
+    EXPECT_EQ(tree.size(), in);
+  }
+}
+
+// A sensor range wider than the arena senses everything, as no range does.
+TEST(LooseQuadtreeTest, SensorRangeBeyondArenaChangesNothing) {
+  csci3081::arena_params aparams;
+  aparams.n_robots = 20;
+  aparams.n_lights = 4;
+  aparams.n_food = 4;
+  aparams.fear_count = 8;
+  uint64_t checksum[2] = {0};
+  const double ranges[2] = {0, 5000};
+  for (int k = 0; k < 2; ++k) {
+    aparams.sensor_range = ranges[k];
+    csci3081::Arena arena(&aparams);
+    arena.Seed(3);
+    csci3081::PopulateArena(aparams, &arena);
+    for (int i = 0; i < 1000; ++i) {
+      arena.AdvanceTime(1);
+    }
+    checksum[k] = arena.StateChecksum();
+  }
+  EXPECT_EQ(checksum[1], checksum[0]);
+}
+
+#endif /* LOOSE_QUADTREE_TESTS */
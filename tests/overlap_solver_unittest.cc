@@ -0,0 +1,120 @@
+/**
+ * @file overlap_solver_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+#include "src/food.h"
+#include "src/light.h"
+#include "src/overlap_solver.h"
+#include "src/params.h"
+#ifdef OVERLAP_SOLVER_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class OverlapSolverTest : public ::testing::Test {
+ protected:
+  // Add a light of `radius` at (`x`, `y`).
+  void AddLight(double x, double y, double radius) {
+    lights_.emplace_back(new csci3081::Light());
+    lights_.back()->set_position(x, y);
+    lights_.back()->set_radius(radius);
+    entities_.push_back(lights_.back().get());
+    mobile_.push_back(lights_.back().get());
+  }
+
+  // Contacts between every pair that overlaps or nearly does, as the
+  // Arena finds them.
+  void AddContacts() {
+    solver_.Clear();
+    for (uint32_t m = 0; m < mobile_.size(); ++m) {
+      for (uint32_t j = 0; j < entities_.size(); ++j) {
+        if (entities_[j] != mobile_[m] &&
+            Overlap(m, j) > -RELAX_CONTACT_MARGIN) {
+          solver_.AddContact(m, j);
+        }
+      }
+    }
+  }
+
+  double Overlap(uint32_t m, uint32_t j) const {
+    double dx = mobile_[m]->get_pose().x - entities_[j]->get_pose().x;
+    double dy = mobile_[m]->get_pose().y - entities_[j]->get_pose().y;
+    return mobile_[m]->get_radius() + entities_[j]->get_radius() -
+           std::sqrt(dx * dx + dy * dy);
+  }
+
+  double MaxOverlap() const {
+    double most = 0;
+    for (uint32_t m = 0; m < mobile_.size(); ++m) {
+      for (uint32_t j = 0; j < entities_.size(); ++j) {
+        if (entities_[j] != mobile_[m]) {
+          most = std::max(most, Overlap(m, j));
+        }
+      }
+    }
+    return most;
+  }
+
+  std::vector<std::unique_ptr<csci3081::Light>> lights_;
+  std::vector<csci3081::ArenaEntity *> entities_;
+  std::vector<csci3081::ArenaMobileEntity *> mobile_;
+  csci3081::OverlapSolver solver_;
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Two mobile entities each move half the overlap, along the line between
+// them; food does not move, so a light moves all of it.
+TEST_F(OverlapSolverTest, SeparatesAlongTheContactNormal) {
+  AddLight(100, 100, 10);
+  AddLight(110, 100, 10);
+  csci3081::Food food;
+  food.set_position(300, 300);
+  food.set_radius(20);
+  entities_.push_back(&food);
+  AddLight(300, 325, 10);
+  AddContacts();
+  EXPECT_EQ(solver_.contact_count(), 3u);
+
+  EXPECT_EQ(solver_.Solve(entities_, mobile_, 10), 1);
+  EXPECT_NEAR(MaxOverlap(), 0, 1e-9);
+  EXPECT_DOUBLE_EQ(mobile_[0]->get_pose().x, 95);
+  EXPECT_DOUBLE_EQ(mobile_[1]->get_pose().x, 115);
+  EXPECT_DOUBLE_EQ(mobile_[2]->get_pose().y, 330);
+  EXPECT_NEAR(food.get_pose().y, 300, 1e-9);
+}
+
+// A pack of overlapping lights spreads out, step by step as in the Arena,
+// without pushing any into new overlaps.
+TEST_F(OverlapSolverTest, SettlesADensePack) {
+  std::mt19937 rng(8);
+  std::uniform_real_distribution<double> pack(200, 260);
+  for (int i = 0; i < 30; ++i) {
+    AddLight(pack(rng), pack(rng), 10);
+  }
+  double overlap = MaxOverlap();
+  EXPECT_GT(overlap, 10);
+  for (int step = 0; step < 6; ++step) {
+    AddContacts();
+    EXPECT_EQ(solver_.Solve(entities_, mobile_, 8), 8);
+    EXPECT_LT(MaxOverlap(), overlap);
+    overlap = MaxOverlap();
+  }
+  EXPECT_LT(overlap, 0.5);
+}
+
+#endif /* OVERLAP_SOLVER_TESTS */
@@ -0,0 +1,59 @@
+/**
+ * @file robot_fsm_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/robot_fsm.h"
+#ifdef ROBOT_FSM_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST(RobotFsmTest, Transitions) {
+  using csci3081::RobotTransition;
+  uint8_t state = csci3081::kRobotFoodOn;
+  state = RobotTransition(state, csci3081::kRobotHungerDue);
+  EXPECT_EQ(state, csci3081::kRobotFoodOn | csci3081::kRobotHungry);
+  // Hunger only lasts while food is on.
+  EXPECT_EQ(RobotTransition(state, csci3081::kRobotFoodCheck), state);
+  state = RobotTransition(state, csci3081::kRobotSetFoodOff);
+  EXPECT_EQ(RobotTransition(state, csci3081::kRobotFoodCheck), 0);
+
+  EXPECT_EQ(csci3081::RobotRespondsToLight(csci3081::kRobotFearsLight),
+            csci3081::kLightFear);
+  EXPECT_EQ(csci3081::RobotRespondsToLight(0), csci3081::kLightExplore);
+  EXPECT_EQ(csci3081::RobotRespondsToLight(csci3081::kRobotFearsLight |
+                                           csci3081::kRobotReallyHungry),
+            csci3081::kLightIgnore);
+}
+
+// The Arena keeps its robots' states in one array, which the robots and
+// population-wide settings both update.
+TEST(RobotFsmTest, ArenaStateArray) {
+  csci3081::arena_params aparams;
+  csci3081::Arena arena(&aparams);
+  arena.AddRobot(csci3081::kRobot, 6);
+  arena.set_behavior_sensitivity_robot(2, 1.0f, 1);
+  ASSERT_EQ(arena.get_robot_states().size(), 6u);
+  EXPECT_EQ(arena.CountRobots(csci3081::kRobotFoodOn,
+                              csci3081::kRobotFoodOn), 6u);
+  EXPECT_EQ(arena.CountRobots(csci3081::kRobotFearsLight,
+                              csci3081::kRobotFearsLight), 2u);
+  arena.set_behavior_sensitivity_robot(2, 1.0f, 0);
+  EXPECT_EQ(arena.robot()[0]->get_food_on_off(), 0);
+  EXPECT_EQ(arena.CountRobots(csci3081::kRobotFoodOn, 0), 6u);
+
+  arena.robot()[3]->HandleCollision(csci3081::kRobot);
+  EXPECT_EQ(arena.get_robot_states()[3] & csci3081::kRobotArcing,
+            csci3081::kRobotArcing);
+}
+
+#endif /* ROBOT_FSM_TESTS */
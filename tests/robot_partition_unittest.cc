@@ -0,0 +1,57 @@
+/**
+ * @file robot_partition_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "src/robot_fsm.h"
+#include "src/robot_partition.h"
+#ifdef ROBOT_PARTITION_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// However the states change, every robot appears once, in its class's range.
+TEST(RobotPartitionTest, KeepsEachClassContiguous) {
+  std::mt19937 rng(11);
+  std::vector<uint8_t> states(500);
+  for (auto &state : states) {
+    state = static_cast<uint8_t>(rng() % csci3081::kRobotStates);
+  }
+  csci3081::RobotPartition partition;
+  partition.Reset(states);
+
+  for (int round = 0; round < 50; ++round) {
+    size_t changed = 0;
+    for (int k = 0; k < 20; ++k) {
+      uint8_t &state = states[rng() % states.size()];
+      uint8_t before = csci3081::RobotSenseClass(state);
+      state = static_cast<uint8_t>(rng() % csci3081::kRobotStates);
+      changed += csci3081::RobotSenseClass(state) != before;
+    }
+    EXPECT_LE(partition.Update(states), changed);
+
+    std::vector<int> seen(states.size());
+    for (int c = 0; c < csci3081::kRobotSenseClasses; ++c) {
+      for (size_t p = partition.begin(c); p < partition.end(c); ++p) {
+        uint32_t robot = partition.order()[p];
+        ++seen[robot];
+        EXPECT_EQ(csci3081::RobotSenseClass(states[robot]), c);
+      }
+    }
+    for (int count : seen) {
+      EXPECT_EQ(count, 1);
+    }
+  }
+  EXPECT_EQ(partition.Update(states), 0u);
+}
+
+#endif /* ROBOT_PARTITION_TESTS */
@@ -0,0 +1,139 @@
+/**
+ * @file scenario_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/robot.h"
+#include "src/scenario.h"
+#ifdef SCENARIO_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class ScenarioTest : public ::testing::Test {
+ protected:
+  bool Parse(const std::string &text) {
+    std::istringstream in(text);
+    return csci3081::ParseScenario(in, "test.ini", &aparams, &error);
+  }
+
+  csci3081::arena_params aparams;
+  std::string error;
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST_F(ScenarioTest, ParsesEveryKey) {
+  ASSERT_TRUE(Parse(
+      "# comment\n"
+      "[arena]\n"
+      "width = 20000 ; trailing comment\n"
+      "height=15000\n"
+      "seed = 18446744073709551615\n"
+      "broadphase = quadtree\n"
+      "neighbor_skin = off\n"
+      "relax_passes = 8\n"
+      "dt = 2.5\n"
+      "adaptive_dt = on\n"
+      "dt_min = 0.5\n"
+      "ccd = on\n"
+      "kinetic = on\n"
+      "\n"
+      "[entities]\n"
+      "robots = 100000\n"
+      "lights = 30\n"
+      "food = 12\n"
+      "[behavior]\n"
+      "fear = 50000\n"
+      "light_sensitivity = 1.07\n"
+      "food = off\n"
+      "sensor_range = 250\n"
+      "[run]\n"
+      "threads = 8\n"
+      "max_steps = 500\n"
+      "stop_on_starvation = all\n"
+      "steady_epsilon = 0.25\n"
+      "steady_window = 100\n"
+      "max_seconds = 30\n"
+      "[viewer]\n"
+      "frame_budget = 33\n")) << error;
+  EXPECT_EQ(aparams.x_dim, 20000u);
+  EXPECT_EQ(aparams.y_dim, 15000u);
+  EXPECT_EQ(aparams.seed, UINT64_MAX);
+  EXPECT_EQ(aparams.broadphase, csci3081::kBroadphaseQuadtree);
+  EXPECT_DOUBLE_EQ(aparams.neighbor_skin, 0.0);
+  EXPECT_EQ(aparams.relax_passes, 8);
+  EXPECT_DOUBLE_EQ(aparams.dt, 2.5);
+  EXPECT_EQ(aparams.adaptive_dt, 1);
+  EXPECT_DOUBLE_EQ(aparams.dt_min, 0.5);
+  EXPECT_EQ(aparams.ccd, 1);
+  EXPECT_EQ(aparams.kinetic, 1);
+  EXPECT_EQ(aparams.n_robots, 100000u);
+  EXPECT_EQ(aparams.n_lights, 30u);
+  EXPECT_EQ(aparams.n_food, 12u);
+  EXPECT_EQ(aparams.fear_count, 50000u);
+  EXPECT_FLOAT_EQ(aparams.light_sensitivity, 1.07f);
+  EXPECT_EQ(aparams.food_on, 0);
+  EXPECT_DOUBLE_EQ(aparams.sensor_range, 250.0);
+  EXPECT_EQ(aparams.n_threads, 8u);
+  EXPECT_EQ(aparams.max_steps, 500u);
+  EXPECT_EQ(aparams.stop_on_starvation, csci3081::kStarvationAll);
+  EXPECT_DOUBLE_EQ(aparams.steady_epsilon, 0.25);
+  EXPECT_EQ(aparams.steady_window, 100u);
+  EXPECT_DOUBLE_EQ(aparams.max_seconds, 30.0);
+  EXPECT_DOUBLE_EQ(aparams.frame_budget_ms, 33.0);
+}
+
+// Errors name the line, and leave the parameters untouched.
+TEST_F(ScenarioTest, RejectsBadInput) {
+  EXPECT_FALSE(Parse("[arena]\nwidth = 2000\nwidht = 10\n"));
+  EXPECT_EQ(error, "test.ini:3: unknown key 'arena.widht'");
+  EXPECT_EQ(aparams.x_dim, static_cast<uint>(ARENA_X_DIM));
+
+  EXPECT_FALSE(Parse("[entities]\nrobots = -5\n"));
+  EXPECT_EQ(error, "test.ini:2: bad value '-5' for 'entities.robots'");
+  EXPECT_FALSE(Parse("[arena]\nwidth = 10\n"));
+  EXPECT_FALSE(Parse("[run]\nthreads = 0\n"));
+  EXPECT_FALSE(Parse("[behavior]\nfood = maybe\n"));
+  EXPECT_FALSE(Parse("[entities\n"));
+  EXPECT_FALSE(Parse("[entities]\nrobots 5\n"));
+  EXPECT_FALSE(Parse("[entities]\nrobots = 2\n[behavior]\nfear = 3\n"));
+  EXPECT_EQ(aparams.n_robots, 5u);
+}
+
+// A scenario may exceed the GUI's limits on counts and arena size.
+TEST_F(ScenarioTest, PopulatesLargeArena) {
+  ASSERT_TRUE(Parse("[arena]\nwidth = 5000\nheight = 4000\n"
+                    "[entities]\nrobots = 300\nlights = 40\nfood = 25\n"
+                    "[behavior]\nfear = 100\n")) << error;
+  csci3081::Arena arena(&aparams);
+  arena.Seed(3);
+  csci3081::PopulateArena(aparams, &arena);
+  EXPECT_EQ(arena.get_entities().size(), 365u);
+  int fearful = 0;
+  double max_x = 0;
+  for (auto robot : arena.robot()) {
+    fearful += robot->get_behavior_flag();
+  }
+  for (auto ent : arena.get_entities()) {
+    max_x = std::max(max_x, ent->get_pose().x);
+  }
+  EXPECT_EQ(fearful, 100);
+  // Placement covers the whole arena, not just the GUI's 1024x768.
+  EXPECT_GT(max_x, ARENA_X_DIM);
+  EXPECT_LT(max_x, 5000);
+}
+
+#endif /* SCENARIO_TESTS */
@@ -0,0 +1,126 @@
+/**
+ * @file sense_decimation_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/sense_decimation.h"
+#include "tests/arena_test_util.h"
+#ifdef SENSE_DECIMATION_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class SenseDecimationTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    aparams.seed = 3;
+    aparams.x_dim = 1500;
+    aparams.y_dim = 1000;
+    aparams.n_robots = 10;
+    aparams.n_lights = 3;
+    aparams.n_food = 0;
+    aparams.food_on = 0;
+    aparams.fear_count = 5;
+    aparams.light_sensitivity = 1.1f;
+  }
+
+  csci3081::arena_params aparams;
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Readings are carried on by the factor they changed by per step between
+// the last two full sensings, up to the sensors' ceiling, until the robot
+// is due to sense in full again.
+TEST_F(SenseDecimationTest, CarriesReadingsOn) {
+  csci3081::SenseDecimation decimation;
+  decimation.Reset(1);
+  EXPECT_TRUE(decimation.Due(0, 0, 3));
+  decimation.Record(0, 0, 100, 50);
+  EXPECT_FALSE(decimation.Due(0, 0, 3));
+  EXPECT_TRUE(decimation.Due(0, 1, 3));
+  double left = 0, right = 0;
+  decimation.Extrapolate(0, &left, &right);
+  EXPECT_DOUBLE_EQ(left, 100);
+  EXPECT_DOUBLE_EQ(right, 50);
+  // Four times as much over two steps: twice as much a step.
+  decimation.Record(0, 0, 400, 50);
+  decimation.Extrapolate(0, &left, &right);
+  EXPECT_DOUBLE_EQ(left, 800);
+  EXPECT_DOUBLE_EQ(right, 50);
+  EXPECT_FALSE(decimation.Due(0, 0, 3));
+  decimation.Extrapolate(0, &left, &right);
+  EXPECT_DOUBLE_EQ(left, 1000);
+  EXPECT_TRUE(decimation.Due(0, 0, 3));
+}
+
+// The factor comes from the last two full sensings, not from the readings
+// carried on in between: a reading growing by sqrt(2) a step is carried on
+// exactly, cycle after cycle.
+TEST_F(SenseDecimationTest, FactorSpansFullSensings) {
+  csci3081::SenseDecimation decimation;
+  decimation.Reset(1);
+  double reading = 10, left = 0, right = 0;
+  for (int step = 0; step < 12; ++step) {
+    if (decimation.Due(0, 0, 2)) {
+      decimation.Record(0, 0, reading, 1);
+    } else {
+      decimation.Extrapolate(0, &left, &right);
+      if (step > 1) {
+        EXPECT_NEAR(left, reading, 1e-9 * reading) << "step " << step;
+      }
+    }
+    reading *= std::sqrt(2.0);
+  }
+  EXPECT_EQ(decimation.get_extrapolated(), 6u);
+}
+
+// Started from the same state, sensing in full every fourth step leaves
+// most robots where sensing every step takes them a few steps later; the
+// rest are off by a collision happening a step sooner or later. A clone
+// carries the readings on as the original does.
+TEST_F(SenseDecimationTest, StaysCloseToEveryStepSensing) {
+  csci3081::arena_params fourth_params = aparams;
+  fourth_params.sense_interval = 4;
+  std::unique_ptr<csci3081::Arena> every = MakeSeededArena(aparams);
+  std::unique_ptr<csci3081::Arena> fourth = MakeSeededArena(fourth_params);
+  std::vector<double> drift;
+  for (int r = 0; r < 20; ++r) {
+    fourth->CopyFrom(*every);
+    for (int s = 0; s < 5; ++s) {
+      every->AdvanceTime(1);
+      fourth->AdvanceTime(1);
+    }
+    for (size_t i = 0; i < every->robot().size(); ++i) {
+      drift.push_back(std::hypot(
+          every->robot()[i]->get_pose().x - fourth->robot()[i]->get_pose().x,
+          every->robot()[i]->get_pose().y - fourth->robot()[i]->get_pose().y));
+    }
+  }
+  std::sort(drift.begin(), drift.end());
+  EXPECT_LT(drift[drift.size() / 2], 0.1);
+  EXPECT_GT(fourth->get_sense_decimation().get_extrapolated(), 0u);
+
+  std::unique_ptr<csci3081::Arena> clone(fourth->Clone());
+  for (int s = 0; s < 50; ++s) {
+    fourth->AdvanceTime(1);
+    clone->AdvanceTime(1);
+  }
+  EXPECT_EQ(clone->StateChecksum(), fourth->StateChecksum());
+}
+
+#endif /* SENSE_DECIMATION_TESTS */
@@ -0,0 +1,84 @@
+/**
+ * @file session_log_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/communication.h"
+#include "src/entity_type.h"
+#include "src/session_log.h"
+#ifdef SESSION_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class SessionLogTest : public ::testing::Test {
+ protected:
+  virtual void TearDown() {
+    std::remove(path);
+  }
+
+  // Drive an arena the way the viewer does: configure, play, trade away
+  // sensing as the frame governor would, start a new game part way through.
+  void PlaySession(csci3081::Arena *arena) {
+    arena->Seed(42);
+    log.Start(42, aparams.x_dim, aparams.y_dim);
+    arena->set_session_log(&log);
+    arena->AddRobot(csci3081::kRobot, 6);
+    arena->set_robot_count(6);
+    arena->AddLight(csci3081::kLight, 3);
+    arena->AddFood(csci3081::kFood, 2);
+    arena->set_behavior_sensitivity_robot(3, 1.04, 1);
+    arena->AcceptCommand(csci3081::kPlay);
+    for (int i = 0; i < 100; ++i) arena->AdvanceTime(1);
+    arena->set_sense_interval(4);
+    for (int i = 0; i < 50; ++i) arena->AdvanceTime(1);
+    arena->AcceptCommand(csci3081::kReset);
+    arena->AddRobot(csci3081::kRobot, 4);
+    arena->set_behavior_sensitivity_robot(1, 1.01, 0);
+    for (int i = 0; i < 80; ++i) arena->AdvanceTime(1);
+    log.Finish(arena->get_step());
+    arena->set_session_log(nullptr);
+  }
+
+  csci3081::arena_params aparams;
+  csci3081::SessionLog log;
+  const char * path = "session_log_unittest.ses";
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Re-executing a saved log must end in exactly the original state.
+TEST_F(SessionLogTest, ReplayReproducesSession) {
+  csci3081::Arena original(&aparams);
+  PlaySession(&original);
+  ASSERT_TRUE(log.Save(path));
+
+  csci3081::SessionLog loaded;
+  ASSERT_TRUE(loaded.Load(path));
+  EXPECT_EQ(loaded.get_seed(), 42u);
+  EXPECT_EQ(loaded.get_entries().size(), log.get_entries().size());
+  csci3081::Arena replayed(&aparams);
+  loaded.Replay(&replayed);
+  EXPECT_EQ(replayed.get_step(), 230u);
+  EXPECT_EQ(replayed.StateChecksum(), original.StateChecksum());
+}
+
+TEST_F(SessionLogTest, RejectsBadFile) {
+  EXPECT_FALSE(log.Load("no_such_session.ses"));
+  FILE *f = std::fopen(path, "wb");
+  std::fputs("RSES", f);
+  std::fclose(f);
+  EXPECT_FALSE(log.Load(path));
+}
+
+#endif /* SESSION_TESTS */
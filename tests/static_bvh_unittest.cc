@@ -0,0 +1,71 @@
+/**
+ * @file static_bvh_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "src/static_bvh.h"
+#ifdef STATIC_BVH_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Queries agree with a brute-force search over a subset of the circles, both
+// as built and after some of them move and the hierarchy is refit.
+TEST(StaticBvhTest, QueriesMatchBruteForce) {
+  std::mt19937 rng(13);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  const size_t n = 500;
+  std::vector<double> x(n), y(n), radius(n);
+  std::vector<uint32_t> ids;
+  for (uint32_t id = 0; id < n; ++id) {
+    x[id] = unit(rng) * 1000;
+    y[id] = unit(rng) * 700;
+    radius[id] = 5 + unit(rng) * 20;
+    if (id % 3 != 0) {
+      ids.push_back(id);
+    }
+  }
+  csci3081::StaticBvh bvh;
+  bvh.Build(ids, x.data(), y.data(), radius.data());
+  EXPECT_EQ(bvh.size(), ids.size());
+  EXPECT_FALSE(bvh.Refit(x.data(), y.data(), radius.data()));
+
+  for (int round = 0; round < 2; ++round) {
+    if (round == 1) {
+      for (uint32_t id = 0; id < n; id += 7) {
+        x[id] = unit(rng) * 1000;
+        radius[id] += 10;
+      }
+      EXPECT_TRUE(bvh.Refit(x.data(), y.data(), radius.data()));
+    }
+    for (int q = 0; q < 50; ++q) {
+      double qx = unit(rng) * 1000, qy = unit(rng) * 700;
+      double qr = unit(rng) * 150;
+      std::vector<uint32_t> found;
+      bvh.Query(qx, qy, qr, &found);
+      std::sort(found.begin(), found.end());
+      std::vector<uint32_t> expected;
+      for (uint32_t id : ids) {
+        double dx = x[id] - qx, dy = y[id] - qy, d = qr + radius[id];
+        if (dx * dx + dy * dy <= d * d) {
+          expected.push_back(id);
+        }
+      }
+      EXPECT_EQ(found, expected);
+    }
+  }
+  EXPECT_EQ(bvh.get_builds(), 1u);
+  EXPECT_EQ(bvh.get_refits(), 1u);
+}
+
+#endif /* STATIC_BVH_TESTS */
@@ -0,0 +1,179 @@
+/**
+ * @file sweep_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "src/result_cache.h"
+#include "src/sweep.h"
+#include "src/sweep_sink.h"
+#ifdef SWEEP_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class SweepTest : public ::testing::Test {
+ protected:
+  virtual void TearDown() {
+    std::remove(path);
+    std::remove(full_path);
+    std::system("rm -rf sweep_unittest_cache");
+  }
+
+  bool Parse(csci3081::Sweep *sweep, const std::string &text) {
+    std::istringstream in(text);
+    return sweep->Parse(in, "test.ini", &error);
+  }
+
+  // Result lines without the timing and cached columns, in job order.
+  static std::vector<std::string> Results(const char *file) {
+    std::ifstream in(file);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line)) {
+      if (!line.empty() && line[0] != '#' && line[0] != 'j') {
+        line.erase(line.rfind(','));
+        lines.push_back(line.substr(0, line.rfind(',')));
+      }
+    }
+    std::sort(lines.begin(), lines.end());
+    return lines;
+  }
+
+  const char *kGrid =
+      "[arena]\nseed = 9\n"
+      "[behavior]\nlight_sensitivity = 1.05\n"
+      "[run]\nmax_steps = 40\n"
+      "[sweep]\n"
+      "robots = 2, 4\n"
+      "lights = 0-1\n"
+      "fear = 0, 50\n"
+      "seeds = 1-2\n";
+  std::string error;
+  const char *path = "sweep_unittest.csv";
+  const char *full_path = "sweep_unittest_full.csv";
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+TEST_F(SweepTest, ExpandsGrid) {
+  csci3081::Sweep sweep;
+  ASSERT_TRUE(Parse(&sweep, kGrid)) << error;
+  const std::vector<csci3081::SweepJob> &jobs = sweep.get_jobs();
+  ASSERT_EQ(jobs.size(), 16u);
+  // Seeds vary fastest, robots slowest; unswept keys keep the scenario's.
+  EXPECT_EQ(jobs[1].seed, 2u);
+  EXPECT_EQ(jobs[2].fear_percent, 50);
+  EXPECT_EQ(jobs[4].n_lights, 1u);
+  EXPECT_EQ(jobs[15].n_robots, 4u);
+  EXPECT_FLOAT_EQ(jobs[15].light_sensitivity, 1.05f);
+  EXPECT_GT(jobs[15].cost, jobs[0].cost);
+
+  csci3081::Sweep other;
+  EXPECT_FALSE(Parse(&other, "[run]\nmax_steps = 5\n[sweep]\nrobot = 2\n"));
+  EXPECT_EQ(error, "test.ini:4: unknown key 'sweep.robot'");
+  EXPECT_FALSE(Parse(&other, "[sweep]\nrobots = 2\n"));
+  EXPECT_FALSE(Parse(&other, "[run]\nmax_steps = 5\n[sweep]\nfear = 101\n"));
+}
+
+// A sweep killed part way through picks up where it stopped and ends with
+// the same results as one that ran straight through.
+TEST_F(SweepTest, ResumesPartialOutput) {
+  csci3081::Sweep sweep;
+  ASSERT_TRUE(Parse(&sweep, kGrid)) << error;
+  csci3081::SweepSink full;
+  ASSERT_TRUE(full.Open(full_path, sweep, &error)) << error;
+  EXPECT_EQ(sweep.Run(&full, 4), 16u);
+  ASSERT_TRUE(full.Close());
+
+  // Header, three finished jobs and half of a fourth.
+  std::ifstream in(full_path);
+  std::ostringstream partial;
+  std::string line;
+  for (int i = 0; i < 5 && std::getline(in, line); ++i) {
+    partial << line << "\n";
+  }
+  std::getline(in, line);
+  partial << line.substr(0, line.size() / 2);
+  std::ofstream(path) << partial.str();
+
+  csci3081::SweepSink resumed;
+  ASSERT_TRUE(resumed.Open(path, sweep, &error)) << error;
+  EXPECT_EQ(resumed.get_resumed_count(), 3u);
+  EXPECT_EQ(sweep.Run(&resumed, 3), 13u);
+  ASSERT_TRUE(resumed.Close());
+  EXPECT_EQ(Results(path), Results(full_path));
+
+  // Nothing is left to do, and another sweep may not append to the file.
+  csci3081::SweepSink again;
+  ASSERT_TRUE(again.Open(path, sweep, &error));
+  EXPECT_EQ(sweep.Run(&again, 2), 0u);
+  again.Close();
+  csci3081::Sweep other;
+  ASSERT_TRUE(Parse(&other, std::string(kGrid) + "food = 3\n"));
+  EXPECT_FALSE(again.Open(path, other, &error));
+}
+
+// A second sweep over the same jobs is answered entirely from the cache,
+// with the same results, until the simulation version changes.
+TEST_F(SweepTest, CacheSkipsRepeatedJobs) {
+  csci3081::Sweep sweep;
+  ASSERT_TRUE(Parse(&sweep, kGrid)) << error;
+  csci3081::ResultCache cache;
+  ASSERT_TRUE(cache.Open("sweep_unittest_cache", 1));
+  csci3081::SweepSink first;
+  ASSERT_TRUE(first.Open(full_path, sweep, &error)) << error;
+  sweep.Run(&first, 2, &cache);
+  first.Close();
+  EXPECT_EQ(cache.get_hits(), 0u);
+
+  csci3081::ResultCache warm;
+  ASSERT_TRUE(warm.Open("sweep_unittest_cache", 1));
+  csci3081::SweepSink second;
+  ASSERT_TRUE(second.Open(path, sweep, &error)) << error;
+  EXPECT_EQ(sweep.Run(&second, 2, &warm), 16u);
+  second.Close();
+  EXPECT_EQ(warm.get_hits(), 16u);
+  EXPECT_EQ(Results(path), Results(full_path));
+
+  // Opening for a new version drops the old entries for every user.
+  csci3081::ResultCache stale;
+  ASSERT_TRUE(stale.Open("sweep_unittest_cache", 2));
+  csci3081::SweepResult result;
+  EXPECT_FALSE(stale.Lookup(sweep.JobParams(sweep.get_jobs()[0]), &result));
+  EXPECT_FALSE(warm.Lookup(sweep.JobParams(sweep.get_jobs()[0]), &result));
+}
+
+// Configs that differ only far past the decimal point are cached apart.
+TEST_F(SweepTest, CacheTellsCloseValuesApart) {
+  csci3081::Sweep sweep;
+  ASSERT_TRUE(Parse(&sweep, kGrid)) << error;
+  csci3081::ResultCache cache;
+  ASSERT_TRUE(cache.Open("sweep_unittest_cache", 1));
+  csci3081::arena_params params = sweep.JobParams(sweep.get_jobs()[0]);
+  params.dt = 0.1234567;
+  csci3081::SweepResult result;
+  cache.Store(params, result);
+  EXPECT_TRUE(cache.Lookup(params, &result));
+  csci3081::arena_params close = params;
+  close.dt = 0.1234568;
+  EXPECT_FALSE(cache.Lookup(close, &result));
+  close = params;
+  close.steady_epsilon = params.steady_epsilon + 1e-12;
+  EXPECT_FALSE(cache.Lookup(close, &result));
+}
+
+#endif /* SWEEP_TESTS */
@@ -0,0 +1,113 @@
+/**
+ * @file swept_collision_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "src/broadphase.h"
+#include "src/food.h"
+#include "src/light.h"
+#include "src/swept_collision.h"
+#ifdef SWEPT_COLLISION_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class SweptCollisionTest : public ::testing::Test {
+ protected:
+  // Add a light of radius 8 at (`x`, `y`).
+  void AddLight(double x, double y) {
+    lights_.emplace_back(new csci3081::Light());
+    lights_.back()->set_position(x, y);
+    lights_.back()->set_radius(8);
+    entities_.push_back(lights_.back().get());
+    mobile_.push_back(lights_.back().get());
+  }
+
+  // Light `m`'s distance from entity `j`.
+  double Distance(size_t m, size_t j) const {
+    double dx = mobile_[m]->get_pose().x - entities_[j]->get_pose().x;
+    double dy = mobile_[m]->get_pose().y - entities_[j]->get_pose().y;
+    return std::sqrt(dx * dx + dy * dy);
+  }
+
+  std::vector<std::unique_ptr<csci3081::Light>> lights_;
+  std::vector<csci3081::ArenaEntity *> entities_;
+  std::vector<csci3081::ArenaMobileEntity *> mobile_;
+  csci3081::SweptCollision swept_;
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Two lights that swap places in one step would pass through each other
+// unseen; they are stopped where they first touch.
+TEST_F(SweptCollisionTest, StopsMobileEntitiesPassingThrough) {
+  AddLight(100, 100);
+  AddLight(140, 100);
+  AddLight(500, 500);
+  swept_.Begin(mobile_);
+  mobile_[0]->set_position(160, 100);
+  mobile_[1]->set_position(80, 100);
+  mobile_[2]->set_position(510, 500);
+  EXPECT_EQ(swept_.Rewind(entities_, mobile_, 1000, 1000), 2u);
+  EXPECT_NEAR(mobile_[0]->get_pose().x, 112, 1e-6);
+  EXPECT_NEAR(mobile_[1]->get_pose().x, 128, 1e-6);
+  EXPECT_LE(Distance(0, 1), 16);
+  EXPECT_DOUBLE_EQ(mobile_[2]->get_pose().x, 510);
+}
+
+// A light is stopped at its first contact with food, or with a wall, along
+// its motion.
+TEST_F(SweptCollisionTest, StopsAtFoodAndWalls) {
+  csci3081::Food food;
+  food.set_position(300, 100);
+  food.set_radius(20);
+  entities_.push_back(&food);
+  AddLight(250, 100);
+  AddLight(50, 100);
+  swept_.Begin(mobile_);
+  mobile_[0]->set_position(350, 100);
+  mobile_[1]->set_position(-20, 135);
+  EXPECT_EQ(swept_.Rewind(entities_, mobile_, 1000, 1000), 2u);
+  EXPECT_NEAR(mobile_[0]->get_pose().x, 272, 1e-6);
+  EXPECT_LE(Distance(0, 0), 28);
+  EXPECT_NEAR(mobile_[1]->get_pose().x, 8, 1e-6);
+  EXPECT_NEAR(mobile_[1]->get_pose().y, 121, 1e-6);
+  EXPECT_EQ(swept_.get_rewinds(), 2u);
+}
+
+// With a broadphase, only the pairs it finds are swept, to the same end;
+// motions longer than it can reach sweep every pair without finding any.
+TEST_F(SweptCollisionTest, SweepsTheBroadphasePairs) {
+  std::unique_ptr<csci3081::Broadphase> broadphase(
+      csci3081::CreateBroadphase(csci3081::kBroadphaseNeighborList, 160));
+  AddLight(100, 100);
+  AddLight(140, 100);
+  AddLight(500, 500);
+  swept_.Begin(mobile_);
+  mobile_[0]->set_position(160, 100);
+  mobile_[1]->set_position(80, 100);
+  mobile_[2]->set_position(510, 500);
+  EXPECT_EQ(swept_.Rewind(entities_, mobile_, 1000, 1000, broadphase.get()),
+            2u);
+  EXPECT_NEAR(mobile_[0]->get_pose().x, 112, 1e-6);
+  EXPECT_NEAR(mobile_[1]->get_pose().x, 128, 1e-6);
+  EXPECT_EQ(broadphase->get_builds(), 1u);
+
+  swept_.Begin(mobile_);
+  mobile_[2]->set_position(600, 500);
+  EXPECT_EQ(swept_.Rewind(entities_, mobile_, 1000, 1000, broadphase.get()),
+            0u);
+  EXPECT_EQ(broadphase->get_builds(), 1u);
+}
+
+#endif /* SWEPT_COLLISION_TESTS */
@@ -0,0 +1,85 @@
+/**
+ * @file termination_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/termination.h"
+#include "tests/arena_test_util.h"
+#ifdef TERMINATION_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class TerminationTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    aparams.seed = 5;
+    aparams.n_robots = 3;
+    aparams.max_steps = 5000;
+  }
+
+  // Run a fresh arena for `aparams`; returns why it stopped.
+  csci3081::StopReason Run(uint32_t *steps) {
+    std::unique_ptr<csci3081::Arena> arena = MakeSeededArena(aparams);
+    csci3081::StopReason reason =
+        csci3081::Termination(aparams).Run(arena.get());
+    *steps = arena->get_step();
+    return reason;
+  }
+
+  csci3081::arena_params aparams;
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Without food, robots get hungry and starve well before the step budget.
+TEST_F(TerminationTest, StopsOnStarvation) {
+  uint32_t first = 0;
+  aparams.stop_on_starvation = csci3081::kStarvationFirst;
+  EXPECT_EQ(Run(&first), csci3081::kStopFirstStarved);
+  EXPECT_LT(first, aparams.max_steps);
+
+  uint32_t all = 0;
+  aparams.stop_on_starvation = csci3081::kStarvationAll;
+  EXPECT_EQ(Run(&all), csci3081::kStopAllStarved);
+  EXPECT_GE(all, first);
+  EXPECT_STREQ(csci3081::StopReasonName(csci3081::kStopAllStarved),
+               "all_starved");
+}
+
+// With food off no robot can ever starve, so there is nothing to wait for.
+TEST_F(TerminationTest, StopsWhenStarvationIsImpossible) {
+  uint32_t steps = 0;
+  aparams.stop_on_starvation = csci3081::kStarvationFirst;
+  aparams.food_on = 0;
+  EXPECT_EQ(Run(&steps), csci3081::kStopCannotStarve);
+  EXPECT_EQ(steps, 0u);
+}
+
+TEST_F(TerminationTest, StopsInSteadyState) {
+  uint32_t steps = 0;
+  aparams.steady_epsilon = 0.5;
+  aparams.steady_window = 50;
+  aparams.max_steps = 400;
+  // Robots never stop moving.
+  EXPECT_EQ(Run(&steps), csci3081::kStopStepBudget);
+  EXPECT_EQ(steps, 400u);
+
+  // Food alone never moves.
+  aparams.n_robots = 0;
+  aparams.n_food = 4;
+  EXPECT_EQ(Run(&steps), csci3081::kStopSteadyState);
+  EXPECT_EQ(steps, 50u);
+}
+
+#endif /* TERMINATION_TESTS */
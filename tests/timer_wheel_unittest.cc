@@ -0,0 +1,76 @@
+/**
+ * @file timer_wheel_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "src/timer_wheel.h"
+#ifdef TIMER_WHEEL_TESTS
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Every timer fires exactly once, at its step, across every level and the
+// overflow list (the clock starts just short of the wheel's full span).
+TEST(TimerWheelTest, FiresEachTimerAtItsStep) {
+  const uint64_t start = (uint64_t{1} << 24) - 1000;
+  csci3081::TimerWheel wheel;
+  wheel.Clear(start);
+  std::mt19937_64 rng(3);
+  std::vector<uint64_t> due(3000);
+  for (uint32_t id = 0; id < due.size(); ++id) {
+    due[id] = start + 1 + rng() % (id % 3 == 0 ? 300000 : 5000);
+    wheel.Schedule(due[id], id);
+  }
+  wheel.Schedule(start - 5, 3000);  // already past: fires on the next step
+  EXPECT_EQ(wheel.size(), 3001u);
+
+  std::vector<int> fired_count(due.size() + 1);
+  std::vector<uint32_t> fired;
+  while (wheel.get_now() < start + 300000) {
+    fired.clear();
+    wheel.Advance(&fired);
+    for (uint32_t id : fired) {
+      ++fired_count[id];
+      EXPECT_EQ(id == 3000 ? start + 1 : due[id], wheel.get_now());
+    }
+  }
+  EXPECT_EQ(wheel.size(), 0u);
+  for (int count : fired_count) {
+    EXPECT_EQ(count, 1);
+  }
+}
+
+// NextDue() finds the earliest timer wherever it waits, and is the step it
+// fires at.
+TEST(TimerWheelTest, NextDueIsTheNextToFire) {
+  csci3081::TimerWheel wheel;
+  wheel.Clear(100);
+  EXPECT_EQ(wheel.NextDue(), UINT64_MAX);
+  wheel.Schedule(100 + 300000, 0);
+  wheel.Schedule(100 + 5000, 1);
+  wheel.Schedule(100 + 70, 2);
+  EXPECT_EQ(wheel.NextDue(), 170u);
+  std::vector<uint32_t> fired;
+  for (int id = 2; id >= 0; --id) {
+    uint64_t due = wheel.NextDue();
+    while (wheel.get_now() < due) {
+      EXPECT_TRUE(fired.empty());
+      wheel.Advance(&fired);
+    }
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0], static_cast<uint32_t>(id));
+    fired.clear();
+  }
+  EXPECT_EQ(wheel.NextDue(), UINT64_MAX);
+}
+
+#endif /* TIMER_WHEEL_TESTS */
@@ -0,0 +1,106 @@
+/**
+ * @file trajectory_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <vector>
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/entity_type.h"
+#include "src/pose.h"
+#include "src/trajectory_reader.h"
+#include "src/trajectory_recorder.h"
+#ifdef TRAJECTORY_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class TrajectoryTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    arena = new csci3081::Arena(&aparams);
+    arena->AddRobot(csci3081::kRobot, 4);
+    arena->AddLight(csci3081::kLight, 2);
+    arena->AddFood(csci3081::kFood, 1);
+    arena->set_behavior_sensitivity_robot(2, 1.05, 1);
+  }
+  virtual void TearDown() {
+    delete arena;
+    std::remove(path);
+  }
+
+  // Record `steps` steps, keeping every entity's pose for comparison.
+  void Record(int steps, int steps_per_chunk) {
+    ASSERT_TRUE(recorder.Open(path, steps_per_chunk));
+    arena->set_trajectory_recorder(&recorder);
+    for (int i = 0; i < steps; ++i) {
+      arena->AdvanceTime(1);
+      std::vector<csci3081::Pose> poses;
+      for (auto ent : arena->get_entities()) {
+        poses.push_back(ent->get_pose());
+      }
+      expected.push_back(poses);
+    }
+    arena->set_trajectory_recorder(nullptr);
+    ASSERT_TRUE(recorder.Close());
+  }
+
+  void ExpectStep(const csci3081::TrajectoryReader &reader, uint32_t step) {
+    csci3081::TrajectoryFrame frame;
+    ASSERT_TRUE(reader.ReadStep(step, &frame)) << "step " << step;
+    const std::vector<csci3081::Pose> &poses = expected[step - 1];
+    ASSERT_EQ(frame.rows, poses.size());
+    for (uint32_t r = 0; r < frame.rows; ++r) {
+      EXPECT_EQ(frame.Get<uint32_t>(csci3081::kColStep, r), step);
+      EXPECT_DOUBLE_EQ(frame.Get<double>(csci3081::kColX, r), poses[r].x);
+      EXPECT_DOUBLE_EQ(frame.Get<double>(csci3081::kColY, r), poses[r].y);
+      EXPECT_DOUBLE_EQ(frame.Get<double>(csci3081::kColTheta, r),
+                       poses[r].theta);
+    }
+  }
+
+  csci3081::arena_params aparams;
+  csci3081::Arena * arena;
+  csci3081::TrajectoryRecorder recorder;
+  std::vector<std::vector<csci3081::Pose>> expected;
+  const char * path = "trajectory_unittest.traj";
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Every step written through the recorder can be read back, in any order.
+TEST_F(TrajectoryTest, RecordAndSeek) {
+  Record(300, 64);
+  csci3081::TrajectoryReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_EQ(reader.get_first_step(), 1u);
+  EXPECT_EQ(reader.get_last_step(), 300u);
+  EXPECT_EQ(reader.get_chunk_count(), 5u);
+  for (uint32_t step : {300u, 1u, 64u, 65u, 200u, 129u, 128u}) {
+    ExpectStep(reader, step);
+  }
+  csci3081::TrajectoryFrame frame;
+  EXPECT_FALSE(reader.ReadStep(0, &frame));
+  EXPECT_FALSE(reader.ReadStep(301, &frame));
+}
+
+// A file whose recorder was never closed has no index and is rejected.
+TEST_F(TrajectoryTest, RejectsUnfinishedFile) {
+  csci3081::TrajectoryReader reader;
+  EXPECT_FALSE(reader.Open("no_such_file.traj"));
+  FILE *f = std::fopen(path, "wb");
+  std::fputs("RTRJ", f);
+  std::fclose(f);
+  EXPECT_FALSE(reader.Open(path));
+  EXPECT_FALSE(reader.is_open());
+}
+
+#endif /* TRAJECTORY_TESTS */
@@ -0,0 +1,62 @@
+/**
+ * @file wall_collision_unittest.cc
+ *
+ * @copyright 2017 3081 Staff, All rights reserved.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "src/entity_type.h"
+#include "src/light.h"
+#include "src/wall_collision.h"
+#ifdef WALL_COLLISION_TESTS
+
+/******************************************************
+* TEST FEATURE SetUp
+*******************************************************/
+class WallCollisionTest : public ::testing::Test {
+ protected:
+  // Add a light of radius 8 at (`x`, `y`).
+  void AddLight(double x, double y) {
+    lights_.emplace_back(new csci3081::Light());
+    lights_.back()->set_position(x, y);
+    lights_.back()->set_radius(8);
+    mobile_.push_back(lights_.back().get());
+  }
+
+  std::vector<std::unique_ptr<csci3081::Light>> lights_;
+  std::vector<csci3081::ArenaMobileEntity *> mobile_;
+  csci3081::WallCollision walls_;
+};
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// An entity in a corner is moved off both walls at once, and one along a
+// wall off that wall only; entities clear of the walls stay put.
+TEST_F(WallCollisionTest, MovesOffEveryWallTouched) {
+  AddLight(3, 995);
+  AddLight(500, 4);
+  AddLight(500, 500);
+  EXPECT_EQ(walls_.Apply(mobile_, 1000, 1000), 2u);
+  EXPECT_DOUBLE_EQ(mobile_[0]->get_pose().x, 13);
+  EXPECT_DOUBLE_EQ(mobile_[0]->get_pose().y, 987);
+  EXPECT_DOUBLE_EQ(mobile_[1]->get_pose().x, 500);
+  EXPECT_DOUBLE_EQ(mobile_[1]->get_pose().y, 13);
+  EXPECT_DOUBLE_EQ(mobile_[2]->get_pose().x, 500);
+  EXPECT_DOUBLE_EQ(mobile_[2]->get_pose().y, 500);
+  const std::vector<uint8_t> &masks = walls_.get_masks();
+  EXPECT_EQ(masks[0], csci3081::WallBit(csci3081::kLeftWall) |
+                      csci3081::WallBit(csci3081::kBottomWall));
+  EXPECT_EQ(masks[1], csci3081::WallBit(csci3081::kTopWall));
+  EXPECT_EQ(masks[2], 0);
+  EXPECT_EQ(csci3081::FirstWall(masks[0]), csci3081::kLeftWall);
+  EXPECT_EQ(csci3081::FirstWall(masks[2]), csci3081::kUndefined);
+}
+
+#endif /* WALL_COLLISION_TESTS */